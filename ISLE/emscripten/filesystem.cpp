@@ -57,7 +57,7 @@ void Emscripten_SetupFilesystem()
 		}
 		else {
 			wasmfs_create_file(p_path, 0644, fetchfs);
-			MxOmni::GetCDFiles().emplace_back(p_path);
+			MxOmni::GetCDFiles().Add(p_path);
 
 			SDL_Log("File %s set up for streaming", p_path);
 		}
@@ -19,6 +19,7 @@
 #include "mxbackgroundaudiomanager.h"
 #include "mxdirectx/mxdirect3d.h"
 #include "mxdsaction.h"
+#include "mxiotrace.h"
 #include "mxmisc.h"
 #include "mxomnicreateflags.h"
 #include "mxomnicreateparam.h"
@@ -837,6 +838,7 @@ bool IsleApp::LoadConfig()
 		iniparser_set(dict, "isle:UseJoystick", m_useJoystick ? "true" : "false");
 		iniparser_set(dict, "isle:JoystickIndex", m_joystickIndex ? "true" : "false");
 		iniparser_set(dict, "isle:Draw Cursor", m_drawCursor ? "true" : "false");
+		iniparser_set(dict, "isle:IO Trace", "false");
 
 		iniparser_set(dict, "isle:Back Buffers in Video RAM", "-1");
 
@@ -882,6 +884,7 @@ bool IsleApp::LoadConfig()
 	m_useJoystick = iniparser_getboolean(dict, "isle:UseJoystick", m_useJoystick);
 	m_joystickIndex = iniparser_getint(dict, "isle:JoystickIndex", m_joystickIndex);
 	m_drawCursor = iniparser_getboolean(dict, "isle:Draw Cursor", m_drawCursor);
+	MxIOTrace::Enable(iniparser_getboolean(dict, "isle:IO Trace", FALSE));
 
 	MxS32 backBuffersInVRAM = iniparser_getboolean(dict, "isle:Back Buffers in Video RAM", -1);
 	if (backBuffersInVRAM != -1) {
@@ -9,6 +9,9 @@
 #include "legosoundmanager.h"
 #include "legovideomanager.h"
 #include "misc.h"
+#include "mxiotrace.h"
+#include "mxmisc.h"
+#include "mxstreamer.h"
 #include "mxticklemanager.h"
 
 #include <SDL2/SDL.h>
@@ -121,6 +124,85 @@ class DebugViewer {
 			ImGui::EndTable();
 		}
 	}
+	static void InsideIOTrace()
+	{
+		static MxIOTraceEvent events[MxIOTrace::c_capacity];
+
+		bool enabled = MxIOTrace::IsEnabled();
+		if (ImGui::Checkbox("Enabled", &enabled)) {
+			MxIOTrace::Enable(enabled);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Dump")) {
+			MxIOTrace::Dump();
+		}
+
+		MxU32 count = MxIOTrace::Snapshot(events, MxIOTrace::c_capacity);
+		MxU32 hits = 0;
+		MxU32 maxLatency = 0;
+		Uint64 bytes = 0;
+		Uint64 totalLatency = 0;
+		for (MxU32 i = 0; i < count; i++) {
+			hits += events[i].m_bufferHit ? 1 : 0;
+			bytes += events[i].m_bytesRead;
+			totalLatency += events[i].m_latency;
+			maxLatency = SDL_max(maxLatency, events[i].m_latency);
+		}
+		ImGui::Text("Reads: %u, buffer hits: %u, bytes: %llu", count, hits, (unsigned long long) bytes);
+		ImGui::Text(
+			"Latency: %.1f us average, %u us max",
+			count ? (double) totalLatency / count : 0.0,
+			maxLatency
+		);
+
+		if (count && ImGui::BeginTable("Recent Reads", 4, ImGuiTableFlags_Borders)) {
+			ImGui::TableSetupColumn("Offset");
+			ImGui::TableSetupColumn("Size");
+			ImGui::TableSetupColumn("Latency (us)");
+			ImGui::TableSetupColumn("Buffer");
+			ImGui::TableHeadersRow();
+			for (MxU32 i = count; i > 0 && i > count - 64; i--) {
+				const MxIOTraceEvent& event = events[i - 1];
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%lld", (long long) event.m_offset);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", event.m_size);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", event.m_latency);
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", event.m_bufferHit ? "hit" : "miss");
+			}
+			ImGui::EndTable();
+		}
+	}
+	template <size_t BS, size_t NB>
+	static void InsideMemoryPool(const char* p_name, MxMemoryPool<BS, NB>& p_pool)
+	{
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("%s", p_name);
+		ImGui::TableNextColumn();
+		ImGui::Text("%u / %u", p_pool.GetBusyCount(), p_pool.GetPoolSize());
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", p_pool.GetHighWaterMark());
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", p_pool.GetFailureCount());
+	}
+	static void InsideStreamer()
+	{
+		MxStreamer* streamer = Streamer();
+		if (ImGui::BeginTable("Buffer Pools", 4, ImGuiTableFlags_Borders)) {
+			ImGui::TableSetupColumn("Pool");
+			ImGui::TableSetupColumn("Busy");
+			ImGui::TableSetupColumn("High water");
+			ImGui::TableSetupColumn("Failures");
+			ImGui::TableHeadersRow();
+			DebugViewer::InsideMemoryPool("64 KB", streamer->GetPool64());
+			DebugViewer::InsideMemoryPool("128 KB", streamer->GetPool128());
+			ImGui::EndTable();
+		}
+	}
 	static void InsideVideoManager()
 	{
 		auto videoManager = Lego()->GetVideoManager();
@@ -328,6 +410,14 @@ void IsleDebug_Render()
 				DebugViewer::InsideTickleManager();
 				ImGui::TreePop();
 			}
+			if (ImGui::TreeNode("Streamer")) {
+				DebugViewer::InsideStreamer();
+				ImGui::TreePop();
+			}
+			if (ImGui::TreeNode("I/O Trace")) {
+				DebugViewer::InsideIOTrace();
+				ImGui::TreePop();
+			}
 		}
 		ImGui::End();
 	}
@@ -22,12 +22,13 @@ class Act2Brick : public LegoPathActor {
 		return "Act2Brick";
 	}
 
-	// FUNCTION: LEGO1 0x1007a370
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Act2Brick::ClassName()) || LegoEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Act2Brick", LegoEntity::g_typeInfo};
+
 	MxResult HitActor(LegoPathActor* p_actor, MxBool) override; // vtable+0x94
 
 	// SYNTHETIC: LEGO1 0x1007a450
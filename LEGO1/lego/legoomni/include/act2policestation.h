@@ -18,12 +18,13 @@ class Act2PoliceStation : public LegoEntity {
 		return "Act2PoliceStation";
 	}
 
-	// FUNCTION: LEGO1 0x1000e210
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Act2PoliceStation::ClassName()) || LegoEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Act2PoliceStation", LegoEntity::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1000f610
 	// Act2PoliceStation::`scalar deleting destructor'
 };
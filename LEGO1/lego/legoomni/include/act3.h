@@ -65,12 +65,13 @@ class Act3State : public LegoState {
 		return "Act3State";
 	}
 
-	// FUNCTION: LEGO1 0x1000e310
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Act3State::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Act3State", LegoState::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1000e3c0
 	// Act3State::`scalar deleting destructor'
 
@@ -103,12 +104,13 @@ class Act3 : public LegoWorld {
 		return "Act3";
 	}
 
-	// FUNCTION: LEGO1 0x10072520
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Act3::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Act3", LegoWorld::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	void Destroy(MxBool p_fromDestructor) override;   // vtable+0x1c
 	void ReadyWorld() override;                       // vtable+0x50
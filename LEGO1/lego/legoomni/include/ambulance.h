@@ -55,12 +55,13 @@ class AmbulanceMissionState : public LegoState {
 		return "AmbulanceMissionState";
 	}
 
-	// FUNCTION: LEGO1 0x10037610
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, AmbulanceMissionState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"AmbulanceMissionState", LegoState::g_typeInfo};
+
 	// FUNCTION: BETA10 0x10088770
 	MxS16 GetHighScore(MxU8 p_actorId)
 	{
@@ -161,12 +162,13 @@ class Ambulance : public IslePathActor {
 		return "Ambulance";
 	}
 
-	// FUNCTION: LEGO1 0x10035fb0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Ambulance::ClassName()) || IslePathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Ambulance", IslePathActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                              // vtable+0x18
 	void Animate(float p_time) override;                                           // vtable+0x70
 	MxLong HandleClick() override;                                                 // vtable+0xcc
@@ -19,12 +19,13 @@ class Bike : public IslePathActor {
 		return "Bike";
 	}
 
-	// FUNCTION: LEGO1 0x10076700
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Bike::ClassName()) || IslePathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Bike", IslePathActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                            // vtable+0x18
 	MxLong HandleClick() override;                                               // vtable+0xcc
 	MxLong HandleControl(LegoControlManagerNotificationParam& p_param) override; // vtable+0xd4
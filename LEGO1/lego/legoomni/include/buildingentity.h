@@ -23,12 +23,13 @@ class BuildingEntity : public LegoEntity {
 		return "BuildingEntity";
 	}
 
-	// FUNCTION: LEGO1 0x10014f30
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, BuildingEntity::ClassName()) || LegoEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"BuildingEntity", LegoEntity::g_typeInfo};
+
 	virtual MxLong HandleClick(LegoEventNotificationParam& p_param) = 0;
 
 	// SYNTHETIC: LEGO1 0x10015010
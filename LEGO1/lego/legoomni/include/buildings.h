@@ -18,12 +18,13 @@ class InfoCenterEntity : public BuildingEntity {
 		return "InfoCenterEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000ea10
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, InfoCenterEntity::ClassName()) || BuildingEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"InfoCenterEntity", BuildingEntity::g_typeInfo};
+
 	MxLong HandleClick(LegoEventNotificationParam& p_param) override; // vtable+0x50
 
 	// SYNTHETIC: LEGO1 0x1000f7b0
@@ -43,12 +44,13 @@ class GasStationEntity : public BuildingEntity {
 		return "GasStationEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000eb30
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, GasStationEntity::ClassName()) || BuildingEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"GasStationEntity", BuildingEntity::g_typeInfo};
+
 	MxLong HandleClick(LegoEventNotificationParam& p_param) override;
 
 	// SYNTHETIC: LEGO1 0x1000f890
@@ -68,12 +70,13 @@ class HospitalEntity : public BuildingEntity {
 		return "HospitalEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000ec50
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, HospitalEntity::ClassName()) || BuildingEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"HospitalEntity", BuildingEntity::g_typeInfo};
+
 	MxLong HandleClick(LegoEventNotificationParam& p_param) override; // vtable+0x50
 
 	// SYNTHETIC: LEGO1 0x1000f820
@@ -93,12 +96,13 @@ class PoliceEntity : public BuildingEntity {
 		return "PoliceEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000ed70
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, PoliceEntity::ClassName()) || BuildingEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"PoliceEntity", BuildingEntity::g_typeInfo};
+
 	MxLong HandleClick(LegoEventNotificationParam& p_param) override; // vtable+0x50
 
 	// SYNTHETIC: LEGO1 0x1000f900
@@ -118,12 +122,13 @@ class BeachHouseEntity : public BuildingEntity {
 		return "BeachHouseEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000ee90
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, BeachHouseEntity::ClassName()) || BuildingEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"BeachHouseEntity", BuildingEntity::g_typeInfo};
+
 	MxLong HandleClick(LegoEventNotificationParam& p_param) override;
 
 	// SYNTHETIC: LEGO1 0x1000f970
@@ -142,12 +147,13 @@ class RaceStandsEntity : public BuildingEntity {
 		return "RaceStandsEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000efb0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, RaceStandsEntity::ClassName()) || BuildingEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"RaceStandsEntity", BuildingEntity::g_typeInfo};
+
 	MxLong HandleClick(LegoEventNotificationParam& p_param) override;
 
 	// SYNTHETIC: LEGO1 0x1000f9e0
@@ -166,12 +172,13 @@ class JailEntity : public BuildingEntity {
 		return "RaceStandsEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000f0d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, JailEntity::ClassName()) || BuildingEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"RaceStandsEntity", BuildingEntity::g_typeInfo};
+
 	MxLong HandleClick(LegoEventNotificationParam& p_param) override;
 
 	// SYNTHETIC: LEGO1 0x1000fac0
@@ -190,12 +197,13 @@ class CaveEntity : public BuildingEntity {
 		return "RaceStandsEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000f1f0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, CaveEntity::ClassName()) || BuildingEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"RaceStandsEntity", BuildingEntity::g_typeInfo};
+
 	MxLong HandleClick(LegoEventNotificationParam& p_param) override;
 
 	// SYNTHETIC: LEGO1 0x1000fa50
@@ -23,12 +23,13 @@ class BumpBouy : public LegoAnimActor {
 		return "BumpBouy";
 	}
 
-	// FUNCTION: LEGO1 0x10027510
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, BumpBouy::ClassName()) || LegoAnimActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"BumpBouy", LegoAnimActor::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x100274a0
 	// BumpBouy::`scalar deleting destructor'
 };
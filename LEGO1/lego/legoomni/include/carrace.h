@@ -19,13 +19,13 @@ class CarRaceState : public RaceState {
 		return "CarRaceState";
 	}
 
-	// FUNCTION: LEGO1 0x1000dd40
-	// FUNCTION: BETA10 0x100a9130
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, CarRaceState::ClassName()) || RaceState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"CarRaceState", RaceState::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1000f740
 	// CarRaceState::`scalar deleting destructor'
 };
@@ -45,13 +45,13 @@ class CarRace : public LegoRace {
 		return "CarRace";
 	}
 
-	// FUNCTION: LEGO1 0x10016b30
-	// FUNCTION: BETA10 0x100c98a0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, CarRace::ClassName()) || LegoRace::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"CarRace", LegoRace::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                   // vtable+0x18
 	void ReadyWorld() override;                                         // vtable+0x50
 	MxBool Escape() override;                                           // vtable+0x64
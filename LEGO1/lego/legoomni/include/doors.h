@@ -20,12 +20,13 @@ class Doors : public LegoPathActor {
 		return "Doors";
 	}
 
-	// FUNCTION: LEGO1 0x1000e440
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Doors::ClassName()) || LegoPathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Doors", LegoPathActor::g_typeInfo};
+
 	void ParseAction(char* p_extra) override;                          // vtable+0x20
 	void Animate(float p_time) override;                               // vtable+0x70
 	MxResult HitActor(LegoPathActor* p_actor, MxBool p_bool) override; // vtable+0x94
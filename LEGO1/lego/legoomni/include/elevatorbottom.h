@@ -28,12 +28,13 @@ class ElevatorBottom : public LegoWorld {
 		return "ElevatorBottom";
 	}
 
-	// FUNCTION: LEGO1 0x10017f30
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ElevatorBottom::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"ElevatorBottom", LegoWorld::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	void ReadyWorld() override;                       // vtable+0x50
 	MxBool Escape() override;                         // vtable+0x64
@@ -39,12 +39,13 @@ class GasStationState : public LegoState {
 		return "GasStationState";
 	}
 
-	// FUNCTION: LEGO1 0x100061e0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, GasStationState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"GasStationState", LegoState::g_typeInfo};
+
 	MxResult Serialize(LegoStorage* p_storage) override; // vtable+0x1c
 
 	// SYNTHETIC: LEGO1 0x10006290
@@ -87,12 +88,13 @@ class GasStation : public LegoWorld {
 		return "GasStation";
 	}
 
-	// FUNCTION: LEGO1 0x10004790
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, GasStation::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"GasStation", LegoWorld::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                           // vtable+0x18
 	void ReadyWorld() override;                                                 // vtable+0x50
 	MxBool Escape() override;                                                   // vtable+0x64
@@ -32,12 +32,13 @@ class HelicopterState : public LegoState {
 		return "HelicopterState";
 	}
 
-	// FUNCTION: LEGO1 0x1000e0e0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, HelicopterState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"HelicopterState", LegoState::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1000e190
 	// HelicopterState::`scalar deleting destructor'
 
@@ -60,13 +61,13 @@ class Helicopter : public IslePathActor {
 		return "Helicopter";
 	}
 
-	// FUNCTION: LEGO1 0x10003080
-	// FUNCTION: BETA10 0x1002b330
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Helicopter::ClassName()) || IslePathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Helicopter", IslePathActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                            // vtable+0x18
 	void Animate(float p_time) override;                                         // vtable+0x70
 	void VTable0x74(Matrix4& p_transform) override;                              // vtable+0x74
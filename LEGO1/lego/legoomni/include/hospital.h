@@ -45,12 +45,13 @@ class HospitalState : public LegoState {
 		return "HospitalState";
 	}
 
-	// FUNCTION: LEGO1 0x10076410
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, HospitalState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"HospitalState", LegoState::g_typeInfo};
+
 	MxResult Serialize(LegoStorage* p_storage) override; // vtable+0x1c
 
 	// SYNTHETIC: LEGO1 0x100764c0
@@ -89,12 +90,13 @@ class Hospital : public LegoWorld {
 		return "Hospital";
 	}
 
-	// FUNCTION: LEGO1 0x100746c0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Hospital::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Hospital", LegoWorld::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	void ReadyWorld() override;                       // vtable+0x50
 	MxBool Escape() override;                         // vtable+0x64
@@ -27,12 +27,13 @@ class InfocenterDoor : public LegoWorld {
 		return "InfocenterDoor";
 	}
 
-	// FUNCTION: LEGO1 0x100377c0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, InfocenterDoor::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"InfocenterDoor", LegoWorld::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	void ReadyWorld() override;                       // vtable+0x50
 	MxBool Escape() override;                         // vtable+0x64
@@ -44,12 +44,13 @@ class Act1State : public LegoState {
 		return "Act1State";
 	}
 
-	// FUNCTION: LEGO1 0x100338b0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Act1State::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Act1State", LegoState::g_typeInfo};
+
 	MxBool Reset() override;                             // vtable+0x18
 	MxResult Serialize(LegoStorage* p_storage) override; // vtable+0x1c
 
@@ -129,12 +130,13 @@ class Isle : public LegoWorld {
 		return "Isle";
 	}
 
-	// FUNCTION: LEGO1 0x10030920
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Isle::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Isle", LegoWorld::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	void ReadyWorld() override;                       // vtable+0x50
 	void Add(MxCore* p_object) override;              // vtable+0x58
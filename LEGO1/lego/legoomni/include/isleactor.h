@@ -46,12 +46,13 @@ class IsleActor : public LegoActor {
 		return "IsleActor";
 	}
 
-	// FUNCTION: LEGO1 0x1000e670
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, IsleActor::ClassName()) || LegoActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"IsleActor", LegoActor::g_typeInfo};
+
 protected:
 	LegoWorld* m_world; // 0x78
 };
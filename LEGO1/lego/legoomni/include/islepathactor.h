@@ -120,12 +120,13 @@ class IslePathActor : public LegoPathActor {
 		return "IslePathActor";
 	}
 
-	// FUNCTION: LEGO1 0x10002eb0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, IslePathActor::ClassName()) || LegoPathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"IslePathActor", LegoPathActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	void Destroy(MxBool p_fromDestructor) override;   // vtable+0x1c
 
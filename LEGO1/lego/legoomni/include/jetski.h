@@ -21,12 +21,13 @@ class Jetski : public IslePathActor {
 		return "Jetski";
 	}
 
-	// FUNCTION: LEGO1 0x1007e440
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Jetski::ClassName()) || IslePathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Jetski", IslePathActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                    // vtable+0x18
 	void Animate(float p_time) override;                                 // vtable+0x70
 	MxLong HandleClick() override;                                       // vtable+0xcc
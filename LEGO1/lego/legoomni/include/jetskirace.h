@@ -22,13 +22,13 @@ class JetskiRace : public LegoRace {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000db00
-	// FUNCTION: BETA10 0x100a8860
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, JetskiRace::ClassName()) || LegoRace::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"JetskiRace", LegoRace::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                   // vtable+0x18
 	void ReadyWorld() override;                                         // vtable+0x50
 	MxBool Escape() override;                                           // vtable+0x64
@@ -56,13 +56,13 @@ class JetskiRaceState : public RaceState {
 		return "JetskiRaceState";
 	}
 
-	// FUNCTION: LEGO1 0x1000dc50
-	// FUNCTION: BETA10 0x100a8f60
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, JetskiRaceState::ClassName()) || RaceState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"JetskiRaceState", RaceState::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1000f680
 	// SYNTHETIC: BETA10 0x100a9d10
 	// JetskiRaceState::`scalar deleting destructor'
@@ -35,12 +35,13 @@ class JukeBoxState : public LegoState {
 		return "JukeBoxState";
 	}
 
-	// FUNCTION: LEGO1 0x1000f320
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, JukeBoxState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"JukeBoxState", LegoState::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1000f3d0
 	// JukeBoxState::`scalar deleting destructor'
 
@@ -70,12 +71,13 @@ class JukeBox : public LegoWorld {
 		return "JukeBox";
 	}
 
-	// FUNCTION: LEGO1 0x1005d700
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, JukeBox::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"JukeBox", LegoWorld::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	void ReadyWorld() override;                       // vtable+0x50
 	MxBool Escape() override;                         // vtable+0x64
@@ -22,12 +22,13 @@ class JukeBoxEntity : public LegoEntity {
 		return "JukeBoxEntity";
 	}
 
-	// FUNCTION: LEGO1 0x10085cd0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, JukeBoxEntity::ClassName()) || LegoEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"JukeBoxEntity", LegoEntity::g_typeInfo};
+
 	void StartAction();
 	void StopAction(JukeboxScript::Script p_script);
 
@@ -23,12 +23,13 @@ class Lego3DWavePresenter : public MxWavePresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000d8a0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Lego3DWavePresenter::ClassName()) || MxWavePresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Lego3DWavePresenter", MxWavePresenter::g_typeInfo};
+
 	void StartingTickle() override;   // vtable+0x1c
 	void StreamingTickle() override;  // vtable+0x20
 	MxResult AddToManager() override; // vtable+0x34
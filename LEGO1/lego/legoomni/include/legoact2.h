@@ -33,12 +33,13 @@ class LegoAct2State : public LegoState {
 		return "LegoAct2State";
 	}
 
-	// FUNCTION: LEGO1 0x1000df90
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoAct2State::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoAct2State", LegoState::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1000e040
 	// LegoAct2State::`scalar deleting destructor'
 
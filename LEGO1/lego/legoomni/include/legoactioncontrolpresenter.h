@@ -27,12 +27,13 @@ class LegoActionControlPresenter : public MxMediaPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000d0f0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoActionControlPresenter::ClassName()) || MxMediaPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoActionControlPresenter", MxMediaPresenter::g_typeInfo};
+
 	void ReadyTickle() override;                   // vtable+0x18
 	void RepeatingTickle() override;               // vtable+0x24
 	void ParseExtra() override;                    // vtable+0x30
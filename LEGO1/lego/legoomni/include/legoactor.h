@@ -33,13 +33,13 @@ class LegoActor : public LegoEntity {
 		return "LegoActor";
 	}
 
-	// FUNCTION: LEGO1 0x1002d220
-	// FUNCTION: BETA10 0x10012530
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoActor::ClassName()) || LegoEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoActor", LegoEntity::g_typeInfo};
+
 	void ParseAction(char* p_extra) override;                             // vtable+0x20
 	void SetROI(LegoROI* p_roi, MxBool p_bool1, MxBool p_bool2) override; // vtable+0x24
 
@@ -60,13 +60,13 @@ class LegoAnimActor : public virtual LegoPathActor {
 		return "LegoAnimActor";
 	}
 
-	// FUNCTION: LEGO1 0x1000fbc0
-	// FUNCTION: BETA10 0x10012440
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoAnimActor::ClassName()) || LegoPathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoAnimActor", LegoPathActor::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1000fb60
 	// LegoAnimActor::`scalar deleting destructor'
 
@@ -65,12 +65,13 @@ class AnimState : public LegoState {
 		return "AnimState";
 	}
 
-	// FUNCTION: LEGO1 0x10065080
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, AnimState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"AnimState", LegoState::g_typeInfo};
+
 	MxBool Reset() override;                             // vtable+0x18
 	MxResult Serialize(LegoStorage* p_storage) override; // vtable+0x1c
 
@@ -152,12 +153,13 @@ class LegoAnimationManager : public MxCore {
 		return "LegoAnimationManager";
 	}
 
-	// FUNCTION: LEGO1 0x1005ec90
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoAnimationManager", MxCore::g_typeInfo};
+
 	void Reset(MxBool p_und);
 	void Suspend();
 	void Resume();
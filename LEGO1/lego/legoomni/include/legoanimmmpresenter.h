@@ -47,12 +47,13 @@ class LegoAnimMMPresenter : public MxCompositePresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1004a960
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoAnimMMPresenter::ClassName()) || MxCompositePresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoAnimMMPresenter", MxCompositePresenter::g_typeInfo};
+
 	void ReadyTickle() override;                                                           // vtable+0x18
 	void StartingTickle() override;                                                        // vtable+0x1c
 	void StreamingTickle() override;                                                       // vtable+0x20
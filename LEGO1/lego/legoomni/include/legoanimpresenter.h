@@ -55,12 +55,13 @@ class LegoAnimPresenter : public MxVideoPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x10068540
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoAnimPresenter::ClassName()) || MxVideoPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoAnimPresenter", MxVideoPresenter::g_typeInfo};
+
 	void ReadyTickle() override;                                                                   // vtable+0x18
 	void StartingTickle() override;                                                                // vtable+0x1c
 	void StreamingTickle() override;                                                               // vtable+0x20
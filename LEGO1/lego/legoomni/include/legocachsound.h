@@ -23,12 +23,13 @@ class LegoCacheSound : public MxCore {
 		return "LegoCacheSound";
 	}
 
-	// FUNCTION: LEGO1 0x10006590
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoCacheSound::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoCacheSound", MxCore::g_typeInfo};
+
 	virtual MxResult Create(
 		MxWavePresenter::WaveFormat& p_pwfx,
 		MxString p_mediaSrcPath,
@@ -24,12 +24,13 @@ class LegoCameraController : public LegoPointOfViewController {
 		return "LegoCameraController";
 	}
 
-	// FUNCTION: LEGO1 0x10011ed0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoCameraController", MxCore::g_typeInfo};
+
 	virtual void OnLButtonDown(MxPoint32 p_point);                // vtable+0x30
 	virtual void OnLButtonUp(MxPoint32 p_point);                  // vtable+0x34
 	virtual void OnRButtonDown(MxPoint32 p_point);                // vtable+0x38
@@ -38,10 +38,9 @@ class LegoVehicleBuildState : public LegoState {
 		return m_className.GetData();
 	}
 
-	// FUNCTION: LEGO1 0x10026000
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, m_className.GetData()) || LegoState::IsA(p_name);
+		return m_typeInfo;
 	}
 
 	MxResult Serialize(LegoStorage* p_storage) override; // vtable+0x1c
@@ -63,6 +62,9 @@ class LegoVehicleBuildState : public LegoState {
 	MxBool m_unk0x4d;                // 0x4d
 	MxBool m_unk0x4e;                // 0x4e
 	MxU8 m_placedPartCount;          // 0x4f
+
+	// The class name is only known at runtime
+	MxTypeInfo m_typeInfo;
 };
 
 typedef LegoVehicleBuildState LegoRaceCarBuildState;
@@ -109,12 +111,13 @@ class LegoCarBuild : public LegoWorld {
 	MxLong Notify(MxParam& p_param) override; // vtable+0x04
 	MxResult Tickle() override;               // vtable+0x08
 
-	// FUNCTION: LEGO1 0x10022950
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoCarBuild::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoCarBuild", LegoWorld::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                  // vtable+0x18
 	void ReadyWorld() override;                                        // vtable+0x50
 	MxBool Escape() override;                                          // vtable+0x64
@@ -61,12 +61,13 @@ class LegoCarBuildAnimPresenter : public LegoAnimPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x10078520
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoCarBuildAnimPresenter::ClassName()) || LegoAnimPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoCarBuildAnimPresenter", LegoAnimPresenter::g_typeInfo};
+
 	void ReadyTickle() override;     // vtable+0x18
 	void StreamingTickle() override; // vtable+0x20
 	void EndAction() override;       // vtable+0x40
@@ -60,12 +60,13 @@ class LegoControlManager : public MxCore {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x10028cc0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoControlManager::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoControlManager", MxCore::g_typeInfo};
+
 	void FUN_10028df0(MxPresenterList* p_presenterList);
 	void Register(MxCore* p_listener);
 	void Unregister(MxCore* p_listener);
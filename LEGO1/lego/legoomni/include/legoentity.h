@@ -6,6 +6,7 @@
 #include "mxentity.h"
 
 class LegoROI;
+class LegoWorld;
 class MxDSAction;
 class Vector3;
 
@@ -31,7 +32,11 @@ class LegoEntity : public MxEntity {
 		c_altBit1 = 0x01
 	};
 
-	LegoEntity() { Init(); }
+	LegoEntity()
+	{
+		Init();
+		m_ownerWorld = NULL;
+	}
 
 	// FUNCTION: LEGO1 0x1000c290
 	~LegoEntity() override { Destroy(TRUE); }
@@ -46,13 +51,13 @@ class LegoEntity : public MxEntity {
 		return "LegoEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000c300
-	// FUNCTION: BETA10 0x100125a0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoEntity::ClassName()) || MxEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoEntity", MxEntity::g_typeInfo};
+
 	virtual MxResult Create(MxDSAction& p_dsAction);                     // vtable+0x18
 	virtual void Destroy(MxBool p_fromDestructor);                       // vtable+0x1c
 	virtual void ParseAction(char* p_extra);                             // vtable+0x20
@@ -83,6 +88,13 @@ class LegoEntity : public MxEntity {
 	Mx3DPointFloat GetWorldUp();
 	Mx3DPointFloat GetWorldPosition();
 
+	// [library:performance] Hide the MxEntity setters, so the world holding the entity re-keys it
+	void SetEntityId(MxS32 p_entityId);
+	void SetAtomId(const MxAtomId& p_atomId);
+
+	LegoWorld* GetOwnerWorld() { return m_ownerWorld; }
+	void SetOwnerWorld(LegoWorld* p_world) { m_ownerWorld = p_world; }
+
 	MxBool GetUnknown0x10IsSet(MxU8 p_flag) { return m_unk0x10 & p_flag; }
 	MxBool GetFlagsIsSet(MxU8 p_flag) { return m_flags & p_flag; }
 	MxU8 GetFlags() { return m_flags; }
@@ -125,6 +137,10 @@ class LegoEntity : public MxEntity {
 	char* m_siFile; // 0x60
 
 	MxS32 m_targetEntityId; // 0x64
+
+	// [library:performance] World whose entity list holds this entity, whose index is keyed on
+	// the atom and id. Not reset by Init, since Destroy does not take the entity out of the list.
+	LegoWorld* m_ownerWorld;
 };
 
 // SYNTHETIC: LEGO1 0x1000c3b0
@@ -27,12 +27,13 @@ class LegoEntityPresenter : public MxCompositePresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x100534c0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoEntityPresenter::ClassName()) || MxCompositePresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoEntityPresenter", MxCompositePresenter::g_typeInfo};
+
 	void ReadyTickle() override;                                                           // vtable+0x18
 	void RepeatingTickle() override;                                                       // vtable+0x24
 	void ParseExtra() override;                                                            // vtable+0x30
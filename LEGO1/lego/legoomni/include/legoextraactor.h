@@ -30,12 +30,13 @@ class LegoExtraActor : public virtual LegoAnimActor {
 		return "LegoExtraActor";
 	}
 
-	// FUNCTION: LEGO1 0x1002b7d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoExtraActor::ClassName()) || LegoAnimActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoExtraActor", LegoAnimActor::g_typeInfo};
+
 	void SetWorldSpeed(MxFloat p_worldSpeed) override;                                  // vtable+0x30
 	MxS32 VTable0x68(Vector3& p_point1, Vector3& p_point2, Vector3& p_point3) override; // vtable+0x68
 	inline MxU32 VTable0x6c(
@@ -45,12 +45,13 @@ class LegoHideAnimPresenter : public LegoLoopingAnimPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1006d890
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ClassName()) || LegoAnimPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoHideAnimPresenter", LegoAnimPresenter::g_typeInfo};
+
 	void ReadyTickle() override;      // vtable+0x18
 	void StartingTickle() override;   // vtable+0x18
 	MxResult AddToManager() override; // vtable+0x34
@@ -27,12 +27,14 @@ class LegoLocomotionAnimPresenter : public LegoLoopingAnimPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1006ce60
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ClassName()) || LegoLoopingAnimPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	// LegoLoopingAnimPresenter::IsA compared against the virtual ClassName, so it never matched this class
+	static constexpr MxTypeInfo g_typeInfo{"LegoLocomotionAnimPresenter", LegoAnimPresenter::g_typeInfo};
+
 	void ReadyTickle() override;                          // vtable+0x18
 	void StartingTickle() override;                       // vtable+0x1c
 	void StreamingTickle() override;                      // vtable+0x20
@@ -21,12 +21,13 @@ class LegoLoopingAnimPresenter : public LegoAnimPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000c9b0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ClassName()) || LegoAnimPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoLoopingAnimPresenter", LegoAnimPresenter::g_typeInfo};
+
 	void StreamingTickle() override; // vtable+0x20
 	void PutFrame() override;        // vtable+0x6c
 
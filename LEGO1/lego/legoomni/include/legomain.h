@@ -113,12 +113,13 @@ class LegoOmni : public MxOmni {
 		return "LegoOmni";
 	}
 
-	// FUNCTION: LEGO1 0x10058ab0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoOmni::ClassName()) || MxOmni::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoOmni", MxOmni::g_typeInfo};
+
 	void Init() override;                                                                        // vtable+0x14
 	MxResult Create(MxOmniCreateParam& p_param) override;                                        // vtable+0x18
 	void Destroy() override;                                                                     // vtable+0x1c
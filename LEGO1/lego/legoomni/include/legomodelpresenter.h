@@ -38,12 +38,13 @@ class LegoModelPresenter : public MxVideoPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000ccc0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ClassName()) || MxVideoPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoModelPresenter", MxVideoPresenter::g_typeInfo};
+
 	void ReadyTickle() override; // vtable+0x18
 	void ParseExtra() override;  // vtable+0x30
 
@@ -30,12 +30,13 @@ class LegoNavController : public MxCore {
 		return "LegoNavController";
 	}
 
-	// FUNCTION: LEGO1 0x10054b90
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoNavController", MxCore::g_typeInfo};
+
 	void SetTargets(int p_hPos, int p_vPos, MxBool p_accel);
 	void SetControlMax(int p_hMax, int p_vMax);
 	void SetToDefaultParams();
@@ -27,12 +27,13 @@ class LegoPalettePresenter : public MxVideoPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x10079f40
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ClassName()) || MxVideoPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoPalettePresenter", MxVideoPresenter::g_typeInfo};
+
 	void ReadyTickle() override; // vtable+0x18
 	void Destroy() override;     // vtable+0x38
 
@@ -31,12 +31,13 @@ class LegoPartPresenter : public MxMediaPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000cf80
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoPartPresenter::ClassName()) || MxMediaPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoPartPresenter", MxMediaPresenter::g_typeInfo};
+
 	void ReadyTickle() override;      // vtable+0x18
 	MxResult AddToManager() override; // vtable+0x34
 
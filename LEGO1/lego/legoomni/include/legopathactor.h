@@ -143,13 +143,13 @@ class LegoPathActor : public LegoActor {
 		return "LegoPathActor";
 	}
 
-	// FUNCTION: LEGO1 0x1000c440
-	// FUNCTION: BETA10 0x100124c0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoPathActor::ClassName()) || LegoActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoPathActor", LegoActor::g_typeInfo};
+
 	// FUNCTION: BETA10 0x1001ca40
 	LegoPathBoundary* GetBoundary() { return m_boundary; }
 
@@ -76,12 +76,13 @@ class LegoPathController : public MxCore {
 		return "LegoPathController";
 	}
 
-	// FUNCTION: LEGO1 0x10045120
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoPathController::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoPathController", MxCore::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x10045740
 	// LegoPathController::`scalar deleting destructor'
 
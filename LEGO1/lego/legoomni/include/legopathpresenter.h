@@ -25,12 +25,13 @@ class LegoPathPresenter : public MxMediaPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x100449b0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoPathPresenter::ClassName()) || MxMediaPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoPathPresenter", MxMediaPresenter::g_typeInfo};
+
 	void ReadyTickle() override;      // vtable+0x18
 	void StreamingTickle() override;  // vtable+0x20
 	void RepeatingTickle() override;  // vtable+0x24
@@ -75,13 +75,13 @@ class RaceState : public LegoState {
 		return "RaceState";
 	}
 
-	// FUNCTION: LEGO1 0x10016020
-	// FUNCTION: BETA10 0x100a8fd0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, RaceState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"RaceState", LegoState::g_typeInfo};
+
 	MxResult Serialize(LegoStorage* p_storage) override; // vtable+0x1c
 
 	Entry* GetState(MxU8 p_id);
@@ -135,13 +135,13 @@ class LegoRace : public LegoWorld {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x10015bb0
-	// FUNCTION: BETA10 0x100a88d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoRace::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoRace", LegoWorld::g_typeInfo};
+
 	// FUNCTION: LEGO1 0x1000dab0
 	virtual MxLong HandleType0Notification(MxNotificationParam&) { return 0; } // vtable+0x78
 
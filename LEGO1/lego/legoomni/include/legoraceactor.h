@@ -24,12 +24,13 @@ class LegoRaceActor : public virtual LegoAnimActor {
 		return "LegoRaceActor";
 	}
 
-	// FUNCTION: LEGO1 0x10014b20
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoRaceActor::ClassName()) || LegoAnimActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoRaceActor", LegoAnimActor::g_typeInfo};
+
 	MxS32 VTable0x68(Vector3& p_v1, Vector3& p_v2, Vector3& p_v3) override; // vtable+0x68
 	MxU32 VTable0x90(float p_time, Matrix4& p_matrix) override;             // vtable+0x90
 	MxResult HitActor(LegoPathActor* p_actor, MxBool p_bool) override;      // vtable+0x94
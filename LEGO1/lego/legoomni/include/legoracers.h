@@ -52,12 +52,13 @@ class LegoJetski : public LegoJetskiRaceActor, public LegoRaceMap {
 		return "LegoJetski";
 	}
 
-	// FUNCTION: LEGO1 0x10013eb0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoJetski::ClassName()) || LegoJetskiRaceActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoJetski", LegoJetskiRaceActor::g_typeInfo};
+
 	void ParseAction(char* p_extra) override;          // vtable+0x20
 	void SetWorldSpeed(MxFloat p_worldSpeed) override; // vtable+0x30
 
@@ -114,12 +115,13 @@ class LegoRaceCar : public LegoCarRaceActor, public LegoRaceMap {
 		return "LegoRaceCar";
 	}
 
-	// FUNCTION: LEGO1 0x100142c0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoRaceCar::ClassName()) || LegoCarRaceActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoRaceCar", LegoCarRaceActor::g_typeInfo};
+
 	void ParseAction(char* p_extra) override;          // vtable+0x20
 	void SetWorldSpeed(MxFloat p_worldSpeed) override; // vtable+0x30
 
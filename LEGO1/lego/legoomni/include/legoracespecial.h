@@ -28,13 +28,13 @@ class LegoCarRaceActor : public virtual LegoRaceActor {
 		return "LegoCarRaceActor";
 	}
 
-	// FUNCTION: LEGO1 0x10081680
-	// FUNCTION: BETA10 0x100aa9e0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoCarRaceActor::ClassName()) || LegoRaceActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoCarRaceActor", LegoRaceActor::g_typeInfo};
+
 	MxU32 VTable0x6c(
 		LegoPathBoundary* p_boundary,
 		Vector3& p_v1,
@@ -120,13 +120,13 @@ class LegoJetskiRaceActor : public virtual LegoCarRaceActor {
 		return "LegoJetskiRaceActor";
 	}
 
-	// FUNCTION: LEGO1 0x10081db0
-	// FUNCTION: BETA10 0x100aa960
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoJetskiRaceActor::ClassName()) || LegoCarRaceActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoJetskiRaceActor", LegoCarRaceActor::g_typeInfo};
+
 	MxU32 VTable0x6c(
 		LegoPathBoundary* p_boundary,
 		Vector3& p_v1,
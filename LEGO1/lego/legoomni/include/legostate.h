@@ -93,13 +93,13 @@ class LegoState : public MxCore {
 		return "LegoState";
 	}
 
-	// FUNCTION: LEGO1 0x100060e0
-	// FUNCTION: BETA10 0x100a9000
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoState::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoState", MxCore::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x10006160
 	// LegoState::`scalar deleting destructor'
 };
@@ -25,12 +25,13 @@ class LegoTexturePresenter : public MxMediaPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000ce60
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoTexturePresenter::ClassName()) || MxMediaPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoTexturePresenter", MxMediaPresenter::g_typeInfo};
+
 	void DoneTickle() override;       // vtable+0x2c
 	MxResult AddToManager() override; // vtable+0x34
 	MxResult PutData() override;      // vtable+0x4c
@@ -10,6 +10,7 @@
 #include "legoentity.h"
 #include "legomain.h"
 #include "legopathcontrollerlist.h"
+#include "legoworldindex.h"
 #include "roi/legoroi.h"
 
 class LegoCameraController;
@@ -76,13 +77,13 @@ class LegoWorld : public LegoEntity {
 		return "LegoWorld";
 	}
 
-	// FUNCTION: LEGO1 0x1001d6a0
-	// FUNCTION: BETA10 0x100175f0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoWorld::ClassName()) || LegoEntity::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoWorld", LegoEntity::g_typeInfo};
+
 	MxBool PresentersPending();
 	void Remove(MxCore* p_object);
 	MxResult PlaceActor(
@@ -110,6 +111,9 @@ class LegoWorld : public LegoEntity {
 	MxCore* Find(const char* p_class, const char* p_name);
 	MxCore* Find(const MxAtomId& p_atom, MxS32 p_entityId);
 
+	// [library:performance] Moves the index entry of p_entity, held by this world, to its new atom and id
+	void RekeyEntity(LegoEntity* p_entity, const MxAtomId& p_atomId, MxS32 p_entityId);
+
 	// FUNCTION: BETA10 0x1002b4f0
 	LegoCameraController* GetCameraController() { return m_cameraController; }
 
@@ -125,6 +129,18 @@ class LegoWorld : public LegoEntity {
 	// LegoWorld::`scalar deleting destructor'
 
 protected:
+	// Containers of the world, as told apart by the index
+	enum IndexKind {
+		e_indexEntity = 0,
+		e_indexControlPresenter,
+		e_indexAnimPresenter,
+		e_indexSet0xa8
+	};
+
+	void IndexAdd(MxCore* p_object, IndexKind p_kind);
+	void IndexRemove(MxCore* p_object, IndexKind p_kind);
+	static MxBool IndexBefore(const LegoWorldIndex::Entry& p_a, const LegoWorldIndex::Entry& p_b);
+
 	LegoPathControllerList m_pathControllerList; // 0x68
 	MxPresenterList m_animPresenters;            // 0x80
 	LegoCameraController* m_cameraController;    // 0x98
@@ -143,6 +159,15 @@ class LegoWorld : public LegoEntity {
 	MxS16 m_startupTicks;  // 0xf4
 	MxBool m_worldStarted; // 0xf6
 	undefined m_unk0xf7;   // 0xf7
+
+	// [library:performance] Find used to walk every container in turn. Presenters are indexed by
+	// the object name and by the atom and object id of their action, entities by their atom and id.
+	// An entity in the world moves its own entry when its atom or id changes (see RekeyEntity).
+	// Entities are still searched by ROI name linearly, since their ROI and its name change outside
+	// of the world's control.
+	LegoWorldIndex m_nameIndex;
+	LegoWorldIndex m_idIndex;
+	MxU32 m_indexOrder;
 };
 
 // clang-format off
@@ -0,0 +1,47 @@
+#ifndef LEGOWORLDINDEX_H
+#define LEGOWORLDINDEX_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+class MxCore;
+
+// Hash index over the objects of a LegoWorld, used by LegoWorld::Find. An entry only narrows
+// the search down: Find still checks every candidate it gets with the original comparison,
+// so entries that share a hash, or whose key went stale, never produce a wrong match.
+class LegoWorldIndex {
+public:
+	struct Entry {
+		MxU32 m_hash;
+		MxCore* m_object;
+		MxU8 m_kind;   // Which container of the world holds the object
+		MxU32 m_order; // Position in that container, for containers that keep insertion order
+	};
+
+	typedef vector<Entry> Bucket;
+
+	LegoWorldIndex() : m_count(0) {}
+
+	void Insert(MxU32 p_hash, MxCore* p_object, MxU8 p_kind, MxU32 p_order);
+	void Erase(MxU32 p_hash, MxCore* p_object);
+	void Erase(MxCore* p_object);
+	void Rekey(MxU32 p_oldHash, MxU32 p_newHash, MxCore* p_object);
+	void Clear();
+
+	// Returns the bucket that holds the entries with p_hash, or NULL
+	const Bucket* Lookup(MxU32 p_hash) const
+	{
+		return m_count ? &m_buckets[p_hash & (m_buckets.size() - 1)] : NULL;
+	}
+
+	static MxU32 HashName(const char* p_name);
+	static MxU32 HashId(const char* p_atom, MxS32 p_id);
+
+private:
+	void Grow();
+
+	vector<Bucket> m_buckets;
+	MxU32 m_count;
+};
+
+#endif // LEGOWORLDINDEX_H
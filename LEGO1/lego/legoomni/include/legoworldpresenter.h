@@ -33,12 +33,13 @@ class LegoWorldPresenter : public LegoEntityPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x10066640
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, LegoWorldPresenter::ClassName()) || LegoEntityPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"LegoWorldPresenter", LegoEntityPresenter::g_typeInfo};
+
 	void ReadyTickle() override;                                                           // vtable+0x18
 	void StartingTickle() override;                                                        // vtable+0x1c
 	void ParseExtra() override;                                                            // vtable+0x30
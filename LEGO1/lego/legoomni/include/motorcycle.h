@@ -19,12 +19,13 @@ class Motocycle : public IslePathActor {
 		return "Motorcycle";
 	}
 
-	// FUNCTION: LEGO1 0x10035850
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Motocycle::ClassName()) || IslePathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Motorcycle", IslePathActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                            // vtable+0x18
 	void Animate(float p_time) override;                                         // vtable+0x70
 	MxLong HandleClick() override;                                               // vtable+0xcc
@@ -28,12 +28,13 @@ class MxBackgroundAudioManager : public MxCore {
 		return "MxBackgroundAudioManager";
 	}
 
-	// FUNCTION: LEGO1 0x1007eb80
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxBackgroundAudioManager::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxBackgroundAudioManager", MxCore::g_typeInfo};
+
 	MxBool GetEnabled() { return m_enabled; }
 
 	void StartAction(MxParam& p_param);
@@ -21,12 +21,13 @@ class MxCompositeMediaPresenter : public MxCompositePresenter {
 		return "MxCompositeMediaPresenter";
 	}
 
-	// FUNCTION: LEGO1 0x10073f20
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxCompositeMediaPresenter::ClassName()) || MxCompositePresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxCompositeMediaPresenter", MxCompositePresenter::g_typeInfo};
+
 	void StartingTickle() override;                                           // vtable+0x1c
 	MxResult StartAction(MxStreamController*, MxDSAction* p_action) override; // vtable+0x3c
 	MxResult PutData() override;                                              // vtable+0x4c
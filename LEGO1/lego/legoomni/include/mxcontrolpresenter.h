@@ -31,12 +31,13 @@ class MxControlPresenter : public MxCompositePresenter {
 		return "MxControlPresenter";
 	}
 
-	// FUNCTION: LEGO1 0x10044010
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxControlPresenter::ClassName()) || MxCompositePresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxControlPresenter", MxCompositePresenter::g_typeInfo};
+
 	void ReadyTickle() override;                                     // vtable+0x18
 	void ParseExtra() override;                                      // vtable+0x30
 	MxResult AddToManager() override;                                // vtable+0x34
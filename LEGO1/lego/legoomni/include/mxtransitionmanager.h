@@ -33,12 +33,13 @@ class MxTransitionManager : public MxCore {
 		return "MxTransitionManager";
 	}
 
-	// FUNCTION: LEGO1 0x1004b960
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxTransitionManager::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxTransitionManager", MxCore::g_typeInfo};
+
 	virtual MxResult GetDDrawSurfaceFromVideoManager(); // vtable+0x14
 
 	enum TransitionType {
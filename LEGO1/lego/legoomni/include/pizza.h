@@ -118,12 +118,13 @@ class PizzaMissionState : public LegoState {
 		return "PizzaMissionState";
 	}
 
-	// FUNCTION: LEGO1 0x100392a0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, PizzaMissionState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"PizzaMissionState", LegoState::g_typeInfo};
+
 	MxResult Serialize(LegoStorage* p_storage) override; // vtable+0x1c
 
 	// FUNCTION: BETA10 0x100ef470
@@ -177,12 +178,13 @@ class Pizza : public IsleActor {
 		return "Pizza";
 	}
 
-	// FUNCTION: LEGO1 0x10037fa0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Pizza::ClassName()) || IsleActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Pizza", IsleActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                           // vtable+0x18
 	MxLong HandleClick() override;                                              // vtable+0x68
 	MxLong HandleEndAction(MxEndActionNotificationParam& p_param) override;     // vtable+0x74
@@ -23,12 +23,13 @@ class PizzeriaState : public LegoState {
 		return "PizzeriaState";
 	}
 
-	// FUNCTION: LEGO1 0x10017c30
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, PizzeriaState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"PizzeriaState", LegoState::g_typeInfo};
+
 	MxResult Serialize(LegoStorage* p_storage) override; // vtable+0x1c
 
 	// SYNTHETIC: LEGO1 0x10017ce0
@@ -62,12 +63,13 @@ class Pizzeria : public IsleActor {
 		return "Pizzeria";
 	}
 
-	// FUNCTION: LEGO1 0x1000e790
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Pizzeria::ClassName()) || IsleActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Pizzeria", IsleActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	MxLong HandleClick() override;                    // vtable+0x68
 
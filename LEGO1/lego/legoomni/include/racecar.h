@@ -20,12 +20,13 @@ class RaceCar : public IslePathActor {
 		return "RaceCar";
 	}
 
-	// FUNCTION: LEGO1 0x10028280
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, RaceCar::ClassName()) || IslePathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"RaceCar", IslePathActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override; // vtable+0x18
 	MxLong HandleClick() override;                    // vtable+0xcc
 
@@ -26,12 +26,13 @@ class RadioState : public LegoState {
 		return "RadioState";
 	}
 
-	// FUNCTION: LEGO1 0x1002cf70
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, RadioState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"RadioState", LegoState::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x1002d020
 	// RadioState::`scalar deleting destructor'
 
@@ -67,12 +68,13 @@ class Radio : public MxCore {
 		return "Radio";
 	}
 
-	// FUNCTION: LEGO1 0x1002c8f0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Radio::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Radio", MxCore::g_typeInfo};
+
 	void Initialize(MxBool p_und);
 	void CreateState();
 	void Play();
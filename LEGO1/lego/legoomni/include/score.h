@@ -33,12 +33,13 @@ class ScoreState : public LegoState {
 		return "ScoreState";
 	}
 
-	// FUNCTION: LEGO1 0x1000de50
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, ScoreState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"ScoreState", LegoState::g_typeInfo};
+
 	MxBool GetTutorialFlag() { return m_playCubeTutorial; }
 	void SetTutorialFlag(MxBool p_playCubeTutorial) { m_playCubeTutorial = p_playCubeTutorial; }
 
@@ -70,12 +71,13 @@ class Score : public LegoWorld {
 		return "Score";
 	}
 
-	// FUNCTION: LEGO1 0x100010d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, Score::ClassName()) || LegoWorld::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"Score", LegoWorld::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x100011e0
 	// Score::`scalar deleting destructor'
 
@@ -22,12 +22,13 @@ class SkateBoard : public IslePathActor {
 		return "SkateBoard";
 	}
 
-	// FUNCTION: LEGO1 0x1000fde0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, SkateBoard::ClassName()) || IslePathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"SkateBoard", IslePathActor::g_typeInfo};
+
 	MxResult Create(MxDSAction& p_dsAction) override;                            // vtable+0x18
 	MxLong HandleClick() override;                                               // vtable+0xcc
 	MxLong HandleNotification0() override;                                       // vtable+0xd0
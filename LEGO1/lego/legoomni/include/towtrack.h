@@ -56,12 +56,13 @@ class TowTrackMissionState : public LegoState {
 		return "TowTrackMissionState";
 	}
 
-	// FUNCTION: LEGO1 0x1004dfb0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, TowTrackMissionState::ClassName()) || LegoState::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"TowTrackMissionState", LegoState::g_typeInfo};
+
 	// FUNCTION: BETA10 0x10088890
 	MxS16 GetHighScore(MxU8 p_actorId)
 	{
@@ -157,12 +158,13 @@ class TowTrack : public IslePathActor {
 		return "TowTrack";
 	}
 
-	// FUNCTION: LEGO1 0x1004c7d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, TowTrack::ClassName()) || IslePathActor::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"TowTrack", IslePathActor::g_typeInfo};
+
 	MxLong Notify(MxParam& p_param) override;                                    // vtable+0x04
 	MxResult Create(MxDSAction& p_dsAction) override;                            // vtable+0x18
 	void Animate(float p_time) override;                                         // vtable+0x70
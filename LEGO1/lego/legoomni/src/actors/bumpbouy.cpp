@@ -3,6 +3,7 @@
 #include "isle.h"
 #include "isle_actions.h"
 #include "islepathactor.h"
+#include "jetski.h"
 #include "legogamestate.h"
 #include "legovideomanager.h"
 #include "misc.h"
@@ -38,7 +39,7 @@ MxLong BumpBouy::Notify(MxParam& p_param)
 	IslePathActor* user = (IslePathActor*) UserActor();
 	assert(user);
 
-	if (user->IsA("Jetski") && param.GetNotification() == c_notificationClick) {
+	if (user->IsA(Jetski::g_typeInfo) && param.GetNotification() == c_notificationClick) {
 		VideoManager()->SetRender3D(FALSE);
 		user->SetWorldSpeed(0);
 		user->Exit();
@@ -50,7 +50,7 @@ MxResult Helicopter::Create(MxDSAction& p_dsAction)
 	MxResult result = IslePathActor::Create(p_dsAction);
 
 	m_world = CurrentWorld();
-	if (m_world->IsA("Act3")) {
+	if (m_world->IsA(Act3::g_typeInfo)) {
 		((Act3*) m_world)->SetHelicopter(this);
 	}
 
@@ -92,7 +92,7 @@ void Helicopter::Exit()
 
 	if (GameState()->GetCurrentAct() == LegoGameState::e_act1) {
 		GameState()->m_currentArea = LegoGameState::e_copter;
-		if (UserActor() && UserActor()->IsA("IslePathActor")) {
+		if (UserActor() && UserActor()->IsA(IslePathActor::g_typeInfo)) {
 			((IslePathActor*) UserActor())
 				->SpawnPlayer(
 					LegoGameState::e_unk55,
@@ -10,6 +10,7 @@
 #include "misc.h"
 #include "pizza.h"
 #include "scripts.h"
+#include "skateboard.h"
 
 DECOMP_SIZE_ASSERT(Pizzeria, 0x84)
 DECOMP_SIZE_ASSERT(PizzeriaState, 0x58)
@@ -71,7 +72,7 @@ MxLong Pizzeria::HandleClick()
 {
 	if (FUN_1003ef60() && m_pizzaMissionState->m_unk0x0c == 0) {
 		if (UserActor()->GetActorId() != GameState()->GetActorId()) {
-			if (!UserActor()->IsA("SkateBoard")) {
+			if (!UserActor()->IsA(SkateBoard::g_typeInfo)) {
 				((IslePathActor*) UserActor())->Exit();
 			}
 		}
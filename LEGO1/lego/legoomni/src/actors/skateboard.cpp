@@ -85,12 +85,12 @@ MxLong SkateBoard::HandleClick()
 	TransitionManager()->StartTransition(MxTransitionManager::e_mosaic, 50, FALSE, TRUE);
 
 	if (GameState()->GetActorId() != UserActor()->GetActorId()) {
-		if (!UserActor()->IsA("SkateBoard")) {
+		if (!UserActor()->IsA(SkateBoard::g_typeInfo)) {
 			((IslePathActor*) UserActor())->Exit();
 		}
 	}
 
-	if (!UserActor()->IsA("SkateBoard")) {
+	if (!UserActor()->IsA(SkateBoard::g_typeInfo)) {
 		Enter();
 		InvokeAction(Extra::ActionType::e_start, *g_isleScript, IsleScript::c_SkateDashboard, NULL);
 		GetCurrentAction().SetObjectId(-1);
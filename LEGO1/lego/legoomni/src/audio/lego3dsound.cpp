@@ -87,7 +87,7 @@ MxResult Lego3DSound::Create(ma_sound* p_sound, const char* p_name, MxS32 p_volu
 	}
 
 	LegoEntity* entity = m_roi->GetEntity();
-	if (entity != NULL && entity->IsA("LegoActor") && ((LegoActor*) entity)->GetSoundFrequencyFactor() != 0.0f) {
+	if (entity != NULL && entity->IsA(LegoActor::g_typeInfo) && ((LegoActor*) entity)->GetSoundFrequencyFactor() != 0.0f) {
 		m_actor = ((LegoActor*) entity);
 	}
 
@@ -246,7 +246,7 @@ void Lego3DSound::FUN_10011a60(ma_sound* p_sound, const char* p_name)
 		}
 
 		LegoEntity* entity = m_roi->GetEntity();
-		if (entity != NULL && entity->IsA("LegoActor") && ((LegoActor*) entity)->GetSoundFrequencyFactor() != 0.0f) {
+		if (entity != NULL && entity->IsA(LegoActor::g_typeInfo) && ((LegoActor*) entity)->GetSoundFrequencyFactor() != 0.0f) {
 			m_actor = ((LegoActor*) entity);
 		}
 
@@ -1705,8 +1705,8 @@ MxS32 LegoCarBuild::FUN_10025ee0(undefined4 p_param1)
 
 // FUNCTION: LEGO1 0x10025f30
 LegoVehicleBuildState::LegoVehicleBuildState(const char* p_classType)
+	: m_className(p_classType), m_typeInfo(m_className.GetData(), LegoState::g_typeInfo)
 {
-	m_className = p_classType;
 	m_unk0x4c = 0;
 	m_unk0x4d = FALSE;
 	m_unk0x4e = FALSE;
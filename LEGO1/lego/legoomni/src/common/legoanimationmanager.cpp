@@ -1695,7 +1695,7 @@ MxBool LegoAnimationManager::FUN_100623a0(AnimInfo& p_info)
 			LegoPathActor* actor = UserActor();
 
 			while (cursor.Next(entity)) {
-				if (entity != actor && entity->IsA("LegoPathActor")) {
+				if (entity != actor && entity->IsA(LegoPathActor::g_typeInfo)) {
 					LegoROI* roi = entity->GetROI();
 
 					if (roi->GetVisibility() && FUN_10062650(position, und, roi)) {
@@ -7,6 +7,7 @@
 #include "legoanimationmanager.h"
 #include "legoanimpresenter.h"
 #include "legoendanimnotificationparam.h"
+#include "legoloopinganimpresenter.h"
 #include "legotraninfo.h"
 #include "legovideomanager.h"
 #include "legoworld.h"
@@ -85,7 +86,7 @@ MxResult LegoAnimMMPresenter::StartAction(MxStreamController* p_controller, MxDS
 				if (presenter->StartAction(p_controller, action) == SUCCESS) {
 					presenter->SetTickleState(MxPresenter::e_idle);
 
-					if (presenter->IsA("LegoAnimPresenter") || presenter->IsA("LegoLoopingAnimPresenter")) {
+					if (presenter->IsA(LegoAnimPresenter::g_typeInfo) || presenter->IsA(LegoLoopingAnimPresenter::g_typeInfo)) {
 						m_presenter = (LegoAnimPresenter*) presenter;
 					}
 					success = TRUE;
@@ -392,7 +393,7 @@ MxBool LegoAnimMMPresenter::FUN_1004b600(MxLong p_time)
 MxBool LegoAnimMMPresenter::FUN_1004b610(MxLong p_time)
 {
 	for (MxCompositePresenterList::iterator it = m_list.begin(); it != m_list.end(); it++) {
-		if ((*it)->IsA("LegoAnimPresenter") || (*it)->IsA("LegoLoopingAnimPresenter")) {
+		if ((*it)->IsA(LegoAnimPresenter::g_typeInfo) || (*it)->IsA(LegoLoopingAnimPresenter::g_typeInfo)) {
 			(*it)->SetTickleState(e_streaming);
 		}
 		else {
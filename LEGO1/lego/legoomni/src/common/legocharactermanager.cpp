@@ -104,7 +104,7 @@ void LegoCharacterManager::ReleaseAllActors()
 		if (info != NULL) {
 			LegoExtraActor* actor = info->m_actor;
 
-			if (actor != NULL && actor->IsA("LegoExtraActor")) {
+			if (actor != NULL && actor->IsA(LegoExtraActor::g_typeInfo)) {
 				LegoROI* roi = g_actorInfo[i].m_roi;
 				MxU32 refCount = GetRefCount(roi);
 
@@ -1132,7 +1132,7 @@ void LegoGameState::RegisterState(LegoState* p_state)
 {
 	MxS32 targetIndex;
 	for (targetIndex = 0; targetIndex < m_stateCount; ++targetIndex) {
-		if (m_stateArray[targetIndex]->IsA(p_state->ClassName())) {
+		if (m_stateArray[targetIndex]->IsA(p_state->GetTypeInfo())) {
 			break;
 		}
 	}
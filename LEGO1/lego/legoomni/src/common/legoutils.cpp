@@ -1,6 +1,7 @@
 #include "legoutils.h"
 
 #include "3dmanager/lego3dmanager.h"
+#include "ambulance.h"
 #include "anim/legoanim.h"
 #include "isle.h"
 #include "isle_actions.h"
@@ -29,6 +30,7 @@
 #include "mxvariabletable.h"
 #include "realtime/realtime.h"
 #include "scripts.h"
+#include "towtrack.h"
 
 #include <SDL2/SDL_events.h>
 #include <SDL2/SDL_stdinc.h>
@@ -505,7 +507,7 @@ MxBool RemoveFromCurrentWorld(const MxAtomId& p_atomId, MxS32 p_id)
 		if (object) {
 			world->Remove(object);
 
-			if (!object->IsA("MxPresenter")) {
+			if (!object->IsA(MxPresenter::g_typeInfo)) {
 				delete object;
 			}
 			else {
@@ -534,7 +536,7 @@ MxBool RemoveFromWorld(MxAtomId& p_entityAtom, MxS32 p_entityId, MxAtomId& p_wor
 		if (object) {
 			world->Remove(object);
 
-			if (!object->IsA("MxPresenter")) {
+			if (!object->IsA(MxPresenter::g_typeInfo)) {
 				delete object;
 			}
 			else {
@@ -588,8 +590,8 @@ MxBool FUN_1003ef60()
 		GameState()->m_currentArea != LegoGameState::e_elevdown &&
 		GameState()->m_currentArea != LegoGameState::e_garadoor &&
 		GameState()->m_currentArea != LegoGameState::e_polidoor) {
-		if (UserActor() == NULL || !UserActor()->IsA("TowTrack")) {
-			if (UserActor() == NULL || !UserActor()->IsA("Ambulance")) {
+		if (UserActor() == NULL || !UserActor()->IsA(TowTrack::g_typeInfo)) {
+			if (UserActor() == NULL || !UserActor()->IsA(Ambulance::g_typeInfo)) {
 				MxU32 unk0x18 = act1State->GetUnknown18();
 
 				if (unk0x18 != 10 && unk0x18 != 8 && unk0x18 != 3) {
@@ -3,12 +3,14 @@
 #include "legosoundmanager.h"
 #include "legovideomanager.h"
 #include "misc.h"
+#include "mxaudiopresenter.h"
 #include "mxautolock.h"
 #include "mxdsmultiaction.h"
 #include "mxmediapresenter.h"
 #include "mxmisc.h"
 #include "mxobjectfactory.h"
 #include "mxtimer.h"
+#include "mxvideopresenter.h"
 
 DECOMP_SIZE_ASSERT(MxCompositeMediaPresenter, 0x50)
 
@@ -61,10 +63,10 @@ MxResult MxCompositeMediaPresenter::StartAction(MxStreamController* p_controller
 				if (presenter->StartAction(p_controller, action) == SUCCESS) {
 					presenter->SetTickleState(e_idle);
 
-					if (presenter->IsA("MxVideoPresenter")) {
+					if (presenter->IsA(MxVideoPresenter::g_typeInfo)) {
 						VideoManager()->UnregisterPresenter(*presenter);
 					}
-					else if (presenter->IsA("MxAudioPresenter")) {
+					else if (presenter->IsA(MxAudioPresenter::g_typeInfo)) {
 						SoundManager()->UnregisterPresenter(*presenter);
 					}
 
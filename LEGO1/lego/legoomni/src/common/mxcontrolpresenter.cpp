@@ -87,7 +87,7 @@ MxBool MxControlPresenter::FUN_10044270(MxS32 p_x, MxS32 p_y, MxPresenter* p_pre
 
 	if (m_unk0x4c == 3) {
 		MxStillPresenter* map = (MxStillPresenter*) m_list.front();
-		assert(map && map->IsA("MxStillPresenter"));
+		assert(map && map->IsA(MxStillPresenter::g_typeInfo));
 
 		if (presenter == map || map->GetDisplayZ() < presenter->GetDisplayZ()) {
 			if (map->VTable0x7c()) {
@@ -85,12 +85,34 @@ void LegoEntity::SetWorldTransform(const Vector3& p_location, const Vector3& p_d
 // FUNCTION: BETA10 0x1007e572
 MxResult LegoEntity::Create(MxDSAction& p_dsAction)
 {
+	if (m_ownerWorld) {
+		m_ownerWorld->RekeyEntity(this, p_dsAction.GetAtomId(), p_dsAction.GetObjectId());
+	}
+
 	m_entityId = p_dsAction.GetObjectId();
 	m_atomId = p_dsAction.GetAtomId();
 	SetWorld();
 	return SUCCESS;
 }
 
+void LegoEntity::SetEntityId(MxS32 p_entityId)
+{
+	if (m_ownerWorld) {
+		m_ownerWorld->RekeyEntity(this, m_atomId, p_entityId);
+	}
+
+	m_entityId = p_entityId;
+}
+
+void LegoEntity::SetAtomId(const MxAtomId& p_atomId)
+{
+	if (m_ownerWorld) {
+		m_ownerWorld->RekeyEntity(this, p_atomId, m_entityId);
+	}
+
+	m_atomId = p_atomId;
+}
+
 // FUNCTION: LEGO1 0x10010810
 // FUNCTION: BETA10 0x1007e5b9
 void LegoEntity::Destroy(MxBool p_fromDestructor)
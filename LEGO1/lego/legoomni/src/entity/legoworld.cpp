@@ -1,6 +1,7 @@
 #include "legoworld.h"
 
 #include "anim/legoanim.h"
+#include "legoactioncontrolpresenter.h"
 #include "legoanimationmanager.h"
 #include "legoanimpresenter.h"
 #include "legobuildingmanager.h"
@@ -8,6 +9,7 @@
 #include "legocameracontroller.h"
 #include "legocontrolmanager.h"
 #include "legogamestate.h"
+#include "legohideanimpresenter.h"
 #include "legoinputmanager.h"
 #include "legolocomotionanimpresenter.h"
 #include "legonavcontroller.h"
@@ -15,6 +17,7 @@
 #include "legosoundmanager.h"
 #include "legoutils.h"
 #include "legovideomanager.h"
+#include "legoworldpresenter.h"
 #include "misc.h"
 #include "mxactionnotificationparam.h"
 #include "mxcontrolpresenter.h"
@@ -43,6 +46,7 @@ LegoWorld::LegoWorld() : m_pathControllerList(TRUE)
 	m_destroyed = FALSE;
 	m_hideAnim = NULL;
 	m_worldStarted = FALSE;
+	m_indexOrder = 0;
 
 	NotificationManager()->Register(this);
 }
@@ -114,10 +118,11 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 
 	while (animPresenterCursor.First(presenter)) {
 		animPresenterCursor.Detach();
+		IndexRemove(presenter, e_indexAnimPresenter);
 
 		MxDSAction* action = presenter->GetAction();
 		if (action) {
-			if (presenter->IsA("LegoLocomotionAnimPresenter")) {
+			if (presenter->IsA(LegoLocomotionAnimPresenter::g_typeInfo)) {
 				LegoLocomotionAnimPresenter* animPresenter = (LegoLocomotionAnimPresenter*) presenter;
 
 				animPresenter->DecrementUnknown0xd4();
@@ -138,8 +143,10 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 		MxCore* object = *it;
 		m_set0xa8.erase(it);
 
-		if (object->IsA("MxPresenter")) {
+		if (object->IsA(MxPresenter::g_typeInfo)) {
 			MxPresenter* presenter = (MxPresenter*) object;
+			IndexRemove(presenter, e_indexSet0xa8);
+
 			MxDSAction* action = presenter->GetAction();
 
 			if (action) {
@@ -156,6 +163,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 
 	while (controlPresenterCursor.First(presenter)) {
 		controlPresenterCursor.Detach();
+		IndexRemove(presenter, e_indexControlPresenter);
 
 		MxDSAction* action = presenter->GetAction();
 		if (action) {
@@ -175,6 +183,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 
 		while (cursor.First(entity)) {
 			cursor.Detach();
+			IndexRemove(entity, e_indexEntity);
 
 			if (!(entity->GetFlags() & LegoEntity::c_managerOwned)) {
 				delete entity;
@@ -185,6 +194,9 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 		m_entityList = NULL;
 	}
 
+	m_nameIndex.Clear();
+	m_idIndex.Clear();
+
 	if (m_cacheSoundList) {
 		LegoCacheSoundListCursor cursor(m_cacheSoundList);
 		LegoCacheSound* sound;
@@ -419,12 +431,12 @@ MxResult LegoWorld::GetCurrPathInfo(LegoPathBoundary** p_boundaries, MxS32& p_nu
 // FUNCTION: BETA10 0x100da90b
 void LegoWorld::Add(MxCore* p_object)
 {
-	if (p_object == NULL || p_object->IsA("LegoWorld") || p_object->IsA("LegoWorldPresenter")) {
+	if (p_object == NULL || p_object->IsA(LegoWorld::g_typeInfo) || p_object->IsA(LegoWorldPresenter::g_typeInfo)) {
 		return;
 	}
 
 #ifndef BETA10
-	if (p_object->IsA("LegoAnimPresenter")) {
+	if (p_object->IsA(LegoAnimPresenter::g_typeInfo)) {
 		if (!SDL_strcasecmp(((LegoAnimPresenter*) p_object)->GetAction()->GetObjectName(), "ConfigAnimation")) {
 			FUN_1003e050((LegoAnimPresenter*) p_object);
 			((LegoAnimPresenter*) p_object)
@@ -434,7 +446,7 @@ void LegoWorld::Add(MxCore* p_object)
 	}
 #endif
 
-	if (p_object->IsA("MxControlPresenter")) {
+	if (p_object->IsA(MxControlPresenter::g_typeInfo)) {
 		MxPresenterListCursor cursor(&m_controlPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
@@ -443,8 +455,9 @@ void LegoWorld::Add(MxCore* p_object)
 		}
 
 		m_controlPresenters.Append((MxPresenter*) p_object);
+		IndexAdd(p_object, e_indexControlPresenter);
 	}
-	else if (p_object->IsA("MxEntity")) {
+	else if (p_object->IsA(MxEntity::g_typeInfo)) {
 		LegoEntityListCursor cursor(m_entityList);
 
 		if (cursor.Find((LegoEntity*) p_object)) {
@@ -453,8 +466,9 @@ void LegoWorld::Add(MxCore* p_object)
 		}
 
 		m_entityList->Append((LegoEntity*) p_object);
+		IndexAdd(p_object, e_indexEntity);
 	}
-	else if (p_object->IsA("LegoLocomotionAnimPresenter") || p_object->IsA("LegoHideAnimPresenter") || p_object->IsA("LegoLoopingAnimPresenter")) {
+	else if (p_object->IsA(LegoLocomotionAnimPresenter::g_typeInfo) || p_object->IsA(LegoHideAnimPresenter::g_typeInfo) || p_object->IsA(LegoLoopingAnimPresenter::g_typeInfo)) {
 		MxPresenterListCursor cursor(&m_animPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
@@ -464,13 +478,14 @@ void LegoWorld::Add(MxCore* p_object)
 
 		((MxPresenter*) p_object)->SendToCompositePresenter(Lego());
 		m_animPresenters.Append(((MxPresenter*) p_object));
+		IndexAdd(p_object, e_indexAnimPresenter);
 
-		if (p_object->IsA("LegoHideAnimPresenter")) {
+		if (p_object->IsA(LegoHideAnimPresenter::g_typeInfo)) {
 			m_hideAnim = (LegoHideAnimPresenter*) p_object;
 		}
 	}
 #ifndef BETA10
-	else if (p_object->IsA("LegoCacheSound")) {
+	else if (p_object->IsA(LegoCacheSound::g_typeInfo)) {
 		LegoCacheSoundListCursor cursor(m_cacheSoundList);
 
 		if (cursor.Find((LegoCacheSound*) p_object)) {
@@ -485,19 +500,23 @@ void LegoWorld::Add(MxCore* p_object)
 		MxCoreSet::iterator it = m_set0xa8.find(p_object);
 		if (it == m_set0xa8.end()) {
 #ifdef BETA10
-			if (p_object->IsA("MxPresenter")) {
+			if (p_object->IsA(MxPresenter::g_typeInfo)) {
 				assert(static_cast<MxPresenter*>(p_object)->GetAction());
 			}
 #endif
 
 			m_set0xa8.insert(p_object);
+
+			if (p_object->IsA(MxPresenter::g_typeInfo)) {
+				IndexAdd(p_object, e_indexSet0xa8);
+			}
 		}
 		else {
 			assert(0);
 		}
 	}
 
-	if (m_set0xd0.size() != 0 && p_object->IsA("MxPresenter")) {
+	if (m_set0xd0.size() != 0 && p_object->IsA(MxPresenter::g_typeInfo)) {
 		if (((MxPresenter*) p_object)->IsEnabled()) {
 			((MxPresenter*) p_object)->Enable(FALSE);
 			m_set0xd0.insert(p_object);
@@ -515,28 +534,30 @@ void LegoWorld::Remove(MxCore* p_object)
 		return;
 	}
 
-	if (p_object->IsA("MxControlPresenter")) {
+	if (p_object->IsA(MxControlPresenter::g_typeInfo)) {
 		MxPresenterListCursor cursor(&m_controlPresenters);
 
 		if (cursor.Find((MxControlPresenter*) p_object)) {
 			cursor.Detach();
+			IndexRemove(p_object, e_indexControlPresenter);
 			((MxControlPresenter*) p_object)->GetAction()->SetOrigin(Lego());
 			((MxControlPresenter*) p_object)->VTable0x68(TRUE);
 		}
 	}
-	else if (p_object->IsA("LegoLocomotionAnimPresenter") || p_object->IsA("LegoHideAnimPresenter") || p_object->IsA("LegoLoopingAnimPresenter")) {
+	else if (p_object->IsA(LegoLocomotionAnimPresenter::g_typeInfo) || p_object->IsA(LegoHideAnimPresenter::g_typeInfo) || p_object->IsA(LegoLoopingAnimPresenter::g_typeInfo)) {
 		MxPresenterListCursor cursor(&m_animPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
 			cursor.Detach();
+			IndexRemove(p_object, e_indexAnimPresenter);
 		}
 
-		if (p_object->IsA("LegoHideAnimPresenter")) {
+		if (p_object->IsA(LegoHideAnimPresenter::g_typeInfo)) {
 			m_hideAnim = NULL;
 		}
 	}
-	else if (p_object->IsA("MxEntity")) {
-		if (p_object->IsA("LegoPathActor")) {
+	else if (p_object->IsA(MxEntity::g_typeInfo)) {
+		if (p_object->IsA(LegoPathActor::g_typeInfo)) {
 			RemoveActor((LegoPathActor*) p_object);
 		}
 
@@ -545,11 +566,12 @@ void LegoWorld::Remove(MxCore* p_object)
 
 			if (cursor.Find((LegoEntity*) p_object)) {
 				cursor.Detach();
+				IndexRemove(p_object, e_indexEntity);
 			}
 		}
 	}
 #ifndef BETA10
-	else if (p_object->IsA("LegoCacheSound")) {
+	else if (p_object->IsA(LegoCacheSound::g_typeInfo)) {
 		LegoCacheSoundListCursor cursor(m_cacheSoundList);
 
 		if (cursor.Find((LegoCacheSound*) p_object)) {
@@ -561,6 +583,10 @@ void LegoWorld::Remove(MxCore* p_object)
 		it = m_set0xa8.find(p_object);
 		if (it != m_set0xa8.end()) {
 			m_set0xa8.erase(it);
+
+			if (p_object->IsA(MxPresenter::g_typeInfo)) {
+				IndexRemove(p_object, e_indexSet0xa8);
+			}
 		}
 	}
 
@@ -574,19 +600,6 @@ void LegoWorld::Remove(MxCore* p_object)
 // FUNCTION: BETA10 0x100db027
 MxCore* LegoWorld::Find(const char* p_class, const char* p_name)
 {
-	if (!strcmp(p_class, "MxControlPresenter")) {
-		MxPresenterListCursor cursor(&m_controlPresenters);
-		MxPresenter* presenter;
-
-		while (cursor.Next(presenter)) {
-			if (!strcmp(presenter->GetAction()->GetObjectName(), p_name)) {
-				return presenter;
-			}
-		}
-
-		return NULL;
-	}
-
 	if (!strcmp(p_class, "MxEntity")) {
 		LegoEntityListCursor cursor(m_entityList);
 		LegoEntity* entity;
@@ -605,80 +618,163 @@ MxCore* LegoWorld::Find(const char* p_class, const char* p_name)
 		return NULL;
 	}
 
-	if (!strcmp(p_class, "LegoAnimPresenter")) {
-		MxPresenterListCursor cursor(&m_animPresenters);
-		MxPresenter* presenter;
+	IndexKind kind;
+	if (!strcmp(p_class, "MxControlPresenter")) {
+		kind = e_indexControlPresenter;
+	}
+	else if (!strcmp(p_class, "LegoAnimPresenter")) {
+		kind = e_indexAnimPresenter;
+	}
+	else {
+		kind = e_indexSet0xa8;
+	}
 
-		while (cursor.Next(presenter)) {
-			if (!SDL_strcasecmp(((LegoAnimPresenter*) presenter)->GetActionObjectName(), p_name)) {
-				return presenter;
-			}
+	MxU32 hash = LegoWorldIndex::HashName(p_name);
+	const LegoWorldIndex::Bucket* bucket = m_nameIndex.Lookup(hash);
+	const LegoWorldIndex::Entry* match = NULL;
+
+	for (MxU32 i = 0; bucket != NULL && i < bucket->size(); i++) {
+		const LegoWorldIndex::Entry& entry = (*bucket)[i];
+
+		if (entry.m_hash != hash || entry.m_kind != kind || (match && !IndexBefore(entry, *match))) {
+			continue;
 		}
 
-		return NULL;
-	}
+		MxPresenter* presenter = (MxPresenter*) entry.m_object;
 
-	for (MxCoreSet::iterator i = m_set0xa8.begin(); i != m_set0xa8.end(); i++) {
-		if ((*i)->IsA(p_class) && (*i)->IsA("MxPresenter")) {
-			assert(((MxPresenter*) (*i))->GetAction());
+		switch (kind) {
+		case e_indexControlPresenter:
+			if (!strcmp(presenter->GetAction()->GetObjectName(), p_name)) {
+				match = &entry;
+			}
+			break;
+		case e_indexAnimPresenter:
+			if (!SDL_strcasecmp(((LegoAnimPresenter*) presenter)->GetActionObjectName(), p_name)) {
+				match = &entry;
+			}
+			break;
+		default:
+			if (presenter->IsA(p_class)) {
+				assert(presenter->GetAction());
 
-			if (!strcmp(((MxPresenter*) (*i))->GetAction()->GetObjectName(), p_name)) {
-				return *i;
+				if (!strcmp(presenter->GetAction()->GetObjectName(), p_name)) {
+					match = &entry;
+				}
 			}
+			break;
 		}
 	}
 
-	return NULL;
+	return match ? match->m_object : NULL;
 }
 
 // FUNCTION: LEGO1 0x10021790
 // FUNCTION: BETA10 0x100db3de
 MxCore* LegoWorld::Find(const MxAtomId& p_atom, MxS32 p_entityId)
 {
-	LegoEntityListCursor entityCursor(m_entityList);
-	LegoEntity* entity;
+	MxU32 hash = LegoWorldIndex::HashId(p_atom.GetInternal(), p_entityId);
+	const LegoWorldIndex::Bucket* bucket = m_idIndex.Lookup(hash);
+	const LegoWorldIndex::Entry* match = NULL;
+
+	for (MxU32 i = 0; bucket != NULL && i < bucket->size(); i++) {
+		const LegoWorldIndex::Entry& entry = (*bucket)[i];
 
-	while (entityCursor.Next(entity)) {
-		if (entity->GetAtomId() == p_atom && entity->GetEntityId() == p_entityId) {
-			return entity;
+		if (entry.m_hash != hash || (match && !IndexBefore(entry, *match))) {
+			continue;
 		}
-	}
 
-	MxPresenterListCursor controlPresenterCursor(&m_controlPresenters);
-	MxPresenter* presenter;
+		if (entry.m_kind == e_indexEntity) {
+			LegoEntity* entity = (LegoEntity*) entry.m_object;
 
-	while (controlPresenterCursor.Next(presenter)) {
-		MxDSAction* action = presenter->GetAction();
+			if (entity->GetAtomId() == p_atom && entity->GetEntityId() == p_entityId) {
+				match = &entry;
+			}
+		}
+		else {
+			MxDSAction* action = ((MxPresenter*) entry.m_object)->GetAction();
 
-		if (action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
-			return presenter;
+			if (action && action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
+				match = &entry;
+			}
 		}
 	}
 
-	MxPresenterListCursor animPresenterCursor(&m_animPresenters);
+	return match ? match->m_object : NULL;
+}
 
-	while (animPresenterCursor.Next(presenter)) {
-		MxDSAction* action = presenter->GetAction();
+// Adds p_object, which was just placed in the container p_kind stands for, to the indices
+void LegoWorld::IndexAdd(MxCore* p_object, IndexKind p_kind)
+{
+	if (p_kind == e_indexEntity) {
+		LegoEntity* entity = (LegoEntity*) p_object;
+		MxU32 hash = LegoWorldIndex::HashId(entity->GetAtomId().GetInternal(), entity->GetEntityId());
+		m_idIndex.Insert(hash, p_object, p_kind, m_indexOrder++);
+		entity->SetOwnerWorld(this);
+		return;
+	}
 
-		if (action && action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
-			return presenter;
-		}
+	MxDSAction* action = ((MxPresenter*) p_object)->GetAction();
+	if (action == NULL) {
+		return;
 	}
 
-	for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
-		MxCore* core = *it;
+	MxU32 order = m_indexOrder++;
+	m_nameIndex.Insert(LegoWorldIndex::HashName(action->GetObjectName()), p_object, p_kind, order);
+	m_idIndex.Insert(
+		LegoWorldIndex::HashId(action->GetAtomId().GetInternal(), action->GetObjectId()),
+		p_object,
+		p_kind,
+		order
+	);
+}
 
-		if (core->IsA("MxPresenter")) {
-			MxPresenter* presenter = (MxPresenter*) *it;
-			MxDSAction* action = presenter->GetAction();
+// Removes p_object, which was just taken out of the container p_kind stands for, from the indices
+void LegoWorld::IndexRemove(MxCore* p_object, IndexKind p_kind)
+{
+	if (p_kind == e_indexEntity) {
+		LegoEntity* entity = (LegoEntity*) p_object;
+		m_idIndex.Erase(LegoWorldIndex::HashId(entity->GetAtomId().GetInternal(), entity->GetEntityId()), p_object);
 
-			if (action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
-				return *it;
-			}
+		if (entity->GetOwnerWorld() == this) {
+			entity->SetOwnerWorld(NULL);
 		}
+
+		return;
 	}
 
-	return NULL;
+	MxDSAction* action = ((MxPresenter*) p_object)->GetAction();
+	if (action == NULL) {
+		m_nameIndex.Erase(p_object);
+		m_idIndex.Erase(p_object);
+		return;
+	}
+
+	m_nameIndex.Erase(LegoWorldIndex::HashName(action->GetObjectName()), p_object);
+	m_idIndex.Erase(LegoWorldIndex::HashId(action->GetAtomId().GetInternal(), action->GetObjectId()), p_object);
+}
+
+// The entity is still keyed on its old atom and id, which are about to change
+void LegoWorld::RekeyEntity(LegoEntity* p_entity, const MxAtomId& p_atomId, MxS32 p_entityId)
+{
+	m_idIndex.Rekey(
+		LegoWorldIndex::HashId(p_entity->GetAtomId().GetInternal(), p_entity->GetEntityId()),
+		LegoWorldIndex::HashId(p_atomId.GetInternal(), p_entityId),
+		p_entity
+	);
+}
+
+// Whether p_a comes first in the order the containers used to be searched in
+MxBool LegoWorld::IndexBefore(const LegoWorldIndex::Entry& p_a, const LegoWorldIndex::Entry& p_b)
+{
+	if (p_a.m_kind != p_b.m_kind) {
+		return p_a.m_kind < p_b.m_kind;
+	}
+
+	if (p_a.m_kind == e_indexSet0xa8) {
+		return CoreSetCompare()(p_a.m_object, p_b.m_object);
+	}
+
+	return p_a.m_order < p_b.m_order;
 }
 
 // FUNCTION: LEGO1 0x10021a70
@@ -713,10 +809,10 @@ void LegoWorld::Enable(MxBool p_enable)
 		while (m_set0xd0.size() != 0) {
 			it = m_set0xd0.begin();
 
-			if ((*it)->IsA("MxPresenter")) {
+			if ((*it)->IsA(MxPresenter::g_typeInfo)) {
 				((MxPresenter*) *it)->Enable(TRUE);
 			}
-			else if ((*it)->IsA("LegoPathController")) {
+			else if ((*it)->IsA(LegoPathController::g_typeInfo)) {
 				((LegoPathController*) *it)->Enable(TRUE);
 			}
 
@@ -773,8 +869,8 @@ void LegoWorld::Enable(MxBool p_enable)
 		}
 
 		for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
-			if ((*it)->IsA("LegoActionControlPresenter") ||
-				((*it)->IsA("MxPresenter") && ((MxPresenter*) *it)->IsEnabled())) {
+			if ((*it)->IsA(LegoActionControlPresenter::g_typeInfo) ||
+				((*it)->IsA(MxPresenter::g_typeInfo) && ((MxPresenter*) *it)->IsEnabled())) {
 				m_set0xd0.insert(*it);
 				((MxPresenter*) *it)->Enable(FALSE);
 			}
@@ -846,7 +942,7 @@ MxBool LegoWorld::PresentersPending()
 
 	while (animPresenterCursor.Next(presenter)) {
 		if (presenter->IsEnabled()) {
-			if (presenter->IsA("LegoLocomotionAnimPresenter")) {
+			if (presenter->IsA(LegoLocomotionAnimPresenter::g_typeInfo)) {
 				if (!presenter->HasTickleStatePassed(MxPresenter::e_ready)) {
 					return TRUE;
 				}
@@ -860,7 +956,7 @@ MxBool LegoWorld::PresentersPending()
 	}
 
 	for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
-		if ((*it)->IsA("MxPresenter")) {
+		if ((*it)->IsA(MxPresenter::g_typeInfo)) {
 			presenter = (MxPresenter*) *it;
 
 			if (presenter->IsEnabled() && !presenter->HasTickleStatePassed(MxPresenter::e_starting)) {
@@ -0,0 +1,120 @@
+#include "legoworldindex.h"
+
+#include <SDL2/SDL_stdinc.h>
+
+void LegoWorldIndex::Insert(MxU32 p_hash, MxCore* p_object, MxU8 p_kind, MxU32 p_order)
+{
+	if (m_count >= m_buckets.size()) {
+		Grow();
+	}
+
+	Entry entry;
+	entry.m_hash = p_hash;
+	entry.m_object = p_object;
+	entry.m_kind = p_kind;
+	entry.m_order = p_order;
+
+	m_buckets[p_hash & (m_buckets.size() - 1)].push_back(entry);
+	m_count++;
+}
+
+// Removes the entry of p_object indexed under p_hash, if there is one
+void LegoWorldIndex::Erase(MxU32 p_hash, MxCore* p_object)
+{
+	if (m_count == 0) {
+		return;
+	}
+
+	Bucket& bucket = m_buckets[p_hash & (m_buckets.size() - 1)];
+
+	for (MxU32 i = 0; i < bucket.size(); i++) {
+		if (bucket[i].m_hash == p_hash && bucket[i].m_object == p_object) {
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			m_count--;
+			return;
+		}
+	}
+}
+
+// Removes every entry of p_object, wherever it is
+void LegoWorldIndex::Erase(MxCore* p_object)
+{
+	for (MxU32 i = 0; i < m_buckets.size(); i++) {
+		Bucket& bucket = m_buckets[i];
+
+		for (MxU32 j = 0; j < bucket.size();) {
+			if (bucket[j].m_object == p_object) {
+				bucket[j] = bucket.back();
+				bucket.pop_back();
+				m_count--;
+			}
+			else {
+				j++;
+			}
+		}
+	}
+}
+
+// Moves the entry of p_object from p_oldHash to p_newHash, keeping its place in the search order
+void LegoWorldIndex::Rekey(MxU32 p_oldHash, MxU32 p_newHash, MxCore* p_object)
+{
+	if (m_count == 0 || p_oldHash == p_newHash) {
+		return;
+	}
+
+	Bucket& bucket = m_buckets[p_oldHash & (m_buckets.size() - 1)];
+
+	for (MxU32 i = 0; i < bucket.size(); i++) {
+		if (bucket[i].m_hash == p_oldHash && bucket[i].m_object == p_object) {
+			Entry entry = bucket[i];
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+
+			entry.m_hash = p_newHash;
+			m_buckets[p_newHash & (m_buckets.size() - 1)].push_back(entry);
+			return;
+		}
+	}
+}
+
+void LegoWorldIndex::Clear()
+{
+	m_buckets.clear();
+	m_count = 0;
+}
+
+void LegoWorldIndex::Grow()
+{
+	vector<Bucket> buckets(m_buckets.size() ? m_buckets.size() * 2 : 64);
+
+	for (MxU32 i = 0; i < m_buckets.size(); i++) {
+		for (MxU32 j = 0; j < m_buckets[i].size(); j++) {
+			const Entry& entry = m_buckets[i][j];
+			buckets[entry.m_hash & (buckets.size() - 1)].push_back(entry);
+		}
+	}
+
+	m_buckets.swap(buckets);
+}
+
+// FNV-1a of the lower case name, so one index serves both strcmp and strcasecmp lookups
+MxU32 LegoWorldIndex::HashName(const char* p_name)
+{
+	MxU32 hash = 2166136261u;
+
+	for (; p_name != NULL && *p_name != '\0'; p_name++) {
+		hash ^= (MxU8) SDL_tolower((unsigned char) *p_name);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+// Atoms are interned, the address of their string identifies them
+MxU32 LegoWorldIndex::HashId(const char* p_atom, MxS32 p_id)
+{
+	MxU32 hash = (MxU32) (size_t) p_atom * 2654435761u;
+	hash ^= (MxU32) p_id + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+	return hash;
+}
@@ -16,10 +16,12 @@
 #include "modeldb/modeldb.h"
 #include "mxactionnotificationparam.h"
 #include "mxautolock.h"
+#include "mxcontrolpresenter.h"
 #include "mxdsactionlist.h"
 #include "mxdschunk.h"
 #include "mxdsmediaaction.h"
 #include "mxdsmultiaction.h"
+#include "mxdsserialaction.h"
 #include "mxmisc.h"
 #include "mxnotificationmanager.h"
 #include "mxobjectfactory.h"
@@ -144,7 +146,7 @@ void LegoWorldPresenter::ReadyTickle()
 // FUNCTION: LEGO1 0x10066ac0
 void LegoWorldPresenter::StartingTickle()
 {
-	if (m_action->IsA("MxDSSerialAction")) {
+	if (m_action->IsA(MxDSSerialAction::g_typeInfo)) {
 		MxPresenter* presenter = *m_list.begin();
 		if (presenter->GetCurrentTickleState() == e_idle) {
 			presenter->SetTickleState(e_ready);
@@ -406,7 +408,7 @@ void LegoWorldPresenter::VTable0x60(MxPresenter* p_presenter)
 	MxDSAction* action = p_presenter->GetAction();
 
 	if (action->GetDuration() != -1 && (action->GetFlags() & MxDSAction::c_looping) == 0) {
-		if (!action->IsA("MxDSMediaAction")) {
+		if (!action->IsA(MxDSMediaAction::g_typeInfo)) {
 			return;
 		}
 
@@ -415,8 +417,8 @@ void LegoWorldPresenter::VTable0x60(MxPresenter* p_presenter)
 		}
 	}
 
-	if (!p_presenter->IsA("LegoAnimPresenter") && !p_presenter->IsA("MxControlPresenter") &&
-		!p_presenter->IsA("MxCompositePresenter")) {
+	if (!p_presenter->IsA(LegoAnimPresenter::g_typeInfo) && !p_presenter->IsA(MxControlPresenter::g_typeInfo) &&
+		!p_presenter->IsA(MxCompositePresenter::g_typeInfo)) {
 		p_presenter->SendToCompositePresenter(Lego());
 		((LegoWorld*) m_entity)->Add(p_presenter);
 	}
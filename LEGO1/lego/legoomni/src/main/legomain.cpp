@@ -413,7 +413,7 @@ void LegoOmni::DeleteObject(MxDSAction& p_dsAction)
 			if (entity) {
 				m_currentWorld->Remove(entity);
 
-				if (entity->IsA("MxPresenter")) {
+				if (entity->IsA(MxPresenter::g_typeInfo)) {
 					Streamer()->FUN_100b98f0(((MxPresenter*) entity)->GetAction());
 					((MxPresenter*) entity)->EndAction();
 				}
@@ -823,7 +823,7 @@ void LegoAnimPresenter::StartingTickle()
 
 	ProgressTickleState(e_streaming);
 
-	if (m_compositePresenter && m_compositePresenter->IsA("LegoAnimMMPresenter")) {
+	if (m_compositePresenter && m_compositePresenter->IsA(LegoAnimMMPresenter::g_typeInfo)) {
 		m_unk0x96 = ((LegoAnimMMPresenter*) m_compositePresenter)->FUN_1004b8b0();
 		m_compositePresenter->VTable0x60(this);
 	}
@@ -848,7 +848,7 @@ void LegoAnimPresenter::StreamingTickle()
 	if (m_unk0x95) {
 		ProgressTickleState(e_done);
 		if (m_compositePresenter) {
-			if (m_compositePresenter->IsA("LegoAnimMMPresenter")) {
+			if (m_compositePresenter->IsA(LegoAnimMMPresenter::g_typeInfo)) {
 				m_compositePresenter->VTable0x60(this);
 			}
 		}
@@ -1132,7 +1132,7 @@ void LegoAnimPresenter::VTable0x8c()
 
 	if (m_currentWorld) {
 		m_currentWorld->FUN_1001fda0(this);
-		if (!m_compositePresenter || !m_compositePresenter->IsA("LegoAnimMMPresenter")) {
+		if (!m_compositePresenter || !m_compositePresenter->IsA(LegoAnimMMPresenter::g_typeInfo)) {
 			m_currentWorld->Add(this);
 		}
 	}
@@ -1145,7 +1145,7 @@ void LegoAnimPresenter::VTable0x90()
 	if (m_currentWorld != NULL) {
 		m_currentWorld->FUN_1001fe90(this);
 
-		if (m_compositePresenter != NULL && m_compositePresenter->IsA("LegoAnimMMPresenter")) {
+		if (m_compositePresenter != NULL && m_compositePresenter->IsA(LegoAnimMMPresenter::g_typeInfo)) {
 			return;
 		}
 
@@ -1,6 +1,7 @@
 #include "legoloopinganimpresenter.h"
 
 #include "anim/legoanim.h"
+#include "legoanimmmpresenter.h"
 #include "legocameracontroller.h"
 #include "legoworld.h"
 #include "mxcompositepresenter.h"
@@ -21,7 +22,7 @@ void LegoLoopingAnimPresenter::StreamingTickle()
 	if (m_unk0x95) {
 		ProgressTickleState(e_done);
 		if (m_compositePresenter) {
-			if (m_compositePresenter->IsA("LegoAnimMMPresenter")) {
+			if (m_compositePresenter->IsA(LegoAnimMMPresenter::g_typeInfo)) {
 				m_compositePresenter->VTable0x60(this);
 			}
 		}
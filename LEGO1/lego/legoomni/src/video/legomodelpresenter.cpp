@@ -232,7 +232,7 @@ MxResult LegoModelPresenter::FUN_1007ff70(
 // FUNCTION: BETA10 0x100991c2
 void LegoModelPresenter::ReadyTickle()
 {
-	if (m_compositePresenter != NULL && m_compositePresenter->IsA("LegoEntityPresenter") &&
+	if (m_compositePresenter != NULL && m_compositePresenter->IsA(LegoEntityPresenter::g_typeInfo) &&
 		m_compositePresenter->GetCurrentTickleState() <= e_ready) {
 		return;
 	}
@@ -240,7 +240,7 @@ void LegoModelPresenter::ReadyTickle()
 	ParseExtra();
 
 	if (m_roi != NULL) {
-		if (m_compositePresenter && m_compositePresenter->IsA("LegoEntityPresenter")) {
+		if (m_compositePresenter && m_compositePresenter->IsA(LegoEntityPresenter::g_typeInfo)) {
 			((LegoEntityPresenter*) m_compositePresenter)->GetInternalEntity()->SetROI(m_roi, m_addedToView, TRUE);
 			((LegoEntityPresenter*) m_compositePresenter)
 				->GetInternalEntity()
@@ -267,7 +267,7 @@ void LegoModelPresenter::ReadyTickle()
 				VideoManager()->Get3DManager()->Add(*m_roi);
 				VideoManager()->Get3DManager()->Moved(*m_roi);
 
-				if (m_compositePresenter != NULL && m_compositePresenter->IsA("LegoEntityPresenter")) {
+				if (m_compositePresenter != NULL && m_compositePresenter->IsA(LegoEntityPresenter::g_typeInfo)) {
 					((LegoEntityPresenter*) m_compositePresenter)->GetInternalEntity()->SetROI(m_roi, TRUE, TRUE);
 					((LegoEntityPresenter*) m_compositePresenter)
 						->GetInternalEntity()
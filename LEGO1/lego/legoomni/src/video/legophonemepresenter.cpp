@@ -1,5 +1,6 @@
 #include "legophonemepresenter.h"
 
+#include "legoanimmmpresenter.h"
 #include "legocharactermanager.h"
 #include "legovideomanager.h"
 #include "misc.h"
@@ -47,7 +48,7 @@ void LegoPhonemePresenter::StartingTickle()
 
 			LegoROI *entityROI, *head;
 
-			if (m_compositePresenter != NULL && m_compositePresenter->IsA("LegoAnimMMPresenter")) {
+			if (m_compositePresenter != NULL && m_compositePresenter->IsA(LegoAnimMMPresenter::g_typeInfo)) {
 				entityROI = FindROI(m_roiName.GetData());
 				m_unk0x84 = TRUE;
 			}
@@ -1138,7 +1138,7 @@ MxLong Infocenter::HandleNotification0(MxNotificationParam& p_param)
 			PlayAction(InfomainScript::c_iic043in_RunAnim);
 		}
 	}
-	else if (sender->IsA("MxEntity") && m_infocenterState->m_unk0x74 != 5 && m_infocenterState->m_unk0x74 != 12) {
+	else if (sender->IsA(MxEntity::g_typeInfo) && m_infocenterState->m_unk0x74 != 5 && m_infocenterState->m_unk0x74 != 12) {
 		switch (((MxEntity*) sender)->GetEntityId()) {
 		case 5: {
 			m_infoManDialogueTimer = 0;
@@ -1180,7 +1180,7 @@ MxLong Infocenter::HandleNotification0(MxNotificationParam& p_param)
 		}
 	}
 	else {
-		if (sender->IsA("Radio") && m_radio.GetState()->IsActive()) {
+		if (sender->IsA(Radio::g_typeInfo) && m_radio.GetState()->IsActive()) {
 			if (m_currentInfomainScript == InfomainScript::c_Mama_All_Movie ||
 				m_currentInfomainScript == InfomainScript::c_Papa_All_Movie ||
 				m_currentInfomainScript == InfomainScript::c_Pepper_All_Movie ||
@@ -1449,8 +1449,9 @@ void Infocenter::StartCredits()
 		MxCore* object = *it;
 		m_set0xa8.erase(it);
 
-		if (object->IsA("MxPresenter")) {
+		if (object->IsA(MxPresenter::g_typeInfo)) {
 			presenter = (MxPresenter*) object;
+			IndexRemove(presenter, e_indexSet0xa8);
 			MxDSAction* action = presenter->GetAction();
 
 			if (action) {
@@ -1467,6 +1468,7 @@ void Infocenter::StartCredits()
 
 	while (cursor.First(presenter)) {
 		cursor.Detach();
+		IndexRemove(presenter, e_indexControlPresenter);
 
 		MxDSAction* action = presenter->GetAction();
 		if (action) {
@@ -576,7 +576,7 @@ void Isle::Enable(MxBool p_enable)
 			}
 		}
 
-		if (UserActor() != NULL && UserActor()->IsA("Jetski")) {
+		if (UserActor() != NULL && UserActor()->IsA(Jetski::g_typeInfo)) {
 			IslePathActor* actor = (IslePathActor*) UserActor();
 			actor->SpawnPlayer(
 				LegoGameState::e_unk45,
@@ -1106,40 +1106,40 @@ void Isle::Add(MxCore* p_object)
 {
 	LegoWorld::Add(p_object);
 
-	if (p_object->IsA("Pizza")) {
+	if (p_object->IsA(Pizza::g_typeInfo)) {
 		m_pizza = (Pizza*) p_object;
 	}
-	else if (p_object->IsA("Pizzeria")) {
+	else if (p_object->IsA(Pizzeria::g_typeInfo)) {
 		m_pizzeria = (Pizzeria*) p_object;
 	}
-	else if (p_object->IsA("TowTrack")) {
+	else if (p_object->IsA(TowTrack::g_typeInfo)) {
 		m_towtrack = (TowTrack*) p_object;
 	}
-	else if (p_object->IsA("Ambulance")) {
+	else if (p_object->IsA(Ambulance::g_typeInfo)) {
 		m_ambulance = (Ambulance*) p_object;
 	}
-	else if (p_object->IsA("JukeBoxEntity")) {
+	else if (p_object->IsA(JukeBoxEntity::g_typeInfo)) {
 		m_jukebox = (JukeBoxEntity*) p_object;
 	}
-	else if (p_object->IsA("Helicopter")) {
+	else if (p_object->IsA(Helicopter::g_typeInfo)) {
 		m_helicopter = (Helicopter*) p_object;
 	}
-	else if (p_object->IsA("Bike")) {
+	else if (p_object->IsA(Bike::g_typeInfo)) {
 		m_bike = (Bike*) p_object;
 	}
-	else if (p_object->IsA("DuneBuggy")) {
+	else if (p_object->IsA(DuneBuggy::g_typeInfo)) {
 		m_dunebuggy = (DuneBuggy*) p_object;
 	}
-	else if (p_object->IsA("Motorcycle")) {
+	else if (p_object->IsA(Motocycle::g_typeInfo)) {
 		m_motocycle = (Motocycle*) p_object;
 	}
-	else if (p_object->IsA("SkateBoard")) {
+	else if (p_object->IsA(SkateBoard::g_typeInfo)) {
 		m_skateboard = (SkateBoard*) p_object;
 	}
-	else if (p_object->IsA("Jetski")) {
+	else if (p_object->IsA(Jetski::g_typeInfo)) {
 		m_jetski = (Jetski*) p_object;
 	}
-	else if (p_object->IsA("RaceCar")) {
+	else if (p_object->IsA(RaceCar::g_typeInfo)) {
 		m_racecar = (RaceCar*) p_object;
 	}
 }
@@ -1149,16 +1149,16 @@ void Isle::VTable0x6c(LegoPathActor* p_actor)
 {
 	LegoWorld::Remove(p_actor);
 
-	if (p_actor->IsA("Helicopter")) {
+	if (p_actor->IsA(Helicopter::g_typeInfo)) {
 		m_helicopter = NULL;
 	}
-	else if (p_actor->IsA("DuneBuggy")) {
+	else if (p_actor->IsA(DuneBuggy::g_typeInfo)) {
 		m_dunebuggy = NULL;
 	}
-	else if (p_actor->IsA("Jetski")) {
+	else if (p_actor->IsA(Jetski::g_typeInfo)) {
 		m_jetski = NULL;
 	}
-	else if (p_actor->IsA("RaceCar")) {
+	else if (p_actor->IsA(RaceCar::g_typeInfo)) {
 		m_racecar = NULL;
 	}
 }
@@ -1203,13 +1203,13 @@ MxBool Isle::Escape()
 		}
 		break;
 	case 8:
-		if (UserActor() != NULL && !UserActor()->IsA("TowTrack")) {
+		if (UserActor() != NULL && !UserActor()->IsA(TowTrack::g_typeInfo)) {
 			m_towtrack->StopActions();
 			m_towtrack->FUN_1004dbe0();
 		}
 		break;
 	case 10:
-		if (UserActor() != NULL && !UserActor()->IsA("Ambulance")) {
+		if (UserActor() != NULL && !UserActor()->IsA(Ambulance::g_typeInfo)) {
 			m_ambulance->StopActions();
 			m_ambulance->FUN_10037250();
 		}
@@ -1250,14 +1250,14 @@ MxBool Isle::Escape()
 void Isle::FUN_10033350()
 {
 	if (m_act1state->m_unk0x018 == 10) {
-		if (UserActor() != NULL && !UserActor()->IsA("Ambulance")) {
+		if (UserActor() != NULL && !UserActor()->IsA(Ambulance::g_typeInfo)) {
 			m_ambulance->StopActions();
 			m_ambulance->FUN_10037250();
 		}
 	}
 
 	if (m_act1state->m_unk0x018 == 8) {
-		if (UserActor() != NULL && !UserActor()->IsA("TowTrack")) {
+		if (UserActor() != NULL && !UserActor()->IsA(TowTrack::g_typeInfo)) {
 			m_towtrack->StopActions();
 			m_towtrack->FUN_1004dbe0();
 		}
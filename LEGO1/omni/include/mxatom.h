@@ -15,6 +15,13 @@
 // Also: the increment/decrement methods suggest a custom type was used
 // for the combined key_value_pair, which doesn't seem possible with <map>.
 
+enum LookupMode {
+	e_exact = 0,
+	e_lowerCase,
+	e_upperCase,
+	e_lowerCase2,
+};
+
 // SIZE 0x14
 class MxAtom {
 public:
@@ -24,6 +31,8 @@ class MxAtom {
 	{
 		m_key = p_str;
 		m_value = 0;
+		m_hash = 0;
+		m_next = NULL;
 	}
 
 	void Inc();
@@ -38,24 +47,37 @@ class MxAtom {
 private:
 	MxString m_key; // 0x00
 	MxU16 m_value;  // 0x10
-};
 
-struct MxAtomCompare {
-	// FUNCTION: LEGO1 0x100ad120
-	// FUNCTION: BETA10 0x10123980
-	int operator()(MxAtom* const& p_val0, MxAtom* const& p_val1) const
-	{
-		return strcmp(p_val0->GetKey().GetData(), p_val1->GetKey().GetData()) > 0;
-	}
+	MxU32 m_hash;   // Of m_key
+	MxAtom* m_next; // Next atom in the same bucket of MxAtomSet
+
+	friend class MxAtomSet;
 };
 
-class MxAtomSet : public set<MxAtom*, MxAtomCompare> {};
+// [library:performance] Originally a set<MxAtom*> ordered by strcmp. Every lookup allocated
+// a temporary MxAtom, copying and case converting the string, just to search the set.
+// Atoms are now interned in a hash table that is searched with the string as given,
+// folding its case on the fly, so only adding a new atom allocates.
+class MxAtomSet {
+public:
+	MxAtomSet() : m_count(0) {}
+	~MxAtomSet();
 
-enum LookupMode {
-	e_exact = 0,
-	e_lowerCase,
-	e_upperCase,
-	e_lowerCase2,
+	// Returns the atom whose key is p_str in the case p_mode asks for, or NULL
+	MxAtom* Find(const char* p_str, LookupMode p_mode) const;
+
+	// Same as Find, but adds the atom when there is none yet
+	MxAtom* Intern(const char* p_str, LookupMode p_mode);
+
+	MxU32 GetCount() const { return m_count; }
+
+private:
+	static MxU32 Hash(const char* p_str, LookupMode p_mode);
+	static MxBool Matches(MxAtom* p_atom, const char* p_str, LookupMode p_mode);
+	void Grow();
+
+	vector<MxAtom*> m_buckets;
+	MxU32 m_count;
 };
 
 // SIZE 0x04
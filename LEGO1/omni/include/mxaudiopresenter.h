@@ -30,12 +30,13 @@ class MxAudioPresenter : public MxMediaPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000d290
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxAudioPresenter::ClassName()) || MxMediaPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxAudioPresenter", MxMediaPresenter::g_typeInfo};
+
 protected:
 	MxS32 m_volume; // 0x50
 };
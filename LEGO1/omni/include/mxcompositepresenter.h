@@ -32,12 +32,13 @@ class MxCompositePresenter : public MxPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x100b6220
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxCompositePresenter::ClassName()) || MxPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxCompositePresenter", MxPresenter::g_typeInfo};
+
 	MxResult StartAction(MxStreamController* p_controller, MxDSAction* p_action) override; // vtable+0x3c
 	void EndAction() override;                                                             // vtable+0x40
 	void SetTickleState(TickleState p_tickleState) override;                               // vtable+0x44
@@ -2,6 +2,7 @@
 #define MXCORE_H
 
 #include "compat.h"
+#include "mxtypeinfo.h"
 #include "mxtypes.h"
 
 #include <string.h>
@@ -29,15 +30,20 @@ class MxCore {
 		return "MxCore";
 	}
 
-	// FUNCTION: LEGO1 0x100140d0
-	// FUNCTION: BETA10 0x10012680
-	virtual MxBool IsA(const char* p_name) const // vtable+10
+	// [library:performance] Takes the vtable slot of the virtual IsA(const char*).
+	// Subclasses override it together with ClassName, see MxTypeInfo.
+	virtual const MxTypeInfo& GetTypeInfo() const // vtable+10
 	{
-		return !strcmp(p_name, MxCore::ClassName());
+		return g_typeInfo;
 	}
 
+	MxBool IsA(const char* p_name) const { return GetTypeInfo().IsA(p_name); }
+	MxBool IsA(const MxTypeInfo& p_type) const { return GetTypeInfo().IsA(p_type); }
+
 	MxU32 GetId() { return m_id; }
 
+	static constexpr MxTypeInfo g_typeInfo{"MxCore"};
+
 	// SYNTHETIC: LEGO1 0x100ae1c0
 	// SYNTHETIC: BETA10 0x1012c0d0
 	// MxCore::`scalar deleting destructor'
@@ -29,12 +29,13 @@ class MxDiskStreamController : public MxStreamController {
 		return "MxDiskStreamController";
 	}
 
-	// FUNCTION: LEGO1 0x100c7370
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDiskStreamController::ClassName()) || MxStreamController::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDiskStreamController", MxStreamController::g_typeInfo};
+
 	MxResult Open(const char* p_filename) override;       // vtable+0x14
 	MxResult VTable0x18(undefined4, undefined4) override; // vtable+0x18
 	MxResult VTable0x20(MxDSAction* p_action) override;   // vtable+0x20
@@ -37,12 +37,13 @@ class MxDiskStreamProvider : public MxStreamProvider {
 		return "MxDiskStreamProvider";
 	}
 
-	// FUNCTION: LEGO1 0x100d1170
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDiskStreamProvider::ClassName()) || MxStreamProvider::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDiskStreamProvider", MxStreamProvider::g_typeInfo};
+
 	MxResult WaitForWorkToComplete();
 	MxResult FUN_100d1780(MxDSStreamingAction* p_action);
 	void PerformWork();
@@ -57,6 +58,11 @@ class MxDiskStreamProvider : public MxStreamProvider {
 	MxU32* GetBufferForDWords() override;                               // vtable+0x28
 
 private:
+	void PerformRead(MxDSStreamingAction* p_action);
+	MxDSStreamingAction* PopNextRead(MxBool& p_throttled);
+	MxDSStreamingAction* PopReadAt(MxLong p_offset);
+	void WaitForBufferCount();
+
 	MxDiskStreamProviderThread m_thread; // 0x10
 	MxSemaphore m_busySemaphore;         // 0x2c
 	MxBool m_remainingWork;              // 0x34
@@ -41,13 +41,13 @@ class MxDSAction : public MxDSObject {
 		return "MxDSAction";
 	}
 
-	// FUNCTION: LEGO1 0x100ad990
-	// FUNCTION: BETA10 0x1012bd10
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSAction::ClassName()) || MxDSObject::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSAction", MxDSObject::g_typeInfo};
+
 	undefined4 VTable0x14() override;                            // vtable+0x14
 	MxU32 GetSizeOnDisk() override;                              // vtable+0x18
 	void Deserialize(MxU8*& p_source, MxS16 p_unk0x24) override; // vtable+0x1c
@@ -23,13 +23,13 @@ class MxDSAnim : public MxDSMediaAction {
 		return "MxDSAnim";
 	}
 
-	// FUNCTION: LEGO1 0x100c9070
-	// FUNCTION: BETA10 0x1015d8b0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSAnim::ClassName()) || MxDSMediaAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSAnim", MxDSMediaAction::g_typeInfo};
+
 	MxDSAction* Clone() override; // vtable+0x2c
 
 	// SYNTHETIC: LEGO1 0x100c9180
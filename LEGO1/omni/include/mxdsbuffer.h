@@ -9,6 +9,7 @@ class MxDSAction;
 class MxDSStreamingAction;
 class MxStreamChunk;
 class MxDSChunk;
+class MxDSChunkIndex;
 
 // VTABLE: LEGO1 0x100dcca0
 // VTABLE: BETA10 0x101c2898
@@ -91,6 +92,14 @@ class MxDSBuffer : public MxCore {
 
 	void SetUnk30(MxDSStreamingAction* p_unk0x30) { m_unk0x30 = p_unk0x30; }
 
+	// [library:filesystem] Once SkipToData reaches an indexed object, its chunks come from p_index
+	void SetChunkIndex(const MxDSChunkIndex* p_index)
+	{
+		m_chunkIndex = p_index;
+		m_chunkNext = 0;
+		m_chunkEnd = 0;
+	}
+
 	// SYNTHETIC: LEGO1 0x100c6510
 	// SYNTHETIC: BETA10 0x10158530
 	// MxDSBuffer::`scalar deleting destructor'
@@ -107,6 +116,10 @@ class MxDSBuffer : public MxCore {
 	MxU32 m_writeOffset;            // 0x28
 	MxU32 m_bytesRemaining;         // 0x2c
 	MxDSStreamingAction* m_unk0x30; // 0x30
+
+	const MxDSChunkIndex* m_chunkIndex;
+	MxU32 m_chunkNext; // Position in the run being read from m_chunkIndex
+	MxU32 m_chunkEnd;
 };
 
 #endif // MXDSBUFFER_H
@@ -28,13 +28,13 @@ class MxDSChunk : public MxCore {
 		return "MxDSChunk";
 	}
 
-	// FUNCTION: LEGO1 0x100be0d0
-	// FUNCTION: BETA10 0x10134520
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSChunk::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSChunk", MxCore::g_typeInfo};
+
 	static MxU32 GetHeaderSize();
 
 	// FUNCTION: BETA10 0x101641f0
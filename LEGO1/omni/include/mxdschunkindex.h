@@ -0,0 +1,37 @@
+#ifndef MXDSCHUNKINDEX_H
+#define MXDSCHUNKINDEX_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+// Playback order of the chunks in a whole SI file held in memory. ReadData produces the same order
+// by moving every chunk behind its object header; the index only records where the chunks are,
+// so the file can stay mapped and untouched. Only split chunks, which have to be joined, are copied.
+class MxDSChunkIndex {
+public:
+	MxDSChunkIndex() {}
+	~MxDSChunkIndex() { Clear(); }
+
+	void Build(MxU8* p_buffer, MxU32 p_size);
+	void Clear();
+
+	// Looks up the chunks following the object header at p_object as [p_begin, p_end)
+	MxBool FindRun(MxU8* p_object, MxU32& p_begin, MxU32& p_end) const;
+
+	MxU8* GetChunk(MxU32 p_index) const { return m_chunks[p_index]; }
+
+private:
+	struct Run {
+		MxU8* m_object;
+		MxU32 m_begin;
+		MxU32 m_end;
+	};
+
+	void AppendSplit(MxU8* p_chunk);
+
+	vector<Run> m_runs;       // Sorted by m_object
+	vector<MxU8*> m_chunks;   // Chunks of all runs, back to back
+	vector<MxU8*> m_combined; // Joined split chunks owned by the index
+};
+
+#endif // MXDSCHUNKINDEX_H
@@ -22,13 +22,13 @@ class MxDSEvent : public MxDSMediaAction {
 		return "MxDSEvent";
 	}
 
-	// FUNCTION: LEGO1 0x100c9670
-	// FUNCTION: BETA10 0x1015da30
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSEvent::ClassName()) || MxDSMediaAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSEvent", MxDSMediaAction::g_typeInfo};
+
 	MxDSAction* Clone() override; // vtable+0x2c
 
 	// SYNTHETIC: LEGO1 0x100c9780
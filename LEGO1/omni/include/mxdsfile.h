@@ -2,8 +2,10 @@
 #define MXDSFILE_H
 
 #include "lego1_export.h"
+#include "mxdsfileindex.h"
 #include "mxdssource.h"
 #include "mxio.h"
+#include "mxmappedfile.h"
 #include "mxstring.h"
 #include "mxtypes.h"
 
@@ -36,13 +38,13 @@ class MxDSFile : public MxDSSource {
 		return "MxDSFile";
 	}
 
-	// FUNCTION: LEGO1 0x100c0130
-	// FUNCTION: BETA10 0x10148de0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSFile::ClassName()) || MxDSSource::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSFile", MxDSSource::g_typeInfo};
+
 	MxResult Open(MxULong) override;                 // vtable+0x14
 	MxResult Close() override;                       // vtable+0x18
 	MxResult Read(unsigned char*, MxULong) override; // vtable+0x20
@@ -53,7 +55,15 @@ class MxDSFile : public MxDSSource {
 	// FUNCTION: BETA10 0x1015e110
 	void SetFileName(const char* p_filename) { m_filename = p_filename; }
 
-	MxS32 CalcFileSize() { return SDL_GetIOSize(m_io.m_file); }
+	MxS32 CalcFileSize() { return m_mapping.IsOpen() ? m_mapping.GetSize() : SDL_GetIOSize(m_io.m_file); }
+
+	// The whole file when it could be memory mapped, NULL when it is read through m_io
+	MxU8* GetMappedData() const { return m_mapping.GetData(); }
+
+	// Starts paging in a range that is about to be read, does nothing when the file is not mapped
+	void Prefetch(MxLong p_offset, MxLong p_size) { m_mapping.Prefetch(p_offset, p_size); }
+
+	void PrefetchObject(MxU32 p_objectId);
 
 	// SYNTHETIC: LEGO1 0x100c01e0
 	// SYNTHETIC: BETA10 0x10148e40
@@ -73,6 +83,7 @@ class MxDSFile : public MxDSSource {
 
 private:
 	MxResult ReadChunks();
+	MxResult ReadMappedChunks();
 
 	MxString m_filename;  // 0x14
 	MXIOINFO m_io;        // 0x24
@@ -81,6 +92,12 @@ class MxDSFile : public MxDSSource {
 	// If false, read chunks immediately on open, otherwise
 	// skip reading chunks until ReadChunks is explicitly called.
 	MxULong m_skipReadingChunks; // 0x78
+
+	// [library:filesystem] When set, Read, Seek and ReadChunks work on the mapping instead of m_io
+	MxMappedFile m_mapping;
+
+	// [library:filesystem] Loaded from <name>.six next to a mapped file, empty if there is none
+	MxDSFileIndex m_index;
 };
 
 #endif // MXDSFILE_H
@@ -0,0 +1,46 @@
+#ifndef MXDSFILEINDEX_H
+#define MXDSFILEINDEX_H
+
+#include "mxtypes.h"
+
+// Per object summary of an SI file, written next to it as <name>.six by tools/siindex.
+// It tells how far an object's data reaches without walking the RIFF structure.
+class MxDSFileIndex {
+public:
+	struct Object {
+		MxU32 m_offset;         // Same as the MxOf entry
+		MxU32 m_size;           // Bytes from m_offset through the object's last data chunk
+		MxU32 m_chunkCount;     // Data chunks in that span
+		MxU32 m_next;           // Object stored right after this one, or c_noObject
+		MxU32 m_firstDependent; // Objects streaming chunks inside the span, see GetDependent
+		MxU32 m_dependentCount;
+	};
+
+	enum {
+		c_noObject = 0xffffffff
+	};
+
+	MxDSFileIndex();
+	~MxDSFileIndex() { Clear(); }
+
+	// Fails when there is no index or it was written for a different version of the SI file
+	MxResult Load(const char* p_filename, MxU32 p_fileSize);
+	void Clear();
+
+	const Object* Find(MxU32 p_objectId) const
+	{
+		return p_objectId < m_objectCount && m_objects[p_objectId].m_size != 0 ? &m_objects[p_objectId] : NULL;
+	}
+	MxU32 GetDependent(const Object& p_object, MxU32 p_index) const
+	{
+		return m_dependents[p_object.m_firstDependent + p_index];
+	}
+
+private:
+	Object* m_objects;
+	MxU32 m_objectCount;
+	MxU32* m_dependents;
+	MxU32 m_dependentCount;
+};
+
+#endif // MXDSFILEINDEX_H
@@ -24,13 +24,13 @@ class MxDSMediaAction : public MxDSAction {
 		return "MxDSMediaAction";
 	}
 
-	// FUNCTION: LEGO1 0x100c8bf0
-	// FUNCTION: BETA10 0x1015c6a0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSMediaAction::ClassName()) || MxDSAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSMediaAction", MxDSAction::g_typeInfo};
+
 	// SYNTHETIC: LEGO1 0x100c8cd0
 	// SYNTHETIC: BETA10 0x1015d810
 	// MxDSMediaAction::`scalar deleting destructor'
@@ -24,13 +24,13 @@ class MxDSMultiAction : public MxDSAction {
 		return "MxDSMultiAction";
 	}
 
-	// FUNCTION: LEGO1 0x100c9f60
-	// FUNCTION: BETA10 0x1015b1b0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSMultiAction::ClassName()) || MxDSAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSMultiAction", MxDSAction::g_typeInfo};
+
 	undefined4 VTable0x14() override;                            // vtable+0x14
 	MxU32 GetSizeOnDisk() override;                              // vtable+0x18
 	void Deserialize(MxU8*& p_source, MxS16 p_unk0x24) override; // vtable+0x1c
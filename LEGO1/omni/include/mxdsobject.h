@@ -57,12 +57,12 @@ class MxDSObject : public MxCore {
 	// FUNCTION: BETA10 0x1012bdd0
 	const char* ClassName() const override { return "MxDSObject"; } // vtable+0x0c
 
-	// FUNCTION: LEGO1 0x100bf740
-	// FUNCTION: BETA10 0x1012bd70
-	MxBool IsA(const char* p_name) const override
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSObject::ClassName()) || MxCore::IsA(p_name);
-	} // vtable+0x10
+		return g_typeInfo;
+	}
+
+	static constexpr MxTypeInfo g_typeInfo{"MxDSObject", MxCore::g_typeInfo};
 
 	virtual undefined4 VTable0x14();                            // vtable+0x14
 	virtual MxU32 GetSizeOnDisk();                              // vtable+0x18
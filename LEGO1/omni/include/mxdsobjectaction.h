@@ -22,13 +22,13 @@ class MxDSObjectAction : public MxDSMediaAction {
 		return "MxDSObjectAction";
 	}
 
-	// FUNCTION: LEGO1 0x100c88f0
-	// FUNCTION: BETA10 0x1015c640
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSObjectAction::ClassName()) || MxDSMediaAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSObjectAction", MxDSMediaAction::g_typeInfo};
+
 	MxDSAction* Clone() override;                              // vtable+0x2c
 	virtual void CopyFrom(MxDSObjectAction& p_dsObjectAction); // vtable+0x44
 
@@ -23,13 +23,13 @@ class MxDSParallelAction : public MxDSMultiAction {
 		return "MxDSParallelAction";
 	}
 
-	// FUNCTION: LEGO1 0x100caf10
-	// FUNCTION: BETA10 0x1015b3c0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSParallelAction::ClassName()) || MxDSMultiAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSParallelAction", MxDSMultiAction::g_typeInfo};
+
 	MxLong GetDuration() override; // vtable+0x24
 
 	// FUNCTION: LEGO1 0x100caef0
@@ -25,13 +25,13 @@ class MxDSSelectAction : public MxDSParallelAction {
 		return "MxDSSelectAction";
 	}
 
-	// FUNCTION: LEGO1 0x100cb700
-	// FUNCTION: BETA10 0x1015b480
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSSelectAction::ClassName()) || MxDSParallelAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSSelectAction", MxDSParallelAction::g_typeInfo};
+
 	MxU32 GetSizeOnDisk() override;                              // vtable+0x18
 	void Deserialize(MxU8*& p_source, MxS16 p_unk0x24) override; // vtable+0x1c
 	MxDSAction* Clone() override;                                // vtable+0x2c
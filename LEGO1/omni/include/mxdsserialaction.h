@@ -24,13 +24,13 @@ class MxDSSerialAction : public MxDSMultiAction {
 		return "MxDSSerialAction";
 	}
 
-	// FUNCTION: LEGO1 0x100caae0
-	// FUNCTION: BETA10 0x1015b2d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSSerialAction::ClassName()) || MxDSMultiAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSSerialAction", MxDSMultiAction::g_typeInfo};
+
 	MxLong GetDuration() override;                // vtable+0x24
 	void SetDuration(MxLong p_duration) override; // vtable+0x28
 	MxDSAction* Clone() override;                 // vtable+0x2c
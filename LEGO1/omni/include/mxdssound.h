@@ -23,13 +23,13 @@ class MxDSSound : public MxDSMediaAction {
 		return "MxDSSound";
 	}
 
-	// FUNCTION: LEGO1 0x100c9340
-	// FUNCTION: BETA10 0x1015d970
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSSound::ClassName()) || MxDSMediaAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSSound", MxDSMediaAction::g_typeInfo};
+
 	MxU32 GetSizeOnDisk() override;                              // vtable+0x18
 	void Deserialize(MxU8*& p_source, MxS16 p_unk0x24) override; // vtable+0x1c
 	MxDSAction* Clone() override;                                // vtable+0x2c
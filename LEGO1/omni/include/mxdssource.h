@@ -24,12 +24,13 @@ class MxDSSource : public MxCore {
 		return "MxDSSource";
 	}
 
-	// FUNCTION: LEGO1 0x100c0020
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSSource::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSSource", MxCore::g_typeInfo};
+
 	virtual MxLong Open(MxULong) = 0; // vtable+0x14
 	virtual MxLong Close() = 0;       // vtable+0x18
 
@@ -23,13 +23,13 @@ class MxDSStill : public MxDSMediaAction {
 		return "MxDSStill";
 	}
 
-	// FUNCTION: LEGO1 0x100c9940
-	// FUNCTION: BETA10 0x1015daf0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSStill::ClassName()) || MxDSMediaAction::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSStill", MxDSMediaAction::g_typeInfo};
+
 	MxDSAction* Clone() override; // vtable+0x2c
 
 	// SYNTHETIC: LEGO1 0x100c9a50
@@ -32,12 +32,13 @@ class MxDSSubscriber : public MxCore {
 		return "MxDSSubscriber";
 	}
 
-	// FUNCTION: LEGO1 0x100b7d60
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxDSSubscriber::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxDSSubscriber", MxCore::g_typeInfo};
+
 	MxResult Create(MxStreamController* p_controller, MxU32 p_objectId, MxS16 p_unk0x48);
 	void DestroyData();
 	MxResult AddData(MxStreamChunk* p_chunk, MxBool p_append);
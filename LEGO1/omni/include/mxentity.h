@@ -26,13 +26,13 @@ class MxEntity : public MxCore {
 		return "MxEntity";
 	}
 
-	// FUNCTION: LEGO1 0x1000c190
-	// FUNCTION: BETA10 0x10012610
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxEntity::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxEntity", MxCore::g_typeInfo};
+
 	// FUNCTION: LEGO1 0x10001070
 	// FUNCTION: BETA10 0x1000f3a0
 	virtual MxResult Create(MxS32 p_entityId, const MxAtomId& p_atomId)
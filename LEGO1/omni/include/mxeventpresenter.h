@@ -25,12 +25,13 @@ class MxEventPresenter : public MxMediaPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x100c2c40
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxEventPresenter::ClassName()) || MxMediaPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxEventPresenter", MxMediaPresenter::g_typeInfo};
+
 	void ReadyTickle() override;                   // vtable+0x18
 	void StartingTickle() override;                // vtable+0x1c
 	MxResult AddToManager() override;              // vtable+0x34
@@ -14,12 +14,13 @@ class MxFlcPresenter : public MxVideoPresenter {
 	MxFlcPresenter();
 	~MxFlcPresenter() override;
 
-	// FUNCTION: LEGO1 0x1004e200
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxFlcPresenter::ClassName()) || MxVideoPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxFlcPresenter", MxVideoPresenter::g_typeInfo};
+
 	// FUNCTION: BETA10 0x10083790
 	static const char* HandlerClassName()
 	{
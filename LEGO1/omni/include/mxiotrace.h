@@ -0,0 +1,51 @@
+#ifndef MXIOTRACE_H
+#define MXIOTRACE_H
+
+#include "lego1_export.h"
+#include "mxtypes.h"
+
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_timer.h>
+
+// One MXIOINFO::Read call
+struct MxIOTraceEvent {
+	Sint64 m_offset;    // File offset the read started at
+	MxU32 m_size;       // Bytes requested
+	MxU32 m_bytesRead;  // Bytes returned
+	Uint64 m_time;      // Performance counter when the read started
+	MxU32 m_latency;    // Microseconds spent in the read
+	MxBool m_bufferHit; // Served from the MXIOINFO buffer without touching the file
+};
+
+// Opt-in trace of the most recent file reads. Recording is a few stores into a fixed ring,
+// so it can stay on in release builds; readers copy events out without blocking the writers.
+class MxIOTrace {
+public:
+	enum {
+		c_capacity = 4096 // Power of two
+	};
+
+	LEGO1_EXPORT static void Enable(MxBool p_enable);
+	static MxBool IsEnabled() { return SDL_AtomicGet(&g_enabled) != 0; }
+
+	static void Record(Sint64 p_offset, MxU32 p_size, MxU32 p_bytesRead, Uint64 p_start, MxBool p_bufferHit);
+
+	// Copies up to p_max of the most recent events into p_events, oldest first, and returns the count
+	LEGO1_EXPORT static MxU32 Snapshot(MxIOTraceEvent* p_events, MxU32 p_max);
+
+	// Logs every event still in the ring
+	LEGO1_EXPORT static void Dump();
+
+private:
+	// Each slot carries the sequence number of the event in it (index + 1, 0 while being written)
+	struct Slot {
+		SDL_atomic_t m_sequence;
+		MxIOTraceEvent m_event;
+	};
+
+	static SDL_atomic_t g_enabled;
+	static SDL_atomic_t g_head;
+	static Slot g_slots[c_capacity];
+};
+
+#endif // MXIOTRACE_H
@@ -0,0 +1,34 @@
+#ifndef MXMAPPEDFILE_H
+#define MXMAPPEDFILE_H
+
+#include "mxtypes.h"
+
+// Private mapping of a whole file. Reads become pointer arithmetic and the OS pages data in
+// on demand, which suits SI files: they never change and are read at random offsets.
+// Writes are copy-on-write, they only cost the pages they touch and never reach the file.
+class MxMappedFile {
+public:
+	MxMappedFile();
+	~MxMappedFile() { Close(); }
+
+	// Fails on platforms without memory mapping, callers are expected to fall back to MXIOINFO
+	MxResult Open(const char* p_filename);
+	void Close();
+
+	// Asks the OS to start reading the range in the background, so a later access does not block
+	void Prefetch(MxLong p_offset, MxLong p_size);
+
+	MxBool IsOpen() const { return m_data != NULL; }
+	MxU8* GetData() const { return m_data; }
+	MxLong GetSize() const { return m_size; }
+
+private:
+	MxU8* m_data;
+	MxLong m_size;
+#ifdef _WIN32
+	void* m_file;
+	void* m_mapping;
+#endif
+};
+
+#endif // MXMAPPEDFILE_H
@@ -35,12 +35,13 @@ class MxMediaPresenter : public MxPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000c5d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxMediaPresenter::ClassName()) || MxPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxMediaPresenter", MxPresenter::g_typeInfo};
+
 	void StreamingTickle() override; // vtable+0x20
 	void RepeatingTickle() override; // vtable+0x24
 	void DoneTickle() override;      // vtable+0x2c
@@ -2,10 +2,10 @@
 #define MXMEMORYPOOL_H
 
 #include "decomp.h"
-#include "mxbitset.h"
 #include "mxdebug.h"
 #include "mxtypes.h"
 
+#include <SDL2/SDL_atomic.h>
 #include <assert.h>
 
 template <size_t BS, size_t NB>
@@ -18,12 +18,26 @@ class MxMemoryPool {
 	MxU8* Get();
 	void Release(MxU8*);
 
-	MxU32 GetPoolSize() const { return m_blockRef.Size(); }
+	MxU32 GetPoolSize() const { return NB; }
+
+	MxU32 GetBusyCount() { return SDL_AtomicGet(&m_busy); }
+	MxU32 GetHighWaterMark() { return SDL_AtomicGet(&m_highWaterMark); }
+	MxU32 GetFailureCount() { return SDL_AtomicGet(&m_failures); } // Get calls that found no free block
 
 private:
-	MxU8* m_pool;            // 0x00
-	MxU32 m_blockSize;       // 0x04
-	MxBitset<NB> m_blockRef; // 0x08
+	MxU8* m_pool;      // 0x00
+	MxU32 m_blockSize; // 0x04
+
+	// [library:synchronization] Replaces MxBitset<NB> m_blockRef, which was scanned for a free bit
+	// and flipped from several threads without a lock. Free blocks now form a lock-free stack:
+	// the low 16 bits of m_head hold the top block index + 1 (0 when empty), the high 16 bits count
+	// pushes, so a Get racing with a Get and Release of the same block fails its compare-and-swap.
+	SDL_atomic_t m_head;
+	SDL_atomic_t m_next[NB]; // Block below each free block, index + 1
+	SDL_atomic_t m_used[NB]; // Catches blocks released twice
+	SDL_atomic_t m_busy;
+	SDL_atomic_t m_highWaterMark;
+	SDL_atomic_t m_failures;
 };
 
 template <size_t BS, size_t NB>
@@ -31,11 +45,21 @@ MxResult MxMemoryPool<BS, NB>::Allocate()
 {
 	assert(m_pool == NULL);
 	assert(m_blockSize);
-	assert(m_blockRef.Size());
+	assert(GetPoolSize() && GetPoolSize() < 0xffff);
 
 	m_pool = new MxU8[GetPoolSize() * m_blockSize * 1024];
 	assert(m_pool);
 
+	for (MxU32 i = 0; i < GetPoolSize(); i++) {
+		SDL_AtomicSet(&m_next[i], i + 1 < GetPoolSize() ? i + 2 : 0);
+		SDL_AtomicSet(&m_used[i], 0);
+	}
+
+	SDL_AtomicSet(&m_head, 1);
+	SDL_AtomicSet(&m_busy, 0);
+	SDL_AtomicSet(&m_highWaterMark, 0);
+	SDL_AtomicSet(&m_failures, 0);
+
 	return m_pool ? SUCCESS : FAILURE;
 }
 
@@ -44,19 +68,31 @@ MxU8* MxMemoryPool<BS, NB>::Get()
 {
 	assert(m_pool != NULL);
 	assert(m_blockSize);
-	assert(m_blockRef.Size());
-
-	for (MxU32 i = 0; i < GetPoolSize(); i++) {
-		if (!m_blockRef[i]) {
-			m_blockRef[i].Flip();
 
-			MxTrace("Get> %d pool: busy %d blocks\n", m_blockSize, m_blockRef.Count());
+	MxU32 head, top;
+	do {
+		head = SDL_AtomicGet(&m_head);
+		top = head & 0xffff;
 
-			return &m_pool[i * m_blockSize * 1024];
+		if (top == 0) {
+			SDL_AtomicAdd(&m_failures, 1);
+			MxTrace("Get> %d pool: no free block\n", m_blockSize);
+			return NULL;
 		}
-	}
+	} while (!SDL_AtomicCAS(&m_head, head, (head & ~0xffff) | SDL_AtomicGet(&m_next[top - 1])));
+
+	MxU32 i = top - 1;
+	SDL_AtomicSet(&m_used[i], 1);
+
+	MxU32 busy = SDL_AtomicAdd(&m_busy, 1) + 1;
+	MxU32 highWaterMark;
+	do {
+		highWaterMark = SDL_AtomicGet(&m_highWaterMark);
+	} while (busy > highWaterMark && !SDL_AtomicCAS(&m_highWaterMark, highWaterMark, busy));
 
-	return NULL;
+	MxTrace("Get> %d pool: busy %d blocks\n", m_blockSize, busy);
+
+	return &m_pool[i * m_blockSize * 1024];
 }
 
 template <size_t BS, size_t NB>
@@ -64,18 +100,26 @@ void MxMemoryPool<BS, NB>::Release(MxU8* p_buf)
 {
 	assert(m_pool != NULL);
 	assert(m_blockSize);
-	assert(m_blockRef.Size());
 
 	MxU32 i = (MxU32) (p_buf - m_pool) / (m_blockSize * 1024);
 
 	assert(i >= 0 && i < GetPoolSize());
-	assert(m_blockRef[i]);
 
-	if (m_blockRef[i]) {
-		m_blockRef[i].Flip();
+	if (!SDL_AtomicCAS(&m_used[i], 1, 0)) {
+		assert("Block released twice" == NULL);
+		return;
 	}
 
-	MxTrace("Release> %d pool: busy %d blocks\n", m_blockSize, m_blockRef.Count());
+	// Counted out before the block is back on the stack, so m_busy never exceeds the pool size
+	MxU32 busy = SDL_AtomicAdd(&m_busy, -1) - 1;
+
+	MxU32 head;
+	do {
+		head = SDL_AtomicGet(&m_head);
+		SDL_AtomicSet(&m_next[i], head & 0xffff);
+	} while (!SDL_AtomicCAS(&m_head, head, ((head + 0x10000) & ~0xffff) | (i + 1)));
+
+	MxTrace("Release> %d pool: busy %d blocks\n", m_blockSize, busy);
 }
 
 // TEMPLATE: BETA10 0x101464a0
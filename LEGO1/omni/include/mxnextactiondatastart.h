@@ -24,12 +24,13 @@ class MxNextActionDataStart : public MxCore {
 		return "MxNextActionDataStart";
 	}
 
-	// FUNCTION: LEGO1 0x100c1910
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxNextActionDataStart::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxNextActionDataStart", MxCore::g_typeInfo};
+
 	MxU32 GetObjectId() const { return m_objectId; }
 	MxS16 GetUnknown24() const { return m_unk0x24; }
 	MxU32 GetData() const { return m_data; }
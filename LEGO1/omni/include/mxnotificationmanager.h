@@ -16,23 +16,49 @@ class MxNotification {
 	MxCore* GetTarget() { return m_target; }
 	MxNotificationParam* GetParam() { return m_param; }
 
+	// [library:performance] Allocated for every notification sent
+	static void* operator new(size_t p_size);
+	static void operator delete(void* p_ptr, size_t p_size);
+
 private:
 	MxCore* m_target;             // 0x00
 	MxNotificationParam* m_param; // 0x04
 };
 
-class MxIdList : public list<MxU32> {};
+// Open addressing hash set of MxCore ids
+class MxIdSet {
+public:
+	MxIdSet() : m_slots(NULL), m_numSlots(0), m_count(0) {}
+	~MxIdSet() { delete[] m_slots; }
+
+	MxBool Find(MxU32 p_id) const;
+	void Insert(MxU32 p_id);
+	MxBool Erase(MxU32 p_id);
+
+	MxU32 GetCount() const { return m_count; }
+
+private:
+	MxU32 Slot(MxU32 p_id) const { return (p_id * 2654435769u) & (m_numSlots - 1); }
+	void Grow();
+
+	MxU32* m_slots; // Id plus one, zero for a free slot
+	MxU32 m_numSlots;
+	MxU32 m_count;
+};
 
-class MxNotificationPtrList : public list<MxNotification*> {};
+class MxNotificationPtrList : public vector<MxNotification*> {};
 
 // VTABLE: LEGO1 0x100dc078
 class MxNotificationManager : public MxCore {
 private:
+	// [library:performance] The queues used to be lists, with a new one allocated on every tickle.
+	// They are now vectors that trade places, so their storage is reused from one tickle to the next.
+	// m_listenerIds was a list searched on every send.
 	MxNotificationPtrList* m_queue;    // 0x08
 	MxNotificationPtrList* m_sendList; // 0x0c
 	MxCriticalSection m_lock;          // 0x10
 	MxS32 m_unk0x2c;                   // 0x2c
-	MxIdList m_listenerIds;            // 0x30
+	MxIdSet m_listenerIds;             // 0x30
 	MxBool m_active;                   // 0x3c
 
 public:
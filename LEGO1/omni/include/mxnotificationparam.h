@@ -2,6 +2,7 @@
 #define MXNOTIFICATIONPARAM_H
 
 #include "compat.h"
+#include "lego1_export.h"
 #include "mxparam.h"
 #include "mxtypes.h"
 
@@ -49,6 +50,11 @@ class MxNotificationParam : public MxParam {
 	// FUNCTION: BETA10 0x100135f0
 	virtual MxNotificationParam* Clone() const { return new MxNotificationParam(m_type, m_sender); } // vtable+0x04
 
+	// [library:performance] Every notification sent is cloned into the queue, take those from slabs.
+	// The size operator delete is given is that of the dynamic type, so this covers every subclass.
+	LEGO1_EXPORT static void* operator new(size_t p_size);
+	LEGO1_EXPORT static void operator delete(void* p_ptr, size_t p_size);
+
 	// FUNCTION: BETA10 0x100135c0
 	NotificationId GetNotification() const { return m_type; }
 
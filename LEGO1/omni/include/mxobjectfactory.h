@@ -30,12 +30,13 @@ class MxObjectFactory : public MxCore {
 		return "MxObjectFactory";
 	}
 
-	// FUNCTION: LEGO1 0x10008f80
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxObjectFactory::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxObjectFactory", MxCore::g_typeInfo};
+
 	virtual MxCore* Create(const char* p_name); // vtable+0x14
 	virtual void Destroy(MxCore* p_object);     // vtable+0x18
 
@@ -4,6 +4,7 @@
 #include "lego1_export.h"
 #include "mxcore.h"
 #include "mxcriticalsection.h"
+#include "mxpathindex.h"
 #include "mxstl/stlcompat.h"
 #include "mxstring.h"
 
@@ -43,8 +44,8 @@ class MxOmni : public MxCore {
 	LEGO1_EXPORT static void SetCD(const char* p_cd);
 	LEGO1_EXPORT static void SetHD(const char* p_hd);
 	LEGO1_EXPORT static void SetSound3D(MxBool p_use3dSound);
-	static vector<MxString>& GetHDFiles() { return g_hdFiles; }
-	static vector<MxString>& GetCDFiles() { return g_cdFiles; }
+	static MxPathIndex& GetHDFiles() { return g_hdFiles; }
+	static MxPathIndex& GetCDFiles() { return g_cdFiles; }
 
 	MxOmni();
 	~MxOmni() override;
@@ -107,10 +108,10 @@ class MxOmni : public MxCore {
 
 protected:
 	static MxOmni* g_instance;
-	static vector<MxString> g_hdFiles;
-	static vector<MxString> g_cdFiles;
+	static MxPathIndex g_hdFiles;
+	static MxPathIndex g_cdFiles;
 
-	static vector<MxString> GlobIsleFiles(const MxString& p_path);
+	static void GlobIsleFiles(const MxString& p_path, MxPathIndex& p_files);
 
 	MxString m_mediaPath;                         // 0x08
 	HWND m_windowHandle;                          // 0x18
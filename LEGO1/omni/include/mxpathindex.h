@@ -0,0 +1,40 @@
+#ifndef MXPATHINDEX_H
+#define MXPATHINDEX_H
+
+#include "mxstl/stlcompat.h"
+#include "mxstring.h"
+#include "mxtypes.h"
+
+#include <stddef.h>
+
+// [library:filesystem] Game files found under a search path, hashed by their case folded file name.
+// Resolve finds the file whose relative path is a case insensitive suffix of a game path, like a scan
+// of the whole list in order would, but only compares files sharing the path's name and never allocates.
+class MxPathIndex {
+public:
+	MxPathIndex() {}
+
+	void Add(const char* p_file);
+	void Clear();
+
+	// Replaces the matching end of p_path with the file's spelling on disk
+	MxBool Resolve(char* p_path, size_t p_length) const;
+
+	MxU32 GetCount() const { return m_files.size(); }
+
+private:
+	static MxU32 Hash(const char* p_name, size_t p_length);
+	static const char* GetName(const char* p_path, size_t p_length);
+	static MxBool IsSuffix(const char* p_path, size_t p_length, const MxString& p_file);
+
+	void Link(MxS32 p_index);
+	void Grow();
+
+	vector<MxString> m_files; // In the order they were added, earlier files win
+	vector<MxU32> m_hashes;   // Of the last component of each file
+	vector<MxS32> m_next;     // Next file in the same bucket, or -1
+	vector<MxS32> m_buckets;  // First file in each bucket, or -1
+	vector<MxS32> m_loose;    // Files without a directory, which can also match part of a name
+};
+
+#endif // MXPATHINDEX_H
@@ -118,12 +118,13 @@ class MxPresenter : public MxCore {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000bff0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxPresenter::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxPresenter", MxCore::g_typeInfo};
+
 	MxEntity* CreateEntity(const char* p_defaultName);
 	void SendToCompositePresenter(MxOmni* p_omni);
 	MxBool IsEnabled();
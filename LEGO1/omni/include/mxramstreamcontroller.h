@@ -21,13 +21,13 @@ class MxRAMStreamController : public MxStreamController {
 		return "MxRAMStreamController";
 	}
 
-	// FUNCTION: LEGO1 0x100b9440
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxRAMStreamController::ClassName()) ||
-			   !strcmp(p_name, MxStreamController::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxRAMStreamController", MxStreamController::g_typeInfo};
+
 	MxResult Open(const char* p_filename) override;
 	MxResult VTable0x20(MxDSAction* p_action) override;
 	MxResult VTable0x24(MxDSAction* p_action) override;
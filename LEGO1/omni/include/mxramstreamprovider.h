@@ -1,6 +1,7 @@
 #ifndef MXRAMSTREAMPROVIDER_H
 #define MXRAMSTREAMPROVIDER_H
 
+#include "mxdschunkindex.h"
 #include "mxstreamprovider.h"
 
 // VTABLE: LEGO1 0x100dd0d0
@@ -19,12 +20,13 @@ class MxRAMStreamProvider : public MxStreamProvider {
 		return "MxRAMStreamProvider";
 	}
 
-	// FUNCTION: LEGO1 0x100d0980
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxRAMStreamProvider::ClassName()) || MxStreamProvider::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxRAMStreamProvider", MxStreamProvider::g_typeInfo};
+
 	MxResult SetResourceToGet(MxStreamController* p_resource) override; // vtable+0x14
 	MxU32 GetFileSize() override;                                       // vtable+0x18
 	MxS32 GetStreamBuffersNum() override;                               // vtable+0x1c
@@ -32,6 +34,7 @@ class MxRAMStreamProvider : public MxStreamProvider {
 	MxU32* GetBufferForDWords() override;                               // vtable+0x28
 
 	MxU8* GetBufferOfFileSize() { return m_pBufferOfFileSize; }
+	const MxDSChunkIndex* GetChunkIndex() const { return &m_chunkIndex; }
 
 protected:
 	MxU32 m_bufferSize;        // 0x10
@@ -39,6 +42,10 @@ class MxRAMStreamProvider : public MxStreamProvider {
 	MxU8* m_pBufferOfFileSize; // 0x18
 	MxU32 m_lengthInDWords;    // 0x1c
 	MxU32* m_bufferForDWords;  // 0x20
+
+	// [library:filesystem] When the file could be mapped, m_pFile stays open and
+	// m_pBufferOfFileSize points into its mapping rather than owning a copy
+	MxDSChunkIndex m_chunkIndex;
 };
 
 // SYNTHETIC: LEGO1 0x100d0a30
@@ -0,0 +1,17 @@
+#ifndef MXSLABALLOCATOR_H
+#define MXSLABALLOCATOR_H
+
+#include "mxtypes.h"
+
+#include <stddef.h>
+
+// Free lists of small blocks, one per size class, carved out of larger slabs. Meant for objects that are
+// created and destroyed at a high rate, through a class specific operator new and delete.
+// Slabs are never given back, a size class only grows to the most blocks it had in use at once.
+class MxSlabAllocator {
+public:
+	static void* Allocate(size_t p_size);
+	static void Free(void* p_block, size_t p_size);
+};
+
+#endif // MXSLABALLOCATOR_H
@@ -26,12 +26,13 @@ class MxSmkPresenter : public MxVideoPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x100b3740
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxSmkPresenter::ClassName()) || MxVideoPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxSmkPresenter", MxVideoPresenter::g_typeInfo};
+
 	MxResult AddToManager() override;                 // vtable+0x34
 	void Destroy() override;                          // vtable+0x38
 	void LoadHeader(MxStreamChunk* p_chunk) override; // vtable+0x5c
@@ -27,12 +27,13 @@ class MxSoundPresenter : public MxAudioPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000d4b0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxSoundPresenter::ClassName()) || MxAudioPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxSoundPresenter", MxAudioPresenter::g_typeInfo};
+
 	MxResult AddToManager() override; // vtable+0x34
 
 	// SYNTHETIC: LEGO1 0x1000d5c0
@@ -30,12 +30,13 @@ class MxStillPresenter : public MxVideoPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x100435d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxStillPresenter::ClassName()) || MxVideoPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxStillPresenter", MxVideoPresenter::g_typeInfo};
+
 	void StartingTickle() override;                   // vtable+0x1c
 	void StreamingTickle() override;                  // vtable+0x20
 	void RepeatingTickle() override;                  // vtable+0x24
@@ -24,12 +24,13 @@ class MxStreamChunk : public MxDSChunk {
 		return "MxStreamChunk";
 	}
 
-	// FUNCTION: LEGO1 0x100b1ff0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxStreamChunk::ClassName()) || MxDSChunk::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxStreamChunk", MxDSChunk::g_typeInfo};
+
 	MxDSBuffer* GetBuffer() { return m_buffer; }
 
 	MxResult ReadChunk(MxDSBuffer* p_buffer, MxU8* p_chunkData);
@@ -37,12 +37,13 @@ class MxStreamController : public MxCore {
 		return "MxStreamController";
 	}
 
-	// FUNCTION: LEGO1 0x100c0f20
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxStreamController::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxStreamController", MxCore::g_typeInfo};
+
 	virtual MxResult Open(const char* p_filename); // vtable+0x14
 
 	// FUNCTION: LEGO1 0x100b9400
@@ -64,13 +64,13 @@ class MxStreamer : public MxCore {
 		return "MxStreamer";
 	}
 
-	// FUNCTION: LEGO1 0x100b9010
-	// FUNCTION: BETA10 0x10145f00
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxStreamer::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxStreamer", MxCore::g_typeInfo};
+
 	virtual MxResult Create(); // vtable+0x14
 
 	MxBool FUN_100b9b30(MxDSObject& p_dsObject);
@@ -116,6 +116,9 @@ class MxStreamer : public MxCore {
 		}
 	}
 
+	MxMemoryPool64& GetPool64() { return m_pool64; }
+	MxMemoryPool128& GetPool128() { return m_pool128; }
+
 private:
 	list<MxStreamController*> m_controllers; // 0x08
 	MxMemoryPool64 m_pool64;                 // 0x14
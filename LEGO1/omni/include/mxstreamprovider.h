@@ -22,12 +22,13 @@ class MxStreamProvider : public MxCore {
 		return "MxStreamProvider";
 	}
 
-	// FUNCTION: LEGO1 0x100d07f0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxStreamProvider::ClassName()) || MxCore::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxStreamProvider", MxCore::g_typeInfo};
+
 	// FUNCTION: LEGO1 0x100d07c0
 	virtual MxResult SetResourceToGet(MxStreamController* p_pLookup)
 	{
@@ -44,6 +45,9 @@ class MxStreamProvider : public MxCore {
 	virtual MxU32 GetLengthInDWords() = 0;   // vtable+0x24
 	virtual MxU32* GetBufferForDWords() = 0; // vtable+0x28
 
+	// [library:filesystem] NULL once a RAM provider has copied its file into memory
+	MxDSFile* GetFile() { return m_pFile; }
+
 protected:
 	MxStreamController* m_pLookup; // 0x08
 	MxDSFile* m_pFile;             // 0x0c
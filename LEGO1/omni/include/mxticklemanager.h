@@ -24,14 +24,26 @@ class MxTickleClient {
 
 	void SetFlags(MxU16 p_flags) { m_flags = p_flags; }
 
+	MxTime GetDueTime() const { return m_lastUpdateTime + m_interval; }
+
+	MxU32 GetSequence() const { return m_sequence; }
+	void SetSequence(MxU32 p_sequence) { m_sequence = p_sequence; }
+
+	MxS32 GetHeapIndex() const { return m_heapIndex; }
+	void SetHeapIndex(MxS32 p_heapIndex) { m_heapIndex = p_heapIndex; }
+
 private:
 	MxCore* m_client;        // 0x00
 	MxTime m_interval;       // 0x04
 	MxTime m_lastUpdateTime; // 0x08
 	MxU16 m_flags;           // 0x0c
+
+	MxU32 m_sequence;  // Registration order, the order due clients are ticked in
+	MxS32 m_heapIndex; // Position in MxTickleManager::m_clients, -1 while being ticked
 };
 
-typedef list<MxTickleClient*> MxTickleClientPtrList;
+typedef vector<MxTickleClient*> MxTickleClientPtrList;
+typedef map<MxCore*, MxTickleClient*> MxTickleClientMap;
 
 // VTABLE: LEGO1 0x100d86d8
 // VTABLE: BETA10 0x101bc9d0
@@ -39,7 +51,7 @@ typedef list<MxTickleClient*> MxTickleClientPtrList;
 class MxTickleManager : public MxCore {
 public:
 	// FUNCTION: BETA10 0x100937c0
-	MxTickleManager() {}
+	MxTickleManager() : m_nextSequence(0), m_lastTime(0) {}
 
 	~MxTickleManager() override;
 
@@ -54,7 +66,20 @@ class MxTickleManager : public MxCore {
 	// MxTickleManager::`scalar deleting destructor'
 
 private:
+	void HeapPush(MxTickleClient* p_client);
+	void HeapRemove(MxS32 p_index);
+	void HeapUpdate(MxS32 p_index);
+	MxBool HeapLess(MxS32 p_a, MxS32 p_b) const;
+	void HeapSwap(MxS32 p_a, MxS32 p_b);
+
+	// [library:performance] Originally a list walked in full on every tickle, with linear lookups.
+	// m_clients is now a min-heap on due time, so a tickle only touches clients that are due,
+	// and m_registry finds the entry of a client for the other calls.
 	MxTickleClientPtrList m_clients; // 0x08
+	MxTickleClientMap m_registry;
+	MxTickleClientPtrList m_due; // Clients being ticked, kept to reuse its storage
+	MxU32 m_nextSequence;
+	MxTime m_lastTime;
 
 	friend class DebugViewer;
 };
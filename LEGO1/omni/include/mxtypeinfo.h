@@ -0,0 +1,74 @@
+#ifndef MXTYPEINFO_H
+#define MXTYPEINFO_H
+
+#include "mxtypes.h"
+
+#include <string.h>
+
+// [library:performance] Compile time description of a class for MxCore::IsA.
+// Every class keeps the name and name hash of each class in its IsA chain, indexed by depth below MxCore.
+// Testing for an ancestor is then one integer comparison at the ancestor's depth, instead of
+// a virtual call and a strcmp for every class between the object's and the ancestor's.
+class MxTypeInfo {
+public:
+	enum {
+		e_maxDepth = 12
+	};
+
+	constexpr MxTypeInfo(const char* p_name) : m_depth(0), m_ids(), m_names()
+	{
+		m_ids[0] = Hash(p_name);
+		m_names[0] = p_name;
+	}
+
+	constexpr MxTypeInfo(const char* p_name, const MxTypeInfo& p_parent)
+		: m_depth(p_parent.m_depth + 1), m_ids(), m_names()
+	{
+		for (MxU32 i = 0; i < m_depth; i++) {
+			m_ids[i] = p_parent.m_ids[i];
+			m_names[i] = p_parent.m_names[i];
+		}
+
+		// Out of bounds for chains deeper than e_maxDepth, which fails the constant evaluation
+		m_ids[m_depth] = Hash(p_name);
+		m_names[m_depth] = p_name;
+	}
+
+	MxBool IsA(const MxTypeInfo& p_type) const
+	{
+		return p_type.m_depth <= m_depth && m_ids[p_type.m_depth] == p_type.m_ids[p_type.m_depth];
+	}
+
+	// For names only known at runtime, like the class names stored in SI files
+	MxBool IsA(const char* p_name) const
+	{
+		MxU32 id = Hash(p_name);
+
+		for (MxU32 i = 0; i <= m_depth; i++) {
+			if (m_ids[i] == id && !strcmp(m_names[i], p_name)) {
+				return TRUE;
+			}
+		}
+
+		return FALSE;
+	}
+
+	const char* GetName() const { return m_names[m_depth]; }
+
+	// FNV-1a
+	static constexpr MxU32 Hash(const char* p_name)
+	{
+		MxU32 hash = 2166136261u;
+		for (; *p_name; p_name++) {
+			hash = (hash ^ (MxU8) *p_name) * 16777619u;
+		}
+		return hash;
+	}
+
+private:
+	MxU32 m_depth;
+	MxU32 m_ids[e_maxDepth];
+	const char* m_names[e_maxDepth];
+};
+
+#endif // MXTYPEINFO_H
@@ -74,12 +74,13 @@ class MxVideoPresenter : public MxMediaPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000c830
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxVideoPresenter::ClassName()) || MxMediaPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxVideoPresenter", MxMediaPresenter::g_typeInfo};
+
 	void ReadyTickle() override;                 // vtable+0x18
 	void StartingTickle() override;              // vtable+0x1c
 	void StreamingTickle() override;             // vtable+0x20
@@ -37,12 +37,13 @@ class MxWavePresenter : public MxSoundPresenter {
 		return HandlerClassName();
 	}
 
-	// FUNCTION: LEGO1 0x1000d6d0
-	MxBool IsA(const char* p_name) const override // vtable+0x10
+	const MxTypeInfo& GetTypeInfo() const override // vtable+0x10
 	{
-		return !strcmp(p_name, MxWavePresenter::ClassName()) || MxSoundPresenter::IsA(p_name);
+		return g_typeInfo;
 	}
 
+	static constexpr MxTypeInfo g_typeInfo{"MxWavePresenter", MxSoundPresenter::g_typeInfo};
+
 	void ReadyTickle() override;                     // vtable+0x18
 	void StartingTickle() override;                  // vtable+0x1c
 	void StreamingTickle() override;                 // vtable+0x20
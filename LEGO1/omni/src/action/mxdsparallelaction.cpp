@@ -78,7 +78,7 @@ MxLong MxDSParallelAction::GetDuration()
 		}
 
 		duration += action->GetStartTime();
-		if (action->IsA("MxDSMediaAction")) {
+		if (action->IsA(MxDSMediaAction::g_typeInfo)) {
 			MxLong sustainTime = ((MxDSMediaAction*) action)->GetSustainTime();
 
 			if (sustainTime == -1) {
@@ -211,7 +211,7 @@ void MxSoundManager::Pause()
 	MxPresenterListCursor cursor(m_presenters);
 
 	while (cursor.Next(presenter)) {
-		if (presenter->IsA("MxWavePresenter")) {
+		if (presenter->IsA(MxWavePresenter::g_typeInfo)) {
 			((MxWavePresenter*) presenter)->Pause();
 		}
 	}
@@ -226,7 +226,7 @@ void MxSoundManager::Resume()
 	MxPresenterListCursor cursor(m_presenters);
 
 	while (cursor.Next(presenter)) {
-		if (presenter->IsA("MxWavePresenter")) {
+		if (presenter->IsA(MxWavePresenter::g_typeInfo)) {
 			((MxWavePresenter*) presenter)->Resume();
 		}
 	}
@@ -4,6 +4,7 @@
 #include "mxmisc.h"
 #include "mxomni.h"
 
+#include <SDL2/SDL_stdinc.h>
 #include <assert.h>
 
 DECOMP_SIZE_ASSERT(MxAtomId, 0x04);
@@ -50,19 +51,12 @@ void MxAtomId::Destroy()
 		return;
 	}
 
-#ifdef COMPAT_MODE
-	MxAtomSet::iterator it;
-	{
-		MxAtom idAtom(m_internal);
-		it = AtomSet()->find(&idAtom);
-	}
-#else
-	MxAtomSet::iterator it = AtomSet()->find(&MxAtom(m_internal));
-#endif
-	assert(it != AtomSet()->end());
+	MxAtom* atom = AtomSet()->Find(m_internal, e_exact);
+	assert(atom);
 
-	MxAtom* atom = (MxAtom*) (*it);
-	atom->Dec();
+	if (atom) {
+		atom->Dec();
+	}
 }
 
 // FUNCTION: LEGO1 0x100ad1c0
@@ -87,33 +81,8 @@ MxAtomId& MxAtomId::operator=(const MxAtomId& p_atomId)
 // FUNCTION: BETA10 0x10123378
 MxAtom* MxAtomId::GetAtom(const char* p_str, LookupMode p_mode)
 {
-	MxAtomId unused;
-	MxAtom* atom = new MxAtom(p_str);
+	MxAtom* atom = AtomSet()->Intern(p_str, p_mode);
 	assert(atom);
-
-	switch (p_mode) {
-	case e_exact:
-		break;
-	case e_upperCase:
-		atom->GetKey().ToUpperCase();
-		break;
-	case e_lowerCase:
-	case e_lowerCase2:
-		atom->GetKey().ToLowerCase();
-		break;
-	}
-
-	MxAtomSet::iterator it = AtomSet()->find(atom);
-	if (it != AtomSet()->end()) {
-		// Atom already in the set. Delete temp value and return it.
-		delete atom;
-		atom = *it;
-	}
-	else {
-		// Atom is not in the set. Add it.
-		AtomSet()->insert(atom);
-	}
-
 	return atom;
 }
 
@@ -141,3 +110,125 @@ void MxAtom::Dec()
 		m_value--;
 	}
 }
+
+// Applies the case conversion p_mode asks for to a single character, the same ToUpperCase
+// and ToLowerCase do to a whole string
+static inline char FoldCase(char p_char, LookupMode p_mode)
+{
+	switch (p_mode) {
+	case e_upperCase:
+		return SDL_toupper((unsigned char) p_char);
+	case e_lowerCase:
+	case e_lowerCase2:
+		return SDL_tolower((unsigned char) p_char);
+	default:
+		return p_char;
+	}
+}
+
+MxAtomSet::~MxAtomSet()
+{
+	for (MxU32 i = 0; i < m_buckets.size(); i++) {
+		MxAtom* next;
+		for (MxAtom* atom = m_buckets[i]; atom != NULL; atom = next) {
+			next = atom->m_next;
+			delete atom;
+		}
+	}
+}
+
+// FNV-1a of the case converted string
+MxU32 MxAtomSet::Hash(const char* p_str, LookupMode p_mode)
+{
+	MxU32 hash = 2166136261u;
+
+	for (; *p_str != '\0'; p_str++) {
+		hash ^= (MxU8) FoldCase(*p_str, p_mode);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+MxBool MxAtomSet::Matches(MxAtom* p_atom, const char* p_str, LookupMode p_mode)
+{
+	const char* key = p_atom->m_key.GetData();
+
+	for (; *p_str != '\0'; p_str++, key++) {
+		if (*key != FoldCase(*p_str, p_mode)) {
+			return FALSE;
+		}
+	}
+
+	return *key == '\0';
+}
+
+MxAtom* MxAtomSet::Find(const char* p_str, LookupMode p_mode) const
+{
+	if (m_count == 0) {
+		return NULL;
+	}
+
+	MxU32 hash = Hash(p_str, p_mode);
+
+	for (MxAtom* atom = m_buckets[hash & (m_buckets.size() - 1)]; atom != NULL; atom = atom->m_next) {
+		if (atom->m_hash == hash && Matches(atom, p_str, p_mode)) {
+			return atom;
+		}
+	}
+
+	return NULL;
+}
+
+MxAtom* MxAtomSet::Intern(const char* p_str, LookupMode p_mode)
+{
+	MxAtom* atom = Find(p_str, p_mode);
+	if (atom != NULL) {
+		return atom;
+	}
+
+	atom = new MxAtom(p_str);
+
+	switch (p_mode) {
+	case e_exact:
+		break;
+	case e_upperCase:
+		atom->GetKey().ToUpperCase();
+		break;
+	case e_lowerCase:
+	case e_lowerCase2:
+		atom->GetKey().ToLowerCase();
+		break;
+	}
+
+	if (m_count >= m_buckets.size()) {
+		Grow();
+	}
+
+	atom->m_hash = Hash(atom->m_key.GetData(), e_exact);
+
+	MxAtom*& bucket = m_buckets[atom->m_hash & (m_buckets.size() - 1)];
+	atom->m_next = bucket;
+	bucket = atom;
+	m_count++;
+
+	return atom;
+}
+
+void MxAtomSet::Grow()
+{
+	vector<MxAtom*> buckets(m_buckets.size() ? m_buckets.size() * 2 : 256, (MxAtom*) NULL);
+
+	for (MxU32 i = 0; i < m_buckets.size(); i++) {
+		MxAtom* next;
+		for (MxAtom* atom = m_buckets[i]; atom != NULL; atom = next) {
+			next = atom->m_next;
+
+			MxAtom*& bucket = buckets[atom->m_hash & (buckets.size() - 1)];
+			atom->m_next = bucket;
+			bucket = atom;
+		}
+	}
+
+	m_buckets.swap(buckets);
+}
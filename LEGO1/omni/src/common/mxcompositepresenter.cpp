@@ -4,6 +4,7 @@
 #include "mxactionnotificationparam.h"
 #include "mxautolock.h"
 #include "mxdsmultiaction.h"
+#include "mxdsserialaction.h"
 #include "mxmisc.h"
 #include "mxnotificationmanager.h"
 #include "mxobjectfactory.h"
@@ -167,7 +168,7 @@ void MxCompositePresenter::VTable0x58(MxEndActionNotificationParam& p_param)
 		EndAction();
 	}
 	else {
-		if (m_action->IsA("MxDSSerialAction") && it != m_list.end()) {
+		if (m_action->IsA(MxDSSerialAction::g_typeInfo) && it != m_list.end()) {
 			MxPresenter* presenter = *it;
 			if (presenter->GetCurrentTickleState() == e_idle) {
 				presenter->SetTickleState(e_ready);
@@ -201,7 +202,7 @@ void MxCompositePresenter::VTable0x5c(MxNotificationParam& p_param)
 					EndAction();
 				}
 				else {
-					if (m_action->IsA("MxDSSerialAction")) {
+					if (m_action->IsA(MxDSSerialAction::g_typeInfo)) {
 						MxPresenter* presenter = *it;
 						if (presenter->GetCurrentTickleState() == e_idle) {
 							presenter->SetTickleState(e_ready);
@@ -227,7 +228,7 @@ void MxCompositePresenter::VTable0x60(MxPresenter* p_presenter)
 					m_compositePresenter->VTable0x60(this);
 				}
 			}
-			else if (m_action->IsA("MxDSSerialAction")) {
+			else if (m_action->IsA(MxDSSerialAction::g_typeInfo)) {
 				MxPresenter* presenter = *it;
 				if (presenter->GetCurrentTickleState() == e_idle) {
 					presenter->SetTickleState(e_ready);
@@ -247,7 +248,7 @@ void MxCompositePresenter::SetTickleState(TickleState p_tickleState)
 		MxPresenter* presenter = *it;
 		presenter->SetTickleState(p_tickleState);
 
-		if (m_action->IsA("MxDSSerialAction") && p_tickleState == e_ready) {
+		if (m_action->IsA(MxDSSerialAction::g_typeInfo) && p_tickleState == e_ready) {
 			return;
 		}
 	}
@@ -0,0 +1,132 @@
+#include "mxpathindex.h"
+
+#include <SDL2/SDL_stdinc.h>
+#include <string.h>
+
+void MxPathIndex::Add(const char* p_file)
+{
+	MxS32 index = m_files.size();
+	size_t length = strlen(p_file);
+	const char* name = GetName(p_file, length);
+
+	m_files.push_back(MxString(p_file));
+	m_hashes.push_back(Hash(name, p_file + length - name));
+	m_next.push_back(-1);
+
+	if (name == p_file) {
+		m_loose.push_back(index);
+		return;
+	}
+
+	if (m_files.size() > m_buckets.size()) {
+		Grow();
+	}
+	else {
+		Link(index);
+	}
+}
+
+void MxPathIndex::Clear()
+{
+	m_files.clear();
+	m_hashes.clear();
+	m_next.clear();
+	m_buckets.clear();
+	m_loose.clear();
+}
+
+MxBool MxPathIndex::Resolve(char* p_path, size_t p_length) const
+{
+	MxS32 best = -1;
+
+	// A file that contains a directory can only match a path ending in the same name
+	if (!m_buckets.empty()) {
+		const char* name = GetName(p_path, p_length);
+		MxU32 hash = Hash(name, p_path + p_length - name);
+
+		for (MxS32 i = m_buckets[hash & (m_buckets.size() - 1)]; i != -1; i = m_next[i]) {
+			if (m_hashes[i] == hash && (best == -1 || i < best) && IsSuffix(p_path, p_length, m_files[i])) {
+				best = i;
+			}
+		}
+	}
+
+	for (MxU32 i = 0; i < m_loose.size(); i++) {
+		MxS32 index = m_loose[i];
+		if ((best == -1 || index < best) && IsSuffix(p_path, p_length, m_files[index])) {
+			best = index;
+		}
+	}
+
+	if (best == -1) {
+		return FALSE;
+	}
+
+	const MxString& file = m_files[best];
+	SDL_strlcpy(p_path + p_length - file.GetLength(), file.GetData(), file.GetLength() + 1);
+	return TRUE;
+}
+
+// FNV-1a over the lower case characters
+MxU32 MxPathIndex::Hash(const char* p_name, size_t p_length)
+{
+	MxU32 hash = 2166136261u;
+	for (size_t i = 0; i < p_length; i++) {
+		hash = (hash ^ (MxU8) SDL_tolower((MxU8) p_name[i])) * 16777619u;
+	}
+	return hash;
+}
+
+// Start of the last path component
+const char* MxPathIndex::GetName(const char* p_path, size_t p_length)
+{
+	const char* name = p_path + p_length;
+	while (name > p_path && name[-1] != '/') {
+		name--;
+	}
+	return name;
+}
+
+MxBool MxPathIndex::IsSuffix(const char* p_path, size_t p_length, const MxString& p_file)
+{
+	size_t length = p_file.GetLength();
+	if (length == 0 || length > p_length) {
+		return FALSE;
+	}
+
+	const char* tail = p_path + p_length - length;
+	for (size_t i = 0; i < length; i++) {
+		if (SDL_tolower((MxU8) tail[i]) != SDL_tolower((MxU8) p_file.GetData()[i])) {
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+void MxPathIndex::Link(MxS32 p_index)
+{
+	MxS32& bucket = m_buckets[m_hashes[p_index] & (m_buckets.size() - 1)];
+	m_next[p_index] = bucket;
+	bucket = p_index;
+}
+
+void MxPathIndex::Grow()
+{
+	MxU32 size = m_buckets.empty() ? 64 : m_buckets.size() * 2;
+	while (size < m_files.size()) {
+		size *= 2;
+	}
+
+	m_buckets.assign(size, -1);
+
+	MxU32 loose = 0;
+	for (MxS32 i = 0; i < (MxS32) m_files.size(); i++) {
+		if (loose < m_loose.size() && m_loose[loose] == i) {
+			loose++;
+		}
+		else {
+			Link(i);
+		}
+	}
+}
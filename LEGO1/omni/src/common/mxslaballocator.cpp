@@ -0,0 +1,69 @@
+#include "mxslaballocator.h"
+
+#include <SDL2/SDL_atomic.h>
+#include <new>
+#include <stdlib.h>
+
+#define SLAB_GRANULARITY 8
+#define SLAB_NUM_CLASSES 8
+#define SLAB_NUM_BLOCKS 64
+
+struct MxSlabBlock {
+	MxSlabBlock* m_next;
+};
+
+static SDL_SpinLock g_slabLocks[SLAB_NUM_CLASSES];
+static MxSlabBlock* g_slabFreeLists[SLAB_NUM_CLASSES];
+
+void* MxSlabAllocator::Allocate(size_t p_size)
+{
+	MxU32 sizeClass = (p_size + SLAB_GRANULARITY - 1) / SLAB_GRANULARITY - 1;
+	if (p_size == 0 || sizeClass >= SLAB_NUM_CLASSES) {
+		return ::operator new(p_size);
+	}
+
+	SDL_AtomicLock(&g_slabLocks[sizeClass]);
+
+	MxSlabBlock* block = g_slabFreeLists[sizeClass];
+	if (block == NULL) {
+		size_t blockSize = (sizeClass + 1) * SLAB_GRANULARITY;
+		MxU8* slab = (MxU8*) malloc(blockSize * SLAB_NUM_BLOCKS);
+
+		if (slab == NULL) {
+			SDL_AtomicUnlock(&g_slabLocks[sizeClass]);
+			return ::operator new(blockSize);
+		}
+
+		for (MxU32 i = 0; i < SLAB_NUM_BLOCKS; i++) {
+			MxSlabBlock* next = i + 1 < SLAB_NUM_BLOCKS ? (MxSlabBlock*) (slab + (i + 1) * blockSize) : NULL;
+			((MxSlabBlock*) (slab + i * blockSize))->m_next = next;
+		}
+
+		block = (MxSlabBlock*) slab;
+	}
+
+	g_slabFreeLists[sizeClass] = block->m_next;
+	SDL_AtomicUnlock(&g_slabLocks[sizeClass]);
+	return block;
+}
+
+void MxSlabAllocator::Free(void* p_block, size_t p_size)
+{
+	if (p_block == NULL) {
+		return;
+	}
+
+	MxU32 sizeClass = (p_size + SLAB_GRANULARITY - 1) / SLAB_GRANULARITY - 1;
+	if (p_size == 0 || sizeClass >= SLAB_NUM_CLASSES) {
+		::operator delete(p_block);
+		return;
+	}
+
+	// A block that came from ::operator new because malloc failed joins the free list like any other
+	MxSlabBlock* block = (MxSlabBlock*) p_block;
+
+	SDL_AtomicLock(&g_slabLocks[sizeClass]);
+	block->m_next = g_slabFreeLists[sizeClass];
+	g_slabFreeLists[sizeClass] = block;
+	SDL_AtomicUnlock(&g_slabLocks[sizeClass]);
+}
@@ -3,7 +3,6 @@
 #include "decomp.h"
 #include "mxomni.h"
 
-#include <SDL2/SDL_log.h>
 // #include <SDL2/SDL_platform_defines.h>
 #include <SDL2/SDL_stdinc.h>
 #include <stdlib.h>
@@ -205,29 +204,10 @@ void MxString::MapPathToFilesystem(char* p_path)
 		path++;
 	}
 
+	// Hashed lookups, they neither allocate nor log since every file open goes through here
 	size_t pathLen = SDL_strlen(p_path);
-
-	auto mapPath = [p_path, pathLen](const vector<MxString>& p_files) -> bool {
-		for (const MxString& file : p_files) {
-			// Test whether file is a suffix of the provided path (case insensitive)
-			// If yes, copy the original file system path into p_path.
-			for (size_t i = pathLen, j = file.GetLength(); i != 0 && j != 0; i--, j--) {
-				if (SDL_tolower(p_path[i - 1]) != SDL_tolower(file.GetData()[j - 1])) {
-					break;
-				}
-				else if (j == 1) {
-					SDL_strlcpy(&p_path[i - 1], file.GetData(), file.GetLength() + 1);
-					SDL_Log("Resolved file path to %s", p_path);
-					return true;
-				}
-			}
-		}
-
-		return false;
-	};
-
-	if (!mapPath(MxOmni::GetHDFiles())) {
-		mapPath(MxOmni::GetCDFiles());
+	if (!MxOmni::GetHDFiles().Resolve(p_path, pathLen)) {
+		MxOmni::GetCDFiles().Resolve(p_path, pathLen);
 	}
 #else
 	char* path = p_path;
@@ -5,6 +5,7 @@
 #include "mxtimer.h"
 #include "mxtypes.h"
 
+#include <algorithm>
 #include <assert.h>
 
 #define TICKLE_MANAGER_FLAG_DESTROY 0x01
@@ -19,44 +20,77 @@ MxTickleClient::MxTickleClient(MxCore* p_client, MxTime p_interval)
 	m_client = p_client;
 	m_interval = p_interval;
 	m_lastUpdateTime = -m_interval;
+	m_sequence = 0;
+	m_heapIndex = -1;
 }
 
 // FUNCTION: LEGO1 0x100bdd30
 MxTickleManager::~MxTickleManager()
 {
-	while (m_clients.size() != 0) {
-		MxTickleClient* client = m_clients.front();
-		m_clients.pop_front();
-		delete client;
+	for (MxU32 i = 0; i < m_clients.size(); i++) {
+		delete m_clients[i];
 	}
 }
 
+static bool TickledBefore(MxTickleClient* p_a, MxTickleClient* p_b)
+{
+	return p_a->GetSequence() < p_b->GetSequence();
+}
+
 // FUNCTION: LEGO1 0x100bdde0
 // FUNCTION: BETA10 0x1013eb1f
 MxResult MxTickleManager::Tickle()
 {
 	MxTime time = Timer()->GetTime();
-	MxTickleClientPtrList::iterator it;
 
-	for (it = m_clients.begin(); !(it == m_clients.end());) {
-		MxTickleClient* client = *it;
+	// The timer went back: clients last ticked after the current time start over,
+	// which the original did for each client it walked past
+	if (time < m_lastTime) {
+		m_due.swap(m_clients);
 
-		if ((MxBool) client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) {
-			m_clients.erase(it++);
-			delete client;
-		}
-		else {
-			it++;
+		for (MxU32 i = 0; i < m_due.size(); i++) {
+			MxTickleClient* client = m_due[i];
 
 			if (client->GetLastUpdateTime() > time) {
 				client->SetLastUpdateTime(-client->GetTickleInterval());
 			}
 
-			if ((client->GetTickleInterval() + client->GetLastUpdateTime()) < time) {
+			HeapPush(client);
+		}
+
+		m_due.clear();
+	}
+
+	m_lastTime = time;
+
+	// Due clients are ticked in registration order, as the original list walk did. Clients that become
+	// due while ticking, such as ones registered by another client, are ticked in a following round.
+	while (!m_clients.empty() && m_clients[0]->GetDueTime() < time) {
+		while (!m_clients.empty() && m_clients[0]->GetDueTime() < time) {
+			m_due.push_back(m_clients[0]);
+			HeapRemove(0);
+		}
+
+		std::sort(m_due.begin(), m_due.end(), TickledBefore);
+
+		for (MxU32 i = 0; i < m_due.size(); i++) {
+			MxTickleClient* client = m_due[i];
+
+			if (!(client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) && client->GetDueTime() < time) {
 				client->GetClient()->Tickle();
 				client->SetLastUpdateTime(time);
 			}
+
+			// Checked again, the client may have been unregistered while it was ticked
+			if (client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) {
+				delete client;
+			}
+			else {
+				HeapPush(client);
+			}
 		}
+
+		m_due.clear();
 	}
 
 	return SUCCESS;
@@ -70,7 +104,9 @@ void MxTickleManager::RegisterClient(MxCore* p_client, MxTime p_interval)
 	if (interval == TICKLE_MANAGER_NOT_FOUND) {
 		MxTickleClient* client = new MxTickleClient(p_client, p_interval);
 		if (client != NULL) {
-			m_clients.push_back(client);
+			client->SetSequence(m_nextSequence++);
+			m_registry[p_client] = client;
+			HeapPush(client);
 		}
 	}
 }
@@ -79,15 +115,17 @@ void MxTickleManager::RegisterClient(MxCore* p_client, MxTime p_interval)
 // FUNCTION: BETA10 0x1013edd0
 void MxTickleManager::UnregisterClient(MxCore* p_client)
 {
-	MxTickleClientPtrList::iterator it = m_clients.begin();
-	while (it != m_clients.end()) {
-		MxTickleClient* client = *it;
-		if (client->GetClient() == p_client) {
-			client->SetFlags(client->GetFlags() | TICKLE_MANAGER_FLAG_DESTROY);
-			return;
+	MxTickleClientMap::iterator it = m_registry.find(p_client);
+	if (it != m_registry.end()) {
+		MxTickleClient* client = it->second;
+		m_registry.erase(it);
+		client->SetFlags(client->GetFlags() | TICKLE_MANAGER_FLAG_DESTROY);
+
+		// A client that is being ticked right now is deleted by Tickle once its turn is over
+		if (client->GetHeapIndex() >= 0) {
+			HeapRemove(client->GetHeapIndex());
+			delete client;
 		}
-
-		it++;
 	}
 }
 
@@ -95,11 +133,13 @@ void MxTickleManager::UnregisterClient(MxCore* p_client)
 // FUNCTION: BETA10 0x1013ee6d
 void MxTickleManager::SetClientTickleInterval(MxCore* p_client, MxTime p_interval)
 {
-	for (MxTickleClientPtrList::iterator it = m_clients.begin(); it != m_clients.end(); it++) {
-		MxTickleClient* client = *it;
-		if ((client->GetClient() == p_client) && ((client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) == 0)) {
-			client->SetTickleInterval(p_interval);
-			return;
+	MxTickleClientMap::iterator it = m_registry.find(p_client);
+	if (it != m_registry.end()) {
+		MxTickleClient* client = it->second;
+		client->SetTickleInterval(p_interval);
+
+		if (client->GetHeapIndex() >= 0) {
+			HeapUpdate(client->GetHeapIndex());
 		}
 	}
 }
@@ -108,15 +148,86 @@ void MxTickleManager::SetClientTickleInterval(MxCore* p_client, MxTime p_interva
 // FUNCTION: BETA10 0x1013ef2d
 MxTime MxTickleManager::GetClientTickleInterval(MxCore* p_client)
 {
-	MxTickleClientPtrList::iterator it = m_clients.begin();
-	while (it != m_clients.end()) {
-		MxTickleClient* client = *it;
-		if ((client->GetClient() == p_client) && ((client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) == 0)) {
-			return client->GetTickleInterval();
-		}
-
-		it++;
+	MxTickleClientMap::iterator it = m_registry.find(p_client);
+	if (it != m_registry.end()) {
+		return it->second->GetTickleInterval();
 	}
 
 	return TICKLE_MANAGER_NOT_FOUND;
 }
+
+// Earlier due time first, registration order among clients due at the same time
+MxBool MxTickleManager::HeapLess(MxS32 p_a, MxS32 p_b) const
+{
+	MxTickleClient* a = m_clients[p_a];
+	MxTickleClient* b = m_clients[p_b];
+
+	if (a->GetDueTime() != b->GetDueTime()) {
+		return a->GetDueTime() < b->GetDueTime();
+	}
+
+	return a->GetSequence() < b->GetSequence();
+}
+
+void MxTickleManager::HeapSwap(MxS32 p_a, MxS32 p_b)
+{
+	MxTickleClient* client = m_clients[p_a];
+	m_clients[p_a] = m_clients[p_b];
+	m_clients[p_b] = client;
+
+	m_clients[p_a]->SetHeapIndex(p_a);
+	m_clients[p_b]->SetHeapIndex(p_b);
+}
+
+void MxTickleManager::HeapPush(MxTickleClient* p_client)
+{
+	p_client->SetHeapIndex(m_clients.size());
+	m_clients.push_back(p_client);
+	HeapUpdate(p_client->GetHeapIndex());
+}
+
+void MxTickleManager::HeapRemove(MxS32 p_index)
+{
+	MxS32 last = m_clients.size() - 1;
+
+	m_clients[p_index]->SetHeapIndex(-1);
+	if (p_index != last) {
+		m_clients[p_index] = m_clients[last];
+		m_clients[p_index]->SetHeapIndex(p_index);
+	}
+
+	m_clients.pop_back();
+
+	if (p_index < (MxS32) m_clients.size()) {
+		HeapUpdate(p_index);
+	}
+}
+
+// Moves the entry at p_index up or down until the heap order holds again
+void MxTickleManager::HeapUpdate(MxS32 p_index)
+{
+	while (p_index > 0 && HeapLess(p_index, (p_index - 1) / 2)) {
+		HeapSwap(p_index, (p_index - 1) / 2);
+		p_index = (p_index - 1) / 2;
+	}
+
+	MxS32 size = m_clients.size();
+	while (TRUE) {
+		MxS32 smallest = p_index;
+		MxS32 left = p_index * 2 + 1;
+		MxS32 right = left + 1;
+
+		if (left < size && HeapLess(left, smallest)) {
+			smallest = left;
+		}
+		if (right < size && HeapLess(right, smallest)) {
+			smallest = right;
+		}
+		if (smallest == p_index) {
+			break;
+		}
+
+		HeapSwap(p_index, smallest);
+		p_index = smallest;
+	}
+}
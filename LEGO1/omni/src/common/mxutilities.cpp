@@ -125,7 +125,7 @@ MxBool KeyValueStringParse(char* p_output, const char* p_command, const char* p_
 MxBool ContainsPresenter(MxCompositePresenterList& p_presenterList, MxPresenter* p_presenter)
 {
 	for (MxCompositePresenterList::iterator it = p_presenterList.begin(); it != p_presenterList.end(); it++) {
-		if (p_presenter == *it || ((*it)->IsA("MxCompositePresenter") &&
+		if (p_presenter == *it || ((*it)->IsA(MxCompositePresenter::g_typeInfo) &&
 								   ContainsPresenter(*((MxCompositePresenter*) *it)->GetList(), p_presenter))) {
 			return TRUE;
 		}
@@ -167,7 +167,7 @@ void FUN_100b7220(MxDSAction* p_action, MxU32 p_newFlags, MxBool p_setFlags)
 
 	p_action->SetFlags(newFlags);
 
-	if (p_action->IsA("MxDSMultiAction")) {
+	if (p_action->IsA(MxDSMultiAction::g_typeInfo)) {
 		MxDSActionListCursor cursor(((MxDSMultiAction*) p_action)->GetActionList());
 		MxDSAction* action;
 
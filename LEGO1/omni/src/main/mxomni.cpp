@@ -33,8 +33,8 @@ MxBool g_use3dSound = FALSE;
 // GLOBAL: LEGO1 0x101015b0
 MxOmni* MxOmni::g_instance = NULL;
 
-vector<MxString> MxOmni::g_hdFiles;
-vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdFiles;
+MxPathIndex MxOmni::g_cdFiles;
 
 // FUNCTION: LEGO1 0x100aef10
 MxOmni::MxOmni()
@@ -208,17 +208,8 @@ void MxOmni::Destroy()
 	delete m_notificationManager;
 	delete m_tickleManager;
 
-	if (m_atomSet) {
-		while (m_atomSet->size() != 0) {
-			// Pop each node and delete its value
-			MxAtomSet::iterator begin = m_atomSet->begin();
-			MxAtom* value = *begin;
-			m_atomSet->erase(begin);
-			delete value;
-		}
-
-		delete m_atomSet;
-	}
+	// The set deletes the atoms it holds
+	delete m_atomSet;
 
 	Init();
 }
@@ -308,7 +299,7 @@ MxBool MxOmni::ActionSourceEquals(MxDSAction* p_action, const char* p_name)
 		return TRUE;
 	}
 
-	if (p_action->IsA("MxDSMultiAction")) {
+	if (p_action->IsA(MxDSMultiAction::g_typeInfo)) {
 		MxDSActionListCursor cursor(((MxDSMultiAction*) p_action)->GetActionList());
 		MxDSAction* action;
 
@@ -370,7 +361,7 @@ const char* MxOmni::GetHD()
 void MxOmni::SetHD(const char* p_hd)
 {
 	g_hdPath = p_hd;
-	g_hdFiles = GlobIsleFiles(g_hdPath);
+	GlobIsleFiles(g_hdPath, g_hdFiles);
 }
 
 // FUNCTION: LEGO1 0x100b0940
@@ -383,7 +374,7 @@ const char* MxOmni::GetCD()
 void MxOmni::SetCD(const char* p_cd)
 {
 	g_cdPath = p_cd;
-	g_cdFiles = GlobIsleFiles(g_cdPath);
+	GlobIsleFiles(g_cdPath, g_cdFiles);
 }
 
 // FUNCTION: LEGO1 0x100b0980
@@ -431,26 +422,25 @@ void MxOmni::Resume()
 	}
 }
 
-vector<MxString> MxOmni::GlobIsleFiles(const MxString& p_path)
+void MxOmni::GlobIsleFiles(const MxString& p_path, MxPathIndex& p_files)
 {
 	//assert(false);
 	int count;
 	char** files = SDL_GlobDirectory(p_path.GetData(), NULL, 0, &count);
-	vector<MxString> result;
+	p_files.Clear();
 
 	if (files == NULL) {
 		SDL_Log("Error enumerating files for path %s (%s)", p_path.GetData(), SDL_GetError());
-		return result;
+		return;
 	}
 
 	for (int i = 0; i < count; i++) {
 		if (!SDL_strncasecmp(files[i], "lego", 4)) {
-			result.emplace_back(files[i]);
+			p_files.Add(files[i]);
 		}
 	}
 
 	SDL_Log("Found %d game files in %s", count, p_path.GetData());
 
 	SDL_free(files);
-	return result;
 }
@@ -6,9 +6,12 @@
 #include "mxmisc.h"
 #include "mxnotificationparam.h"
 #include "mxparam.h"
+#include "mxslaballocator.h"
 #include "mxticklemanager.h"
 #include "mxtypes.h"
 
+#include <string.h>
+
 DECOMP_SIZE_ASSERT(MxNotification, 0x08);
 DECOMP_SIZE_ASSERT(MxNotificationManager, 0x40);
 
@@ -25,6 +28,106 @@ MxNotification::~MxNotification()
 	delete m_param;
 }
 
+void* MxNotification::operator new(size_t p_size)
+{
+	return MxSlabAllocator::Allocate(p_size);
+}
+
+void MxNotification::operator delete(void* p_ptr, size_t p_size)
+{
+	MxSlabAllocator::Free(p_ptr, p_size);
+}
+
+MxBool MxIdSet::Find(MxU32 p_id) const
+{
+	if (m_count == 0) {
+		return FALSE;
+	}
+
+	for (MxU32 i = Slot(p_id); m_slots[i] != 0; i = (i + 1) & (m_numSlots - 1)) {
+		if (m_slots[i] == p_id + 1) {
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+void MxIdSet::Insert(MxU32 p_id)
+{
+	if (Find(p_id)) {
+		return;
+	}
+
+	// Keep at least half of the slots free so probe sequences stay short
+	if ((m_count + 1) * 2 > m_numSlots) {
+		Grow();
+	}
+
+	MxU32 i = Slot(p_id);
+	while (m_slots[i] != 0) {
+		i = (i + 1) & (m_numSlots - 1);
+	}
+
+	m_slots[i] = p_id + 1;
+	m_count++;
+}
+
+MxBool MxIdSet::Erase(MxU32 p_id)
+{
+	if (m_count == 0) {
+		return FALSE;
+	}
+
+	MxU32 i = Slot(p_id);
+	while (m_slots[i] != p_id + 1) {
+		if (m_slots[i] == 0) {
+			return FALSE;
+		}
+
+		i = (i + 1) & (m_numSlots - 1);
+	}
+
+	// Move later entries of the probe sequence back into the hole, which keeps every entry
+	// reachable from its home slot without leaving tombstones behind
+	MxU32 hole = i;
+	for (i = (i + 1) & (m_numSlots - 1); m_slots[i] != 0; i = (i + 1) & (m_numSlots - 1)) {
+		MxU32 home = Slot(m_slots[i] - 1);
+
+		if (((i - home) & (m_numSlots - 1)) >= ((i - hole) & (m_numSlots - 1))) {
+			m_slots[hole] = m_slots[i];
+			hole = i;
+		}
+	}
+
+	m_slots[hole] = 0;
+	m_count--;
+	return TRUE;
+}
+
+void MxIdSet::Grow()
+{
+	MxU32* oldSlots = m_slots;
+	MxU32 oldNumSlots = m_numSlots;
+
+	m_numSlots = m_numSlots ? m_numSlots * 2 : 64;
+	m_slots = new MxU32[m_numSlots];
+	memset(m_slots, 0, m_numSlots * sizeof(MxU32));
+
+	for (MxU32 i = 0; i < oldNumSlots; i++) {
+		if (oldSlots[i] != 0) {
+			MxU32 j = Slot(oldSlots[i] - 1);
+			while (m_slots[j] != 0) {
+				j = (j + 1) & (m_numSlots - 1);
+			}
+
+			m_slots[j] = oldSlots[i];
+		}
+	}
+
+	delete[] oldSlots;
+}
+
 // FUNCTION: LEGO1 0x100ac250
 // FUNCTION: BETA10 0x10125805
 MxNotificationManager::MxNotificationManager() : MxCore(), m_lock(), m_listenerIds()
@@ -42,6 +145,8 @@ MxNotificationManager::~MxNotificationManager()
 	Tickle();
 	delete m_queue;
 	m_queue = NULL;
+	delete m_sendList;
+	m_sendList = NULL;
 
 	TickleManager()->UnregisterClient(this);
 }
@@ -51,8 +156,9 @@ MxResult MxNotificationManager::Create(MxU32 p_frequencyMS, MxBool p_createThrea
 {
 	MxResult result = SUCCESS;
 	m_queue = new MxNotificationPtrList();
+	m_sendList = new MxNotificationPtrList();
 
-	if (m_queue == NULL) {
+	if (m_queue == NULL || m_sendList == NULL) {
 		result = FAILURE;
 	}
 	else {
@@ -72,8 +178,7 @@ MxResult MxNotificationManager::Send(MxCore* p_listener, const MxNotificationPar
 		return FAILURE;
 	}
 
-	MxIdList::iterator it = find(m_listenerIds.begin(), m_listenerIds.end(), p_listener->GetId());
-	if (it == m_listenerIds.end()) {
+	if (!m_listenerIds.Find(p_listener->GetId())) {
 		return FAILURE;
 	}
 
@@ -89,30 +194,39 @@ MxResult MxNotificationManager::Send(MxCore* p_listener, const MxNotificationPar
 // FUNCTION: LEGO1 0x100ac800
 MxResult MxNotificationManager::Tickle()
 {
-	m_sendList = new MxNotificationPtrList();
 	if (m_sendList == NULL) {
 		return FAILURE;
 	}
-	else {
-		{
-			AUTOLOCK(m_lock);
-			MxNotificationPtrList* temp1 = m_queue;
-			MxNotificationPtrList* temp2 = m_sendList;
-			m_queue = temp2;
-			m_sendList = temp1;
-		}
 
-		while (m_sendList->size() != 0) {
-			MxNotification* notif = m_sendList->front();
-			m_sendList->pop_front();
+	{
+		AUTOLOCK(m_lock);
+		MxNotificationPtrList* temp1 = m_queue;
+		MxNotificationPtrList* temp2 = m_sendList;
+		m_queue = temp2;
+		m_sendList = temp1;
+	}
+
+	// Entries are cleared as they are delivered, FlushPending clears the ones it delivers early.
+	// A listener may unregister from within Notify, so the list must not move while it is walked.
+	for (MxU32 i = 0; i < m_sendList->size(); i++) {
+		MxNotification* notif = (*m_sendList)[i];
+
+		if (notif != NULL) {
+			(*m_sendList)[i] = NULL;
 			notif->GetTarget()->Notify(*notif->GetParam());
 			delete notif;
 		}
-
-		delete m_sendList;
-		m_sendList = NULL;
-		return SUCCESS;
 	}
+
+	m_sendList->clear();
+	return SUCCESS;
+}
+
+// Whether p_notif is addressed to or sent by p_listener
+static MxBool Involves(MxNotification* p_notif, MxCore* p_listener)
+{
+	return p_notif->GetTarget()->GetId() == p_listener->GetId() ||
+		   (p_notif->GetParam()->GetSender() && p_notif->GetParam()->GetSender()->GetId() == p_listener->GetId());
 }
 
 // FUNCTION: LEGO1 0x100ac990
@@ -126,39 +240,33 @@ void MxNotificationManager::FlushPending(MxCore* p_listener)
 
 		// Find all notifications from, and addressed to, p_listener.
 		if (m_sendList != NULL) {
-			MxNotificationPtrList::iterator it = m_sendList->begin();
-			while (it != m_sendList->end()) {
-				notif = *it;
-				if (notif->GetTarget()->GetId() == p_listener->GetId() ||
-					(notif->GetParam()->GetSender() && notif->GetParam()->GetSender()->GetId() == p_listener->GetId()
-					)) {
-					m_sendList->erase(it++);
+			for (MxU32 i = 0; i < m_sendList->size(); i++) {
+				notif = (*m_sendList)[i];
+				if (notif != NULL && Involves(notif, p_listener)) {
+					(*m_sendList)[i] = NULL;
 					pending.push_back(notif);
 				}
-				else {
-					it++;
-				}
 			}
 		}
 
-		MxNotificationPtrList::iterator it = m_queue->begin();
-		while (it != m_queue->end()) {
-			notif = *it;
-			if (notif->GetTarget()->GetId() == p_listener->GetId() ||
-				(notif->GetParam()->GetSender() && notif->GetParam()->GetSender()->GetId() == p_listener->GetId())) {
-				m_queue->erase(it++);
+		// The queue is not being walked, it can be compacted
+		MxU32 kept = 0;
+		for (MxU32 i = 0; i < m_queue->size(); i++) {
+			notif = (*m_queue)[i];
+			if (Involves(notif, p_listener)) {
 				pending.push_back(notif);
 			}
 			else {
-				it++;
+				(*m_queue)[kept++] = notif;
 			}
 		}
+
+		m_queue->resize(kept);
 	}
 
 	// Deliver those notifications.
-	while (pending.size() != 0) {
-		notif = pending.front();
-		pending.pop_front();
+	for (MxU32 i = 0; i < pending.size(); i++) {
+		notif = pending[i];
 		notif->GetTarget()->Notify(*notif->GetParam());
 		delete notif;
 	}
@@ -169,12 +277,7 @@ void MxNotificationManager::Register(MxCore* p_listener)
 {
 	AUTOLOCK(m_lock);
 
-	MxIdList::iterator it = find(m_listenerIds.begin(), m_listenerIds.end(), p_listener->GetId());
-	if (it != m_listenerIds.end()) {
-		return;
-	}
-
-	m_listenerIds.push_back(p_listener->GetId());
+	m_listenerIds.Insert(p_listener->GetId());
 }
 
 // FUNCTION: LEGO1 0x100acdf0
@@ -183,10 +286,7 @@ void MxNotificationManager::Unregister(MxCore* p_listener)
 {
 	AUTOLOCK(m_lock);
 
-	MxIdList::iterator it = find(m_listenerIds.begin(), m_listenerIds.end(), p_listener->GetId());
-
-	if (it != m_listenerIds.end()) {
-		m_listenerIds.erase(it);
+	if (m_listenerIds.Erase(p_listener->GetId())) {
 		FlushPending(p_listener);
 	}
 }
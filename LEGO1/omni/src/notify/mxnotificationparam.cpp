@@ -1,5 +1,16 @@
 #include "mxnotificationparam.h"
 
 #include "decomp.h"
+#include "mxslaballocator.h"
 
 DECOMP_SIZE_ASSERT(MxNotificationParam, 0x0c);
+
+void* MxNotificationParam::operator new(size_t p_size)
+{
+	return MxSlabAllocator::Allocate(p_size);
+}
+
+void MxNotificationParam::operator delete(void* p_ptr, size_t p_size)
+{
+	MxSlabAllocator::Free(p_ptr, p_size);
+}
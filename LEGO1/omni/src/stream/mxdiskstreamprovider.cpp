@@ -11,12 +11,39 @@
 #include "mxstring.h"
 #include "mxthread.h"
 
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_mutex.h>
+
 DECOMP_SIZE_ASSERT(MxDiskStreamProviderThread, 0x1c)
 DECOMP_SIZE_ASSERT(MxDiskStreamProvider, 0x60);
 
 // GLOBAL: LEGO1 0x10102878
 MxU32 g_unk0x10102878 = 0;
 
+// [library:synchronization] Every change of g_unk0x10102878 is signalled, so a provider waiting for
+// it to drop wakes up right away instead of polling it every 500 ms
+static SDL_SpinLock g_bufferCountLock = 0;
+static SDL_mutex* g_bufferCountMutex = NULL;
+static SDL_cond* g_bufferCountChanged = NULL;
+
+static void InitBufferCount()
+{
+	SDL_AtomicLock(&g_bufferCountLock);
+	if (g_bufferCountMutex == NULL) {
+		g_bufferCountMutex = SDL_CreateMutex();
+		g_bufferCountChanged = SDL_CreateCond();
+	}
+	SDL_AtomicUnlock(&g_bufferCountLock);
+}
+
+static void ChangeBufferCount(MxS32 p_delta)
+{
+	SDL_LockMutex(g_bufferCountMutex);
+	g_unk0x10102878 += p_delta;
+	SDL_CondBroadcast(g_bufferCountChanged);
+	SDL_UnlockMutex(g_bufferCountMutex);
+}
+
 // FUNCTION: LEGO1 0x100d0f30
 MxResult MxDiskStreamProviderThread::Run()
 {
@@ -41,6 +68,7 @@ MxDiskStreamProvider::MxDiskStreamProvider()
 	m_pFile = NULL;
 	m_remainingWork = FALSE;
 	m_unk0x35 = FALSE;
+	InitBufferCount();
 }
 
 // FUNCTION: LEGO1 0x100d1240
@@ -62,7 +90,7 @@ MxDiskStreamProvider::~MxDiskStreamProvider()
 		}
 
 		if (((MxDSStreamingAction*) action)->GetUnknowna0()->GetWriteOffset() < 0x20000) {
-			g_unk0x10102878--;
+			ChangeBufferCount(-1);
 		}
 
 		((MxDiskStreamController*) m_pLookup)->FUN_100c8670((MxDSStreamingAction*) action);
@@ -70,6 +98,7 @@ MxDiskStreamProvider::~MxDiskStreamProvider()
 
 	if (m_remainingWork) {
 		m_remainingWork = FALSE;
+		ChangeBufferCount(0); // Wakes the thread if it is in WaitForBufferCount
 		m_busySemaphore.Release();
 		m_thread.Terminate();
 	}
@@ -134,7 +163,7 @@ void MxDiskStreamProvider::VTable0x20(MxDSAction* p_action)
 			}
 
 			if (((MxDSStreamingAction*) action)->GetUnknowna0()->GetWriteOffset() < 0x20000) {
-				g_unk0x10102878--;
+				ChangeBufferCount(-1);
 			}
 
 			((MxDiskStreamController*) m_pLookup)->FUN_100c8670((MxDSStreamingAction*) action);
@@ -152,7 +181,7 @@ void MxDiskStreamProvider::VTable0x20(MxDSAction* p_action)
 			}
 
 			if (((MxDSStreamingAction*) action)->GetUnknowna0()->GetWriteOffset() < 0x20000) {
-				g_unk0x10102878--;
+				ChangeBufferCount(-1);
 			}
 
 			((MxDiskStreamController*) m_pLookup)->FUN_100c8670((MxDSStreamingAction*) action);
@@ -196,7 +225,7 @@ MxResult MxDiskStreamProvider::FUN_100d1780(MxDSStreamingAction* p_action)
 	}
 
 	if (p_action->GetUnknowna0()->GetWriteOffset() < 0x20000) {
-		g_unk0x10102878++;
+		ChangeBufferCount(1);
 	}
 
 	{
@@ -204,6 +233,9 @@ MxResult MxDiskStreamProvider::FUN_100d1780(MxDSStreamingAction* p_action)
 		m_list.PushBack(p_action);
 	}
 
+	// [library:filesystem] Let the OS read the data in while earlier reads are being served
+	m_pFile->Prefetch(p_action->GetBufferOffset(), p_action->GetUnknowna0()->GetWriteOffset());
+
 	m_unk0x35 = TRUE;
 	m_busySemaphore.Release();
 	return SUCCESS;
@@ -212,54 +244,61 @@ MxResult MxDiskStreamProvider::FUN_100d1780(MxDSStreamingAction* p_action)
 // FUNCTION: LEGO1 0x100d18f0
 void MxDiskStreamProvider::PerformWork()
 {
-	MxDiskStreamController* controller = (MxDiskStreamController*) m_pLookup;
-	MxDSObject* streamingAction = NULL;
+	MxDSStreamingAction* streamingAction;
+	MxBool throttled;
 
+	// [library:synchronization] Rather than the oldest request, serve queued reads in file order,
+	// and wait for a change in buffer usage without holding m_criticalSection instead of sleeping 500 ms
 	{
 		AUTOLOCK(m_criticalSection);
-		if (!m_list.empty()) {
-			streamingAction = m_list.front();
+		streamingAction = PopNextRead(throttled);
+	}
 
-			if (streamingAction && !FUN_100d1af0((MxDSStreamingAction*) streamingAction)) {
-				m_thread.Sleep(500);
-				m_busySemaphore.Release();
-				return;
-			}
-		}
+	if (throttled) {
+		WaitForBufferCount();
+		m_busySemaphore.Release();
+		return;
 	}
 
-	MxDSBuffer* buffer;
+	while (streamingAction) {
+		PerformRead(streamingAction);
 
-	{
+		// Queued reads that continue where this one ended are served right away, without a seek
 		AUTOLOCK(m_criticalSection);
-
-		if (!m_list.PopFront(streamingAction)) {
-			goto done;
-		}
+		streamingAction = PopReadAt(m_pFile->GetPosition());
 	}
 
-	if (((MxDSStreamingAction*) streamingAction)->GetUnknowna0()->GetWriteOffset() < 0x20000) {
-		g_unk0x10102878--;
+	m_thread.Sleep(0);
+}
+
+void MxDiskStreamProvider::PerformRead(MxDSStreamingAction* p_action)
+{
+	MxDiskStreamController* controller = (MxDiskStreamController*) m_pLookup;
+	MxDSStreamingAction* streamingAction = p_action;
+	MxDSBuffer* buffer;
+
+	if (streamingAction->GetUnknowna0()->GetWriteOffset() < 0x20000) {
+		ChangeBufferCount(-1);
 	}
 
-	buffer = ((MxDSStreamingAction*) streamingAction)->GetUnknowna0();
+	buffer = streamingAction->GetUnknowna0();
 
-	if (m_pFile->GetPosition() == ((MxDSStreamingAction*) streamingAction)->GetBufferOffset() ||
-		m_pFile->Seek(((MxDSStreamingAction*) streamingAction)->GetBufferOffset(), SDL_IO_SEEK_SET) == 0) {
+	if (m_pFile->GetPosition() == streamingAction->GetBufferOffset() ||
+		m_pFile->Seek(streamingAction->GetBufferOffset(), SDL_IO_SEEK_SET) == 0) {
 		buffer->SetUnknown14(m_pFile->GetPosition());
 
 		if (m_pFile->ReadToBuffer(buffer) == SUCCESS) {
 			buffer->SetUnknown1c(m_pFile->GetPosition());
 
-			if (((MxDSStreamingAction*) streamingAction)->GetUnknown9c() > 0) {
-				FUN_100d1b20(((MxDSStreamingAction*) streamingAction));
+			if (streamingAction->GetUnknown9c() > 0) {
+				FUN_100d1b20(streamingAction);
 			}
 			else {
 				if (m_pLookup == NULL || !((MxDiskStreamController*) m_pLookup)->GetUnk0xc4()) {
-					controller->FUN_100c8670(((MxDSStreamingAction*) streamingAction));
+					controller->FUN_100c8670(streamingAction);
 				}
 				else {
-					controller->FUN_100c7f40(((MxDSStreamingAction*) streamingAction));
+					controller->FUN_100c7f40(streamingAction);
 				}
 			}
 
@@ -267,12 +306,79 @@ void MxDiskStreamProvider::PerformWork()
 		}
 	}
 
-done:
 	if (streamingAction) {
-		controller->FUN_100c8670(((MxDSStreamingAction*) streamingAction));
+		controller->FUN_100c8670(streamingAction);
 	}
+}
 
-	m_thread.Sleep(0);
+// Picks the queued read closest after the current file position, wrapping around to the lowest offset,
+// so streams interleaved in one file are read in forward sweeps. Reads that may not start yet
+// (see FUN_100d1af0) are skipped; p_throttled tells whether that left nothing to read.
+MxDSStreamingAction* MxDiskStreamProvider::PopNextRead(MxBool& p_throttled)
+{
+	MxU32 position = m_pFile->GetPosition();
+	MxDSObjectList::iterator next = m_list.end();
+	MxDSObjectList::iterator lowest = m_list.end();
+	MxU32 nextOffset = 0;
+	MxU32 lowestOffset = 0;
+
+	p_throttled = FALSE;
+
+	for (MxDSObjectList::iterator it = m_list.begin(); it != m_list.end(); it++) {
+		MxDSStreamingAction* action = (MxDSStreamingAction*) *it;
+
+		if (!FUN_100d1af0(action)) {
+			p_throttled = TRUE;
+			continue;
+		}
+
+		MxU32 offset = action->GetBufferOffset();
+		if (offset >= position && (next == m_list.end() || offset < nextOffset)) {
+			next = it;
+			nextOffset = offset;
+		}
+		if (lowest == m_list.end() || offset < lowestOffset) {
+			lowest = it;
+			lowestOffset = offset;
+		}
+	}
+
+	if (next == m_list.end()) {
+		next = lowest;
+	}
+
+	if (next == m_list.end()) {
+		return NULL;
+	}
+
+	MxDSStreamingAction* action = (MxDSStreamingAction*) *next;
+	m_list.erase(next);
+	p_throttled = FALSE;
+	return action;
+}
+
+MxDSStreamingAction* MxDiskStreamProvider::PopReadAt(MxLong p_offset)
+{
+	for (MxDSObjectList::iterator it = m_list.begin(); it != m_list.end(); it++) {
+		MxDSStreamingAction* action = (MxDSStreamingAction*) *it;
+
+		if ((MxLong) action->GetBufferOffset() == p_offset && FUN_100d1af0(action)) {
+			m_list.erase(it);
+			return action;
+		}
+	}
+
+	return NULL;
+}
+
+// Returns once g_unk0x10102878 changes, the provider shuts down, or after 500 ms at most
+void MxDiskStreamProvider::WaitForBufferCount()
+{
+	SDL_LockMutex(g_bufferCountMutex);
+	if (g_unk0x10102878 != 0 && m_remainingWork) {
+		SDL_CondWaitTimeout(g_bufferCountChanged, g_bufferCountMutex, 500);
+	}
+	SDL_UnlockMutex(g_bufferCountMutex);
 }
 
 // FUNCTION: LEGO1 0x100d1af0
@@ -2,6 +2,7 @@
 
 #include "mxdiskstreamcontroller.h"
 #include "mxdschunk.h"
+#include "mxdschunkindex.h"
 #include "mxdsstreamingaction.h"
 #include "mxmisc.h"
 #include "mxomni.h"
@@ -28,6 +29,9 @@ MxDSBuffer::MxDSBuffer()
 	m_bytesRemaining = 0;
 	m_mode = e_preallocated;
 	m_unk0x30 = 0;
+	m_chunkIndex = NULL;
+	m_chunkNext = 0;
+	m_chunkEnd = 0;
 }
 
 // FUNCTION: LEGO1 0x100c6530
@@ -354,6 +358,11 @@ MxU8* MxDSBuffer::SkipToData()
 {
 	MxU8* result = NULL;
 
+	if (m_chunkNext < m_chunkEnd) {
+		result = m_chunkIndex->GetChunk(m_chunkNext++);
+		goto done;
+	}
+
 	if (m_pIntoBuffer != NULL) {
 		while (TRUE) {
 			switch (UnalignedRead<MxU32>(m_pIntoBuffer)) {
@@ -368,6 +377,12 @@ MxU8* MxDSBuffer::SkipToData()
 					m_pIntoBuffer = NULL;
 				}
 
+				// [library:filesystem] The rest of an indexed object is read from the index, not the buffer
+				if (m_chunkIndex != NULL && UnalignedRead<MxU32>(result) == FOURCC('M', 'x', 'O', 'b') &&
+					m_chunkIndex->FindRun(result, m_chunkNext, m_chunkEnd)) {
+					m_pIntoBuffer = NULL;
+				}
+
 				goto done;
 			case FOURCC('M', 'x', 'D', 'a'):
 			case FOURCC('M', 'x', 'S', 't'):
@@ -456,6 +471,8 @@ void MxDSBuffer::FUN_100c6f80(MxU32 p_writeOffset)
 	if (p_writeOffset < m_writeOffset) {
 		m_pIntoBuffer2 = m_pBuffer + p_writeOffset;
 		m_pIntoBuffer = m_pBuffer + p_writeOffset;
+		m_chunkNext = 0;
+		m_chunkEnd = 0;
 	}
 }
 
@@ -0,0 +1,142 @@
+#include "mxdschunkindex.h"
+
+#include "mxdschunk.h"
+#include "mxstreamchunk.h"
+#include "mxutilities.h"
+
+#include <string.h>
+
+// Reads the id out of a serialized MxOb without deserializing the whole object
+static MxU32 ReadObjectId(MxU8* p_object)
+{
+	MxU8* data = p_object + 8 + sizeof(MxU16); // Chunk header, object type
+	data += strlen((char*) data) + 1;          // Source name
+	data += sizeof(undefined4);
+	data += strlen((char*) data) + 1; // Object name
+	return UnalignedRead<MxU32>(data);
+}
+
+// Same walk as ReadData, see there for the rules on which chunks belong to an object
+void MxDSChunkIndex::Build(MxU8* p_buffer, MxU32 p_size)
+{
+	Clear();
+
+	MxU8* end = p_buffer + p_size;
+	MxU8* data = p_buffer;
+	MxU8* last = NULL;
+
+	while (data < end) {
+		if (data + sizeof(MxU32) <= end && UnalignedRead<MxU32>(data) == FOURCC('M', 'x', 'O', 'b')) {
+			MxU32 id = ReadObjectId(data);
+
+			Run run;
+			run.m_object = data;
+			run.m_begin = m_chunks.size();
+
+			last = data;
+			data = MxDSChunk::End(data);
+			while (data + sizeof(MxU32) < end) {
+				if (UnalignedRead<MxU32>(data) == FOURCC('M', 'x', 'C', 'h')) {
+					MxU8* chunk = data;
+					data = MxDSChunk::End(chunk);
+
+					if ((UnalignedRead<MxU32>(last) == FOURCC('M', 'x', 'C', 'h')) &&
+						(*MxStreamChunk::IntoFlags(last) & DS_CHUNK_SPLIT)) {
+						if (*MxStreamChunk::IntoObjectId(last) == *MxStreamChunk::IntoObjectId(chunk) &&
+							(*MxStreamChunk::IntoFlags(chunk) & DS_CHUNK_SPLIT) &&
+							*MxStreamChunk::IntoTime(last) == *MxStreamChunk::IntoTime(chunk)) {
+							AppendSplit(chunk);
+							last = m_chunks.back();
+							continue;
+						}
+						else {
+							*MxStreamChunk::IntoFlags(last) &= ~DS_CHUNK_SPLIT;
+						}
+					}
+
+					m_chunks.push_back(chunk);
+					last = chunk;
+
+					if (UnalignedRead<MxU32>((MxU8*) MxStreamChunk::IntoObjectId(chunk)) == id &&
+						(*MxStreamChunk::IntoFlags(chunk) & DS_CHUNK_END_OF_STREAM)) {
+						break;
+					}
+				}
+				else {
+					data++;
+				}
+			}
+
+			run.m_end = m_chunks.size();
+			m_runs.push_back(run);
+		}
+		else {
+			data++;
+		}
+	}
+
+	if (last != NULL && UnalignedRead<MxU32>(last) == FOURCC('M', 'x', 'C', 'h')) {
+		*MxStreamChunk::IntoFlags(last) &= ~DS_CHUNK_SPLIT;
+	}
+}
+
+// Joins the payload of p_chunk onto the last chunk placed, like MxDSBuffer::Append does in place
+void MxDSChunkIndex::AppendSplit(MxU8* p_chunk)
+{
+	MxU8* last = m_chunks.back();
+	MxU32 length = UnalignedRead<MxU32>(last + 4);
+	MxU32 size = UnalignedRead<MxU32>(p_chunk + 4) - MxDSChunk::GetHeaderSize();
+
+	MxU8* combined = new MxU8[length + size + 8];
+	memcpy(combined, last, length + 8);
+	memcpy(combined + length + 8, p_chunk + MxDSChunk::GetHeaderSize() + 8, size);
+
+	// Stored little endian, like the rest of the file, since readers go through UnalignedRead
+	MxU32 stored = SDL_SwapLE32(length + size);
+	memcpy(combined + 4, &stored, sizeof(stored));
+
+	if (!m_combined.empty() && m_combined.back() == last) {
+		delete[] last;
+		m_combined.back() = combined;
+	}
+	else {
+		m_combined.push_back(combined);
+	}
+
+	m_chunks.back() = combined;
+}
+
+void MxDSChunkIndex::Clear()
+{
+	for (MxU32 i = 0; i < m_combined.size(); i++) {
+		delete[] m_combined[i];
+	}
+
+	m_runs.clear();
+	m_chunks.clear();
+	m_combined.clear();
+}
+
+MxBool MxDSChunkIndex::FindRun(MxU8* p_object, MxU32& p_begin, MxU32& p_end) const
+{
+	MxU32 low = 0;
+	MxU32 high = m_runs.size();
+
+	while (low < high) {
+		MxU32 mid = (low + high) / 2;
+		if (m_runs[mid].m_object < p_object) {
+			low = mid + 1;
+		}
+		else {
+			high = mid;
+		}
+	}
+
+	if (low == m_runs.size() || m_runs[low].m_object != p_object) {
+		return FALSE;
+	}
+
+	p_begin = m_runs[low].m_begin;
+	p_end = m_runs[low].m_end;
+	return TRUE;
+}
@@ -2,6 +2,7 @@
 
 #include "decomp.h"
 #include "mxdebug.h"
+#include "mxutilities.h"
 
 #include <SDL2/SDL.h>
 #include <stdio.h>
@@ -28,15 +29,28 @@ MxResult MxDSFile::Open(MxULong p_uStyle)
 	MxResult result = -FAILURE; // Non-standard value of 1 here
 	memset(&m_io, 0, sizeof(MXIOINFO));
 
-	if (m_io.Open(m_filename.GetData(), p_uStyle) != 0) {
-		return -1;
+	// [library:filesystem] Map the file if the platform can, reading through MXIOINFO otherwise
+	if (m_mapping.Open(m_filename.GetData()) == SUCCESS) {
+		m_position = 0;
+
+		if (m_skipReadingChunks == 0) {
+			result = ReadMappedChunks();
+		}
+
+		MxString indexName = m_filename + "x";
+		m_index.Load(indexName.GetData(), m_mapping.GetSize());
 	}
+	else {
+		if (m_io.Open(m_filename.GetData(), p_uStyle) != 0) {
+			return -1;
+		}
 
-	m_io.SetBuffer(NULL, 0, 0);
-	m_position = 0;
+		m_io.SetBuffer(NULL, 0, 0);
+		m_position = 0;
 
-	if (m_skipReadingChunks == 0) {
-		result = ReadChunks();
+		if (m_skipReadingChunks == 0) {
+			result = ReadChunks();
+		}
 	}
 
 	if (result != SUCCESS) {
@@ -96,11 +110,106 @@ MxResult MxDSFile::ReadChunks()
 	return SUCCESS;
 }
 
+// Same as ReadChunks, walking the RIFF structure in the mapping instead of descending with m_io
+MxResult MxDSFile::ReadMappedChunks()
+{
+	MxU8* data = m_mapping.GetData();
+	MxLong size = m_mapping.GetSize();
+	char tempBuffer[80];
+
+	if (size < 12 || UnalignedRead<MxU32>(data) != FOURCC('R', 'I', 'F', 'F') ||
+		UnalignedRead<MxU32>(data + 8) != FOURCC('O', 'M', 'N', 'I')) {
+		MxTrace("Unable to find Streamer RIFF chunk in file: %s\n", m_filename.GetData());
+		return FAILURE;
+	}
+
+	MxLong end = Min<MxLong>(size, 8 + (MxLong) UnalignedRead<MxU32>(data + 4));
+	MxU8* header = NULL;
+	MxU8* offsets = NULL;
+	MxU32 offsetsSize = 0;
+
+	for (MxLong ofs = 12; ofs + 8 <= end && !(header && offsets);) {
+		MxU32 id = UnalignedRead<MxU32>(data + ofs);
+		MxU32 chunkSize = UnalignedRead<MxU32>(data + ofs + 4);
+		if (chunkSize > (MxU32) (end - ofs - 8)) {
+			break;
+		}
+
+		if (id == FOURCC('M', 'x', 'H', 'd') && chunkSize >= 12) {
+			header = data + ofs + 8;
+		}
+		else if (id == FOURCC('M', 'x', 'O', 'f') && chunkSize >= 4) {
+			offsets = data + ofs + 8;
+			offsetsSize = chunkSize;
+		}
+
+		ofs += 8 + chunkSize + (chunkSize & 1);
+	}
+
+	if (!header || !offsets) {
+		MxTrace("Unable to find Header chunk in file: %s\n", m_filename.GetData());
+		return FAILURE;
+	}
+
+	m_header.m_majorVersion = UnalignedRead<MxS16>(header);
+	m_header.m_minorVersion = UnalignedRead<MxS16>(header + 2);
+	m_header.m_bufferSize = UnalignedRead<MxU32>(header + 4);
+	m_header.m_streamBuffersNum = UnalignedRead<MxS16>(header + 8);
+	m_header.m_reserved = UnalignedRead<MxS16>(header + 10);
+
+	if ((m_header.m_majorVersion != SI_MAJOR_VERSION) || (m_header.m_minorVersion != SI_MINOR_VERSION)) {
+		sprintf(tempBuffer, "Wrong SI file version. %d.%d expected.", SI_MAJOR_VERSION, SI_MINOR_VERSION);
+		SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "LEGO® Island Error", tempBuffer, NULL);
+		return FAILURE;
+	}
+
+	m_lengthInDWords = UnalignedRead<MxU32>(offsets);
+	if (m_lengthInDWords > (offsetsSize - 4) / 4) {
+		MxTrace("Truncated offset table in file: %s\n", m_filename.GetData());
+		m_lengthInDWords = 0;
+		return FAILURE;
+	}
+
+	m_pBuffer = new MxU32[m_lengthInDWords];
+	for (MxULong i = 0; i < m_lengthInDWords; i++) {
+		m_pBuffer[i] = UnalignedRead<MxU32>(offsets + 4 + i * 4);
+	}
+	return SUCCESS;
+}
+
+// Pages in the data of an object that is about to start, along with the first buffer of the object
+// stored after it, which tends to be the next one started. Does nothing without an index.
+void MxDSFile::PrefetchObject(MxU32 p_objectId)
+{
+	const MxDSFileIndex::Object* object = m_index.Find(p_objectId);
+	if (object == NULL) {
+		return;
+	}
+
+	Prefetch(object->m_offset, object->m_size);
+
+	for (MxU32 i = 0; i < object->m_dependentCount; i++) {
+		const MxDSFileIndex::Object* dependent = m_index.Find(m_index.GetDependent(*object, i));
+
+		if (dependent != NULL &&
+			(dependent->m_offset < object->m_offset || dependent->m_offset >= object->m_offset + object->m_size)) {
+			Prefetch(dependent->m_offset, dependent->m_size);
+		}
+	}
+
+	const MxDSFileIndex::Object* next = m_index.Find(object->m_next);
+	if (next != NULL) {
+		Prefetch(next->m_offset, Min(next->m_size, m_header.m_bufferSize));
+	}
+}
+
 // FUNCTION: LEGO1 0x100cc740
 // FUNCTION: BETA10 0x1015ded2
 MxLong MxDSFile::Close()
 {
 	m_io.Close(0);
+	m_mapping.Close();
+	m_index.Clear();
 	m_position = -1;
 	memset(&m_header, 0, sizeof(m_header));
 	if (m_lengthInDWords != 0) {
@@ -116,6 +225,16 @@ MxLong MxDSFile::Close()
 // FUNCTION: BETA10 0x1015df50
 MxResult MxDSFile::Read(unsigned char* p_buf, MxULong p_nbytes)
 {
+	if (m_mapping.IsOpen()) {
+		if (m_position < 0 || p_nbytes > (MxULong) (m_mapping.GetSize() - m_position)) {
+			return FAILURE;
+		}
+
+		memcpy(p_buf, m_mapping.GetData() + m_position, p_nbytes);
+		m_position += p_nbytes;
+		return SUCCESS;
+	}
+
 	if (m_io.Read(p_buf, p_nbytes) != p_nbytes) {
 		return FAILURE;
 	}
@@ -128,6 +247,18 @@ MxResult MxDSFile::Read(unsigned char* p_buf, MxULong p_nbytes)
 // FUNCTION: BETA10 0x1015dfee
 MxResult MxDSFile::Seek(MxLong p_lOffset, SDL_IOWhence p_iOrigin)
 {
+	if (m_mapping.IsOpen()) {
+		MxLong base = p_iOrigin == SDL_IO_SEEK_SET ? 0 : p_iOrigin == SDL_IO_SEEK_CUR ? m_position : m_mapping.GetSize();
+		MxLong position = base + p_lOffset;
+		if (base < 0 || position < 0 || position > m_mapping.GetSize()) {
+			m_position = -1;
+			return FAILURE;
+		}
+
+		m_position = position;
+		return SUCCESS;
+	}
+
 	m_position = m_io.Seek(p_lOffset, p_iOrigin);
 	if (m_position == -1) {
 		return FAILURE;
@@ -0,0 +1,74 @@
+#include "mxdsfileindex.h"
+
+#include "mxmappedfile.h"
+#include "mxutilities.h"
+
+#define SIX_HEADER_SIZE 16
+#define SIX_OBJECT_SIZE 24
+
+MxDSFileIndex::MxDSFileIndex()
+{
+	m_objects = NULL;
+	m_objectCount = 0;
+	m_dependents = NULL;
+	m_dependentCount = 0;
+}
+
+MxResult MxDSFileIndex::Load(const char* p_filename, MxU32 p_fileSize)
+{
+	Clear();
+
+	MxMappedFile file;
+	if (file.Open(p_filename) != SUCCESS || file.GetSize() < SIX_HEADER_SIZE) {
+		return FAILURE;
+	}
+
+	MxU8* data = file.GetData();
+	MxU32 objectCount = UnalignedRead<MxU32>(data + 8);
+	MxU32 dependentCount = UnalignedRead<MxU32>(data + 12);
+
+	if (UnalignedRead<MxU32>(data) != FOURCC('S', 'I', 'X', '1') || UnalignedRead<MxU32>(data + 4) != p_fileSize ||
+		objectCount > (MxU32) (file.GetSize() - SIX_HEADER_SIZE) / SIX_OBJECT_SIZE ||
+		dependentCount > (MxU32) (file.GetSize() - SIX_HEADER_SIZE - objectCount * SIX_OBJECT_SIZE) / sizeof(MxU32)) {
+		return FAILURE;
+	}
+
+	m_objects = new Object[objectCount];
+	m_objectCount = objectCount;
+	m_dependents = new MxU32[dependentCount];
+	m_dependentCount = dependentCount;
+
+	MxU8* record = data + SIX_HEADER_SIZE;
+	for (MxU32 i = 0; i < objectCount; i++, record += SIX_OBJECT_SIZE) {
+		Object& object = m_objects[i];
+		object.m_offset = UnalignedRead<MxU32>(record);
+		object.m_size = UnalignedRead<MxU32>(record + 4);
+		object.m_chunkCount = UnalignedRead<MxU32>(record + 8);
+		object.m_next = UnalignedRead<MxU32>(record + 12);
+		object.m_firstDependent = UnalignedRead<MxU32>(record + 16);
+		object.m_dependentCount = UnalignedRead<MxU32>(record + 20);
+
+		if (object.m_firstDependent > dependentCount ||
+			object.m_dependentCount > dependentCount - object.m_firstDependent) {
+			Clear();
+			return FAILURE;
+		}
+	}
+
+	for (MxU32 i = 0; i < dependentCount; i++, record += sizeof(MxU32)) {
+		m_dependents[i] = UnalignedRead<MxU32>(record);
+	}
+
+	return SUCCESS;
+}
+
+void MxDSFileIndex::Clear()
+{
+	delete[] m_objects;
+	m_objects = NULL;
+	m_objectCount = 0;
+
+	delete[] m_dependents;
+	m_dependents = NULL;
+	m_dependentCount = 0;
+}
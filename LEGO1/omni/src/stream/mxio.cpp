@@ -1,6 +1,7 @@
 #include "mxio.h"
 
 #include "decomp.h"
+#include "mxiotrace.h"
 #include "mxstring.h"
 
 #include <assert.h>
@@ -140,7 +141,17 @@ MxLong MXIOINFO::Read(void* p_buf, MxLong p_len)
 {
 	Sint64 bytesRead = 0;
 
-	printf("MXIOINFO::Read %d bytes at %d\n", p_len, m_info.lDiskOffset);
+	MxBool trace = MxIOTrace::IsEnabled();
+	MxLong size = p_len;
+	MxBool bufferHit = TRUE;
+	Uint64 start = 0;
+	Sint64 offset = m_info.lDiskOffset;
+	if (trace) {
+		start = SDL_GetPerformanceCounter();
+		if (m_info.pchBuffer) {
+			offset = m_info.lBufOffset + (m_info.pchNext - m_info.pchBuffer);
+		}
+	}
 
 	if (m_info.pchBuffer) {
 
@@ -160,6 +171,7 @@ MxLong MXIOINFO::Read(void* p_buf, MxLong p_len)
 			}
 
 			if (p_len > 0) {
+				bufferHit = FALSE;
 				if (Advance(MMIO_READ)) {
 					break;
 				}
@@ -173,6 +185,7 @@ MxLong MXIOINFO::Read(void* p_buf, MxLong p_len)
 		}
 	}
 	else if (RAW_M_FILE && p_len > 0) {
+		bufferHit = FALSE;
 		bytesRead = SDL_ReadIO(M_FILE, p_buf, p_len);
 
 		if (SDL_GetIOStatus(M_FILE) == SDL_IO_STATUS_ERROR) {
@@ -184,6 +197,10 @@ MxLong MXIOINFO::Read(void* p_buf, MxLong p_len)
 		}
 	}
 
+	if (trace) {
+		MxIOTrace::Record(offset, size, bytesRead, start, bufferHit);
+	}
+
 	return bytesRead;
 }
 
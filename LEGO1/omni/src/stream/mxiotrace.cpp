@@ -0,0 +1,79 @@
+#include "mxiotrace.h"
+
+#include <SDL2/SDL_log.h>
+
+SDL_atomic_t MxIOTrace::g_enabled;
+SDL_atomic_t MxIOTrace::g_head;
+MxIOTrace::Slot MxIOTrace::g_slots[MxIOTrace::c_capacity];
+
+void MxIOTrace::Enable(MxBool p_enable)
+{
+	SDL_AtomicSet(&g_enabled, p_enable ? 1 : 0);
+}
+
+void MxIOTrace::Record(Sint64 p_offset, MxU32 p_size, MxU32 p_bytesRead, Uint64 p_start, MxBool p_bufferHit)
+{
+	Uint64 end = SDL_GetPerformanceCounter();
+
+	// Claim the next slot; a writer lapping a slow one simply overwrites the older event
+	MxU32 index = (MxU32) SDL_AtomicAdd(&g_head, 1);
+	Slot& slot = g_slots[index & (c_capacity - 1)];
+
+	SDL_AtomicSet(&slot.m_sequence, 0);
+	slot.m_event.m_offset = p_offset;
+	slot.m_event.m_size = p_size;
+	slot.m_event.m_bytesRead = p_bytesRead;
+	slot.m_event.m_time = p_start;
+	slot.m_event.m_latency = (MxU32) ((end - p_start) * 1000000 / SDL_GetPerformanceFrequency());
+	slot.m_event.m_bufferHit = p_bufferHit;
+	SDL_AtomicSet(&slot.m_sequence, (int) (index + 1));
+}
+
+MxU32 MxIOTrace::Snapshot(MxIOTraceEvent* p_events, MxU32 p_max)
+{
+	MxU32 head = (MxU32) SDL_AtomicGet(&g_head);
+	MxU32 count = head < c_capacity ? head : c_capacity;
+	if (count > p_max) {
+		count = p_max;
+	}
+
+	// An event counts only if its slot held the same sequence number before and after the copy
+	MxU32 copied = 0;
+	for (MxU32 index = head - count; index != head; index++) {
+		Slot& slot = g_slots[index & (c_capacity - 1)];
+		if ((MxU32) SDL_AtomicGet(&slot.m_sequence) != index + 1) {
+			continue;
+		}
+
+		p_events[copied] = slot.m_event;
+		SDL_MemoryBarrierAcquire();
+
+		if ((MxU32) SDL_AtomicGet(&slot.m_sequence) == index + 1) {
+			copied++;
+		}
+	}
+
+	return copied;
+}
+
+void MxIOTrace::Dump()
+{
+	MxIOTraceEvent* events = new MxIOTraceEvent[c_capacity];
+	MxU32 count = Snapshot(events, c_capacity);
+
+	SDL_Log("I/O trace: %u reads", count);
+	for (MxU32 i = 0; i < count; i++) {
+		const MxIOTraceEvent& event = events[i];
+		SDL_Log(
+			"%10llu offset %10lld size %8u read %8u %6u us %s",
+			(unsigned long long) event.m_time,
+			(long long) event.m_offset,
+			event.m_size,
+			event.m_bytesRead,
+			event.m_latency,
+			event.m_bufferHit ? "hit" : "miss"
+		);
+	}
+
+	delete[] events;
+}
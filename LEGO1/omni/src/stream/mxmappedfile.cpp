@@ -0,0 +1,142 @@
+#include "mxmappedfile.h"
+
+#include "mxstring.h"
+
+#include <limits.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MxMappedFile::MxMappedFile()
+{
+	m_data = NULL;
+	m_size = 0;
+#ifdef _WIN32
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = NULL;
+#endif
+}
+
+MxResult MxMappedFile::Open(const char* p_filename)
+{
+	Close();
+
+	MxString path(p_filename);
+	path.MapPathToFilesystem();
+
+#if defined(__EMSCRIPTEN__)
+	// Files are fetched on demand from the stream host, there is nothing to map
+	return FAILURE;
+#elif defined(_WIN32)
+	m_file = CreateFileA(
+		path.GetData(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		NULL,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		NULL
+	);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		return FAILURE;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0 || size.QuadPart > LONG_MAX) {
+		Close();
+		return FAILURE;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	if (m_mapping == NULL) {
+		Close();
+		return FAILURE;
+	}
+
+	m_data = (MxU8*) MapViewOfFile(m_mapping, FILE_MAP_COPY, 0, 0, 0);
+	if (m_data == NULL) {
+		Close();
+		return FAILURE;
+	}
+
+	m_size = (MxLong) size.QuadPart;
+	return SUCCESS;
+#else
+	int fd = open(path.GetData(), O_RDONLY);
+	if (fd == -1) {
+		return FAILURE;
+	}
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0 || info.st_size > LONG_MAX) {
+		close(fd);
+		return FAILURE;
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	void* data = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		return FAILURE;
+	}
+
+	m_data = (MxU8*) data;
+	m_size = (MxLong) info.st_size;
+	return SUCCESS;
+#endif
+}
+
+void MxMappedFile::Close()
+{
+#if defined(_WIN32)
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping) {
+		CloseHandle(m_mapping);
+		m_mapping = NULL;
+	}
+	if (m_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_file);
+		m_file = INVALID_HANDLE_VALUE;
+	}
+#elif !defined(__EMSCRIPTEN__)
+	if (m_data) {
+		munmap(m_data, m_size);
+	}
+#endif
+
+	m_data = NULL;
+	m_size = 0;
+}
+
+void MxMappedFile::Prefetch(MxLong p_offset, MxLong p_size)
+{
+	if (m_data == NULL || p_offset < 0 || p_offset >= m_size || p_size <= 0) {
+		return;
+	}
+
+	if (p_size > m_size - p_offset) {
+		p_size = m_size - p_offset;
+	}
+
+#if defined(_WIN32)
+#if _WIN32_WINNT >= 0x0602
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = m_data + p_offset;
+	range.NumberOfBytes = p_size;
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+#elif !defined(__EMSCRIPTEN__)
+	// madvise wants a page aligned start
+	MxLong page = sysconf(_SC_PAGESIZE);
+	MxLong start = p_offset - p_offset % page;
+	madvise(m_data + start, p_size + (p_offset - start), MADV_WILLNEED);
+#endif
+}
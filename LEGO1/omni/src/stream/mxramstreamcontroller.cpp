@@ -20,14 +20,13 @@ MxResult MxRAMStreamController::Open(const char* p_filename)
 			return FAILURE;
 		}
 
-		ReadData(
-			((MxRAMStreamProvider*) m_provider)->GetBufferOfFileSize(),
-			((MxRAMStreamProvider*) m_provider)->GetFileSize()
-		);
+		// [library:filesystem] Chunks are found through the provider's index, which replaces the
+		// compaction ReadData does and lets the buffer reference the file without modifying it
 		m_buffer.SetBufferPointer(
 			((MxRAMStreamProvider*) m_provider)->GetBufferOfFileSize(),
 			((MxRAMStreamProvider*) m_provider)->GetFileSize()
 		);
+		m_buffer.SetChunkIndex(((MxRAMStreamProvider*) m_provider)->GetChunkIndex());
 		return SUCCESS;
 	}
 
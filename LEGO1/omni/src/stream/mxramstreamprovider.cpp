@@ -50,7 +50,14 @@ MxRAMStreamProvider::~MxRAMStreamProvider()
 	m_bufferSize = 0;
 	m_fileSize = 0;
 
-	delete[] m_pBufferOfFileSize;
+	m_chunkIndex.Clear();
+	if (m_pFile != NULL) {
+		delete m_pFile;
+		m_pFile = NULL;
+	}
+	else {
+		delete[] m_pBufferOfFileSize;
+	}
 	m_pBufferOfFileSize = NULL;
 
 	m_lengthInDWords = 0;
@@ -82,14 +89,26 @@ MxResult MxRAMStreamProvider::SetResourceToGet(MxStreamController* p_resource)
 		m_fileSize = m_pFile->CalcFileSize();
 		if (m_fileSize != 0) {
 			m_bufferSize = m_pFile->GetBufferSize();
-			m_pBufferOfFileSize = new MxU8[m_fileSize];
-			if (m_pBufferOfFileSize != NULL &&
-				m_pFile->Read((unsigned char*) m_pBufferOfFileSize, m_fileSize) == SUCCESS) {
+
+			// [library:filesystem] Use the mapped file in place instead of reading a copy of it
+			if (m_pFile->GetMappedData() != NULL) {
+				m_pBufferOfFileSize = m_pFile->GetMappedData();
+			}
+			else {
+				m_pBufferOfFileSize = new MxU8[m_fileSize];
+				if (m_pBufferOfFileSize != NULL &&
+					m_pFile->Read((unsigned char*) m_pBufferOfFileSize, m_fileSize) != SUCCESS) {
+					goto done;
+				}
+			}
+
+			if (m_pBufferOfFileSize != NULL) {
 				m_lengthInDWords = m_pFile->GetLengthInDWords();
 				m_bufferForDWords = new MxU32[m_lengthInDWords];
 
 				if (m_bufferForDWords != NULL) {
 					memcpy(m_bufferForDWords, m_pFile->GetBuffer(), m_lengthInDWords * sizeof(MxU32));
+					m_chunkIndex.Build(m_pBufferOfFileSize, m_fileSize);
 					result = SUCCESS;
 				}
 			}
@@ -97,8 +116,15 @@ MxResult MxRAMStreamProvider::SetResourceToGet(MxStreamController* p_resource)
 	}
 
 done:
-	delete m_pFile;
-	m_pFile = NULL;
+	// The mapping, if any, lives as long as the provider
+	if (m_pFile != NULL && (result != SUCCESS || m_pFile->GetMappedData() == NULL)) {
+		if (m_pBufferOfFileSize == m_pFile->GetMappedData()) {
+			m_pBufferOfFileSize = NULL;
+		}
+
+		delete m_pFile;
+		m_pFile = NULL;
+	}
 	return result;
 }
 
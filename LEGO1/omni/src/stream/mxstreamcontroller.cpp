@@ -2,6 +2,7 @@
 
 #include "mxautolock.h"
 #include "mxdebug.h"
+#include "mxdsfile.h"
 #include "mxdsmultiaction.h"
 #include "mxdsstreamingaction.h"
 #include "mxmisc.h"
@@ -106,6 +107,11 @@ MxResult MxStreamController::VTable0x20(MxDSAction* p_action)
 	}
 
 	if (offset) {
+		// [library:filesystem] Have the OS read the object in while the action is being set up
+		if (provider->GetFile() != NULL) {
+			provider->GetFile()->PrefetchObject(objectId);
+		}
+
 		result = VTable0x2c(p_action, offset);
 	}
 	else {
@@ -292,7 +298,7 @@ MxResult MxStreamController::FUN_100c1f00(MxDSAction* p_action)
 		delete chunk;
 	}
 
-	if (p_action->IsA("MxDSMultiAction")) {
+	if (p_action->IsA(MxDSMultiAction::g_typeInfo)) {
 		MxDSActionList* actions = ((MxDSMultiAction*) p_action)->GetActionList();
 		MxDSActionListCursor cursor(actions);
 		MxDSAction* action;
@@ -330,7 +336,7 @@ MxBool MxStreamController::IsStoped(MxDSObject* p_obj)
 		return FALSE;
 	}
 
-	if (p_obj->IsA("MxDSMultiAction")) {
+	if (p_obj->IsA(MxDSMultiAction::g_typeInfo)) {
 		MxDSActionListCursor cursor(((MxDSMultiAction*) p_obj)->GetActionList());
 		MxDSAction* action;
 
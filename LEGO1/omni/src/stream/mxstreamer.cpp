@@ -144,7 +144,7 @@ MxStreamController* MxStreamer::GetOpenStream(const char* p_name)
 void MxStreamer::FUN_100b98f0(MxDSAction* p_action)
 {
 	MxStreamController* controller = GetOpenStream(p_action->GetAtomId().GetInternal());
-	if (controller && controller->IsA("MxDiskStreamController")) {
+	if (controller && controller->IsA(MxDiskStreamController::g_typeInfo)) {
 		((MxDiskStreamController*) controller)->FUN_100c8120(p_action);
 	}
 }
@@ -0,0 +1,293 @@
+#include "benchscene.h"
+
+#include "ddsurface_impl.h"
+#include "mathutils.h"
+
+#include <cmath>
+#include <vector>
+
+struct MeshBuilder {
+	std::vector<D3DRMVERTEX> vertices;
+	std::vector<unsigned int> faces;
+
+	// Winds the triangle so it faces along outward, which is the side the renderer does not cull
+	void AddTriangle(unsigned int a, unsigned int b, unsigned int c, const D3DVECTOR& outward)
+	{
+		const D3DVECTOR& p0 = vertices[a].position;
+		D3DVECTOR normal = CrossProduct(
+			{vertices[b].position.x - p0.x, vertices[b].position.y - p0.y, vertices[b].position.z - p0.z},
+			{vertices[c].position.x - p0.x, vertices[c].position.y - p0.y, vertices[c].position.z - p0.z}
+		);
+		if (DotProduct(normal, outward) >= 0.0f) {
+			faces.insert(faces.end(), {a, b, c});
+		}
+		else {
+			faces.insert(faces.end(), {a, c, b});
+		}
+	}
+
+	void AddQuad(const D3DVECTOR (&corners)[4], const D3DVECTOR& normal, float uScale, float vScale)
+	{
+		unsigned int first = vertices.size();
+		static const float uv[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+		for (int i = 0; i < 4; ++i) {
+			D3DRMVERTEX v = {};
+			v.position = corners[i];
+			v.normal = normal;
+			v.tu = uv[i][0] * uScale;
+			v.tv = uv[i][1] * vScale;
+			vertices.push_back(v);
+		}
+		AddTriangle(first, first + 1, first + 2, normal);
+		AddTriangle(first, first + 2, first + 3, normal);
+	}
+
+	IDirect3DRMMesh* Create(IDirect3DRM* d3drm, D3DCOLOR color, IDirect3DRMTexture* texture)
+	{
+		IDirect3DRMMesh* mesh;
+		D3DRMGROUPINDEX group;
+		d3drm->CreateMesh(&mesh);
+		mesh->AddGroup(vertices.size(), faces.size() / 3, 3, faces.data(), &group);
+		mesh->SetVertices(group, 0, vertices.size(), vertices.data());
+		mesh->SetGroupColor(group, color);
+		if (texture) {
+			mesh->SetGroupTexture(group, texture);
+		}
+		return mesh;
+	}
+};
+
+static Uint32 NextRandom(Uint32& seed)
+{
+	seed = seed * 1664525 + 1013904223;
+	return seed >> 8;
+}
+
+static float RandomRange(Uint32& seed, float min, float max)
+{
+	return min + (NextRandom(seed) % 10000) / 10000.0f * (max - min);
+}
+
+IDirect3DRMMesh* CreateSphereMesh(IDirect3DRM* d3drm, float radius, int rings, int segments)
+{
+	MeshBuilder builder;
+	for (int r = 0; r <= rings; ++r) {
+		float phi = M_PI * r / rings;
+		for (int s = 0; s <= segments; ++s) {
+			float theta = 2.0f * M_PI * s / segments;
+			D3DRMVERTEX v = {};
+			v.normal = {sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta)};
+			v.position = {v.normal.x * radius, v.normal.y * radius, v.normal.z * radius};
+			v.tu = (float) s / segments;
+			v.tv = (float) r / rings;
+			builder.vertices.push_back(v);
+		}
+	}
+
+	for (int r = 0; r < rings; ++r) {
+		for (int s = 0; s < segments; ++s) {
+			unsigned int a = r * (segments + 1) + s;
+			unsigned int b = a + segments + 1;
+			if (r > 0) {
+				builder.AddTriangle(a, b, a + 1, builder.vertices[a].normal);
+			}
+			if (r < rings - 1) {
+				builder.AddTriangle(a + 1, b, b + 1, builder.vertices[b].normal);
+			}
+		}
+	}
+
+	return builder.Create(d3drm, 0xff808080, nullptr);
+}
+
+IDirect3DRMMesh* CreateBoxMesh(IDirect3DRM* d3drm, const D3DVECTOR& size, IDirect3DRMTexture* texture)
+{
+	float x = size.x * 0.5f;
+	float z = size.z * 0.5f;
+	float y = size.y;
+
+	// Open at the bottom, it stands on the ground
+	MeshBuilder builder;
+	builder.AddQuad({{-x, 0, -z}, {x, 0, -z}, {x, y, -z}, {-x, y, -z}}, {0, 0, -1}, size.x / 4, size.y / 4);
+	builder.AddQuad({{x, 0, z}, {-x, 0, z}, {-x, y, z}, {x, y, z}}, {0, 0, 1}, size.x / 4, size.y / 4);
+	builder.AddQuad({{-x, 0, z}, {-x, 0, -z}, {-x, y, -z}, {-x, y, z}}, {-1, 0, 0}, size.z / 4, size.y / 4);
+	builder.AddQuad({{x, 0, -z}, {x, 0, z}, {x, y, z}, {x, y, -z}}, {1, 0, 0}, size.z / 4, size.y / 4);
+	builder.AddQuad({{-x, y, -z}, {x, y, -z}, {x, y, z}, {-x, y, z}}, {0, 1, 0}, size.x / 4, size.z / 4);
+	return builder.Create(d3drm, 0xffffffff, texture);
+}
+
+float IslandHeight(float x, float z)
+{
+	float d = sqrtf(x * x + z * z) / (ISLAND_SIZE * 0.5f);
+	return 6.0f * (1.0f - d * d) + 1.5f * sinf(x * 0.11f) * cosf(z * 0.07f);
+}
+
+IDirect3DRMMesh* CreateTerrainMesh(IDirect3DRM* d3drm, float size, int cells, IDirect3DRMTexture* texture)
+{
+	MeshBuilder builder;
+	float step = size / cells;
+	for (int j = 0; j <= cells; ++j) {
+		for (int i = 0; i <= cells; ++i) {
+			float x = -size * 0.5f + i * step;
+			float z = -size * 0.5f + j * step;
+			float dx = IslandHeight(x + 0.5f, z) - IslandHeight(x - 0.5f, z);
+			float dz = IslandHeight(x, z + 0.5f) - IslandHeight(x, z - 0.5f);
+			D3DRMVERTEX v = {};
+			v.position = {x, IslandHeight(x, z), z};
+			v.normal = Normalize({-dx, 1.0f, -dz});
+			v.tu = i * 0.25f;
+			v.tv = j * 0.25f;
+			builder.vertices.push_back(v);
+		}
+	}
+
+	for (int j = 0; j < cells; ++j) {
+		for (int i = 0; i < cells; ++i) {
+			unsigned int a = j * (cells + 1) + i;
+			unsigned int b = a + cells + 1;
+			builder.AddTriangle(a, a + 1, b + 1, {0, 1, 0});
+			builder.AddTriangle(a, b + 1, b, {0, 1, 0});
+		}
+	}
+
+	return builder.Create(d3drm, 0xffffffff, texture);
+}
+
+IDirect3DRMMesh* CreateWaterMesh(IDirect3DRM* d3drm, float size, float height)
+{
+	float h = size * 0.5f;
+	MeshBuilder builder;
+	builder.AddQuad({{-h, height, -h}, {h, height, -h}, {h, height, h}, {-h, height, h}}, {0, 1, 0}, 1, 1);
+	return builder.Create(d3drm, 0x802060c0, nullptr);
+}
+
+IDirect3DRMTexture* CreateCheckerTexture(IDirect3DRM* d3drm, int size, int checkSize, Uint32 color0, Uint32 color1)
+{
+	// The texture refers to the surface without owning it, so it is kept for the life of the process
+	auto* surface = new DirectDrawSurfaceImpl(size, size, SDL_PIXELFORMAT_RGBA8888);
+	SDL_Surface* pixels = surface->m_surface;
+	for (int y = 0; y < size; ++y) {
+		Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(pixels->pixels) + y * pixels->pitch);
+		for (int x = 0; x < size; ++x) {
+			row[x] = ((x / checkSize) + (y / checkSize)) % 2 ? color1 : color0;
+		}
+	}
+
+	IDirect3DRMTexture2* texture;
+	d3drm->CreateTextureFromSurface(surface, &texture);
+	return texture;
+}
+
+void AddMeshFrame(IDirect3DRM* d3drm, IDirect3DRMFrame* parent, IDirect3DRMMesh* mesh, const D3DVECTOR& position)
+{
+	D3DRMMATRIX4D transform = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {position.x, position.y, position.z, 1}};
+	IDirect3DRMFrame2* frame;
+	d3drm->CreateFrame(nullptr, &frame);
+	frame->AddTransform(D3DRMCOMBINE_REPLACE, transform);
+	frame->AddVisual(mesh);
+	parent->AddVisual(frame);
+	frame->Release();
+}
+
+void BuildIsland(IDirect3DRM* d3drm, IDirect3DRMFrame* root)
+{
+	IDirect3DRMLight* ambient;
+	d3drm->CreateLightRGB(D3DRMLIGHT_AMBIENT, 0.4f, 0.4f, 0.4f, &ambient);
+	root->AddLight(ambient);
+	ambient->Release();
+
+	IDirect3DRMFrame2* sun;
+	IDirect3DRMLight* sunLight;
+	d3drm->CreateFrame(root, &sun);
+	LookAt(sun, {0, 0, 0}, {0.4f, -1.0f, 0.3f});
+	d3drm->CreateLightRGB(D3DRMLIGHT_DIRECTIONAL, 0.8f, 0.8f, 0.7f, &sunLight);
+	sun->AddLight(sunLight);
+	sunLight->Release();
+	sun->Release();
+
+	IDirect3DRMTexture* grass = CreateCheckerTexture(d3drm, 64, 8, 0x3c8c3cff, 0x4a9a40ff);
+	IDirect3DRMTexture* bricks = CreateCheckerTexture(d3drm, 128, 16, 0xa04030ff, 0xc8c0b0ff);
+
+	IDirect3DRMMesh* terrain = CreateTerrainMesh(d3drm, ISLAND_SIZE, 96, grass);
+	AddMeshFrame(d3drm, root, terrain, {0, 0, 0});
+	terrain->Release();
+
+	IDirect3DRMMesh* boxes[4];
+	for (int i = 0; i < 4; ++i) {
+		boxes[i] = CreateBoxMesh(d3drm, {4.0f + i * 2, 5.0f + i * 4, 4.0f + (3 - i) * 2}, bricks);
+	}
+
+	IDirect3DRMMesh* canopy = CreateSphereMesh(d3drm, 1.5f, 8, 12);
+	canopy->SetGroupColor(0, 0xff2a6a1a);
+	canopy->SetGroupQuality(0, D3DRMRENDER_FLAT);
+	IDirect3DRMMesh* trunk = CreateBoxMesh(d3drm, {0.4f, 2.0f, 0.4f}, nullptr);
+	trunk->SetGroupColor(0, 0xff604020);
+
+	Uint32 seed = 4242;
+	for (int i = 0; i < 160; ++i) {
+		float angle = RandomRange(seed, 0.0f, 2.0f * M_PI);
+		float distance = RandomRange(seed, 5.0f, ISLAND_SIZE * 0.35f);
+		float x = cosf(angle) * distance;
+		float z = sinf(angle) * distance;
+		AddMeshFrame(d3drm, root, boxes[NextRandom(seed) % 4], {x, IslandHeight(x, z) - 0.5f, z});
+	}
+	for (int i = 0; i < 400; ++i) {
+		float x = RandomRange(seed, -ISLAND_SIZE * 0.4f, ISLAND_SIZE * 0.4f);
+		float z = RandomRange(seed, -ISLAND_SIZE * 0.4f, ISLAND_SIZE * 0.4f);
+		float y = IslandHeight(x, z);
+		AddMeshFrame(d3drm, root, trunk, {x, y - 0.2f, z});
+		AddMeshFrame(d3drm, root, canopy, {x, y + 2.8f, z});
+	}
+
+	for (IDirect3DRMMesh* box : boxes) {
+		box->Release();
+	}
+	canopy->Release();
+	trunk->Release();
+
+	IDirect3DRMMesh* water = CreateWaterMesh(d3drm, ISLAND_SIZE * 1.5f, 1.0f);
+	AddMeshFrame(d3drm, root, water, {0, 0, 0});
+	water->Release();
+}
+
+void LookAt(IDirect3DRMFrame* frame, const D3DVECTOR& eye, const D3DVECTOR& target)
+{
+	D3DVECTOR forward = Normalize({target.x - eye.x, target.y - eye.y, target.z - eye.z});
+	D3DVECTOR up = {0, 1, 0};
+	if (fabsf(DotProduct(forward, up)) > 0.99f) {
+		up = {0, 0, 1};
+	}
+	D3DVECTOR right = Normalize(CrossProduct(up, forward));
+	up = CrossProduct(forward, right);
+
+	D3DRMMATRIX4D transform = {
+		{right.x, right.y, right.z, 0},
+		{up.x, up.y, up.z, 0},
+		{forward.x, forward.y, forward.z, 0},
+		{eye.x, eye.y, eye.z, 1}
+	};
+	frame->AddTransform(D3DRMCOMBINE_REPLACE, transform);
+}
+
+void CircleIsland(IDirect3DRMFrame* camera, int frame, int frameCount)
+{
+	float t = (float) frame / frameCount;
+	float angle = 2.0f * M_PI * t;
+	float radius = ISLAND_SIZE * (0.2f + 0.15f * sinf(angle * 3.0f));
+	float x = cosf(angle) * radius;
+	float z = sinf(angle) * radius;
+	float y = IslandHeight(x, z) + 3.0f + 25.0f * (0.5f + 0.5f * sinf(angle * 2.0f));
+	LookAt(camera, {x, y, z}, {-z * 0.3f, IslandHeight(0, 0), x * 0.3f});
+}
+
+Uint32 SurfaceChecksum(SDL_Surface* surface, Uint32 hash)
+{
+	int rowBytes = surface->w * surface->format->BytesPerPixel;
+	for (int y = 0; y < surface->h; ++y) {
+		const Uint8* row = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+		for (int x = 0; x < rowBytes; ++x) {
+			hash = (hash ^ row[x]) * 16777619u;
+		}
+	}
+	return hash;
+}
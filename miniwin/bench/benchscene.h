@@ -0,0 +1,31 @@
+#pragma once
+
+#include "miniwin/d3drm.h"
+
+#include <SDL2/SDL.h>
+
+// Deterministic scenes shared by the miniwin benchmarks. Everything is generated, so runs on any
+// machine see exactly the same geometry and textures.
+
+IDirect3DRMMesh* CreateSphereMesh(IDirect3DRM* d3drm, float radius, int rings, int segments);
+IDirect3DRMMesh* CreateBoxMesh(IDirect3DRM* d3drm, const D3DVECTOR& size, IDirect3DRMTexture* texture);
+IDirect3DRMMesh* CreateTerrainMesh(IDirect3DRM* d3drm, float size, int cells, IDirect3DRMTexture* texture);
+IDirect3DRMMesh* CreateWaterMesh(IDirect3DRM* d3drm, float size, float height);
+IDirect3DRMTexture* CreateCheckerTexture(IDirect3DRM* d3drm, int size, int checkSize, Uint32 color0, Uint32 color1);
+
+// Adds a frame holding mesh at position below parent
+void AddMeshFrame(IDirect3DRM* d3drm, IDirect3DRMFrame* parent, IDirect3DRMMesh* mesh, const D3DVECTOR& position);
+
+// Terrain, water, buildings, trees and lights of a small island, about ISLAND_SIZE across
+#define ISLAND_SIZE 200.0f
+void BuildIsland(IDirect3DRM* d3drm, IDirect3DRMFrame* root);
+float IslandHeight(float x, float z);
+
+// Places a camera frame at eye, looking at target
+void LookAt(IDirect3DRMFrame* frame, const D3DVECTOR& eye, const D3DVECTOR& target);
+
+// Circles the island once over frameCount frames, bobbing between street level and a view from above
+void CircleIsland(IDirect3DRMFrame* camera, int frame, int frameCount);
+
+// FNV-1a over the visible pixels of a surface
+Uint32 SurfaceChecksum(SDL_Surface* surface, Uint32 hash = 2166136261u);
@@ -0,0 +1,250 @@
+// Compares Direct3DRMViewportImpl::Pick with MINIWIN_PICKING=linear and the default BVH path on a
+// recorded scene. One frame of a renderer capture (see MINIWIN_HINT_CAPTURE) is rebuilt as a frame
+// hierarchy: every draw becomes a frame holding the captured mesh at its model view matrix, below a
+// camera at the origin with the captured projection. Both paths are then picked at the same fixed
+// sequence of screen positions, and any disagreement on the nearest hit fails the run.
+// Usage: miniwin-pickbench capture [picks] [frame]
+
+#include "d3drm_impl.h"
+#include "d3drmrenderer_capture.h"
+#include "d3drmrenderer_software.h"
+#include "d3drmviewport_impl.h"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Nearest hits agree when both paths hit the same visual, or visuals at the same distance, to within
+// this fraction of the distance. The linear path tests triangles in world space and the BVH in mesh
+// space, so the two only differ by rounding.
+#define PICK_DISTANCE_TOLERANCE 1e-4f
+
+struct PickResult {
+	DWORD count;
+	IDirect3DRMVisual* visual;
+	float dist;
+};
+
+struct CapturedDraw {
+	IDirect3DRMMesh* mesh;
+	D3DRMMATRIX4D modelViewMatrix;
+};
+
+// Collects the draws of a replayed frame instead of rendering them
+class SceneCollector : public Direct3DRMRenderer {
+public:
+	void PushLights(const SceneLight* vertices, size_t count) override {}
+	void SetProjection(const D3DRMMATRIX4D& projection, D3DVALUE front, D3DVALUE back) override
+	{
+		m_field = front / projection[0][0];
+		m_front = front;
+		m_back = back;
+	}
+	void SetFrustumPlanes(const Plane* frustumPlanes) override {}
+	Uint32 GetTextureId(IDirect3DRMTexture* texture) override { return NO_TEXTURE_ID; }
+	Uint32 GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup) override
+	{
+		m_meshes.push_back(mesh);
+		return (Uint32) m_meshes.size() - 1;
+	}
+	DWORD GetWidth() override { return 0; }
+	DWORD GetHeight() override { return 0; }
+	void GetDesc(D3DDEVICEDESC* halDesc, D3DDEVICEDESC* helDesc) override {}
+	const char* GetName() override { return "Scene Collector"; }
+	HRESULT BeginFrame() override
+	{
+		m_draws.clear();
+		return DD_OK;
+	}
+	void EnableTransparency() override {}
+	void SubmitDraw(
+		DWORD meshId,
+		const D3DRMMATRIX4D& modelViewMatrix,
+		const Matrix3x3& normalMatrix,
+		const Appearance& appearance
+	) override
+	{
+		CapturedDraw& draw = m_draws.emplace_back();
+		draw.mesh = m_meshes[meshId];
+		memcpy(draw.modelViewMatrix, modelViewMatrix, sizeof(D3DRMMATRIX4D));
+	}
+	HRESULT FinalizeFrame() override { return DD_OK; }
+	SDL_Surface* GetOutputSurface() override { return nullptr; }
+
+	std::vector<IDirect3DRMMesh*> m_meshes;
+	std::vector<CapturedDraw> m_draws;
+	D3DVALUE m_field = 0.5f;
+	D3DVALUE m_front = 1.0f;
+	D3DVALUE m_back = 1000.0f;
+};
+
+static IDirect3DRMViewport* CreatePickViewport(
+	IDirect3DRM* d3drm,
+	IDirect3DRMDevice2* device,
+	IDirect3DRMFrame* camera,
+	const SceneCollector& scene,
+	DWORD width,
+	DWORD height,
+	const char* picking
+)
+{
+	SDL_SetHint(MINIWIN_HINT_PICKING, picking);
+	IDirect3DRMViewport* viewport;
+	d3drm->CreateViewport(device, camera, 0, 0, width, height, &viewport);
+	viewport->SetFront(scene.m_front);
+	viewport->SetBack(scene.m_back);
+	viewport->SetField(scene.m_field);
+	return viewport;
+}
+
+static double RunPicks(
+	IDirect3DRMViewport* viewport,
+	int picks,
+	DWORD width,
+	DWORD height,
+	std::vector<PickResult>& results
+)
+{
+	Uint32 seed = 12345;
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (int i = 0; i < picks; ++i) {
+		seed = seed * 1664525 + 1013904223;
+		float x = (seed >> 8) % width;
+		seed = seed * 1664525 + 1013904223;
+		float y = (seed >> 8) % height;
+
+		IDirect3DRMPickedArray* picked;
+		PickResult result = {};
+		viewport->Pick(x, y, &picked);
+		result.count = picked->GetSize();
+		if (result.count) {
+			IDirect3DRMFrameArray* frames;
+			D3DRMPICKDESC desc;
+			picked->GetPick(0, &result.visual, &frames, &desc);
+			result.dist = desc.dist;
+			result.visual->Release();
+			frames->Release();
+		}
+		picked->Release();
+		results.push_back(result);
+	}
+	return (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static bool SameNearestHit(const PickResult& a, const PickResult& b)
+{
+	if (!a.count || !b.count) {
+		return !a.count == !b.count;
+	}
+	return fabsf(a.dist - b.dist) <= PICK_DISTANCE_TOLERANCE * std::max(1.0f, fabsf(a.dist));
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		printf("Usage: %s capture [picks] [frame]\n", argv[0]);
+		return 1;
+	}
+	int picks = argc > 2 ? atoi(argv[2]) : 2000;
+	int frame = argc > 3 ? atoi(argv[3]) : 0;
+
+	SDL_Init(0);
+
+	IDirect3DRM* d3drm;
+	Direct3DRMCreate(&d3drm);
+
+	RenderCaptureReplay* replay = new RenderCaptureReplay(d3drm);
+	if (!replay->Open(argv[1])) {
+		return 1;
+	}
+
+	SceneCollector scene;
+	for (int i = 0; i <= frame; ++i) {
+		if (!replay->ReplayFrame(&scene)) {
+			printf("%s has no frame %d\n", argv[1], frame);
+			return 1;
+		}
+	}
+
+	DWORD width = replay->GetWidth();
+	DWORD height = replay->GetHeight();
+	IDirect3DRMDevice2* device;
+	d3drm->CreateDeviceFromD3D(nullptr, Direct3DRMSoftwareRenderer::CreateOffscreen(width, height), &device);
+
+	// The model view matrices already include the captured camera, which leaves ours at the origin
+	IDirect3DRMFrame2* root;
+	IDirect3DRMFrame2* camera;
+	d3drm->CreateFrame(nullptr, &root);
+	d3drm->CreateFrame(root, &camera);
+
+	int triangles = 0;
+	for (CapturedDraw& draw : scene.m_draws) {
+		IDirect3DRMFrame2* drawFrame;
+		d3drm->CreateFrame(root, &drawFrame);
+		drawFrame->AddTransform(D3DRMCOMBINE_REPLACE, draw.modelViewMatrix);
+		drawFrame->AddVisual(draw.mesh);
+		drawFrame->Release();
+
+		unsigned int faceCount;
+		draw.mesh->GetGroup(0, nullptr, &faceCount, nullptr, nullptr, nullptr);
+		triangles += faceCount;
+	}
+
+	IDirect3DRMViewport* linear = CreatePickViewport(d3drm, device, camera, scene, width, height, "linear");
+	IDirect3DRMViewport* bvh = CreatePickViewport(d3drm, device, camera, scene, width, height, "bvh");
+	linear->Render(root);
+	bvh->Render(root);
+
+	std::vector<PickResult> linearResults;
+	std::vector<PickResult> bvhResults;
+	double linearTime = RunPicks(linear, picks, width, height, linearResults);
+	double bvhTime = RunPicks(bvh, picks, width, height, bvhResults);
+
+	int mismatches = 0;
+	int countDiffs = 0;
+	int hits = 0;
+	for (int i = 0; i < picks; ++i) {
+		const PickResult& a = linearResults[i];
+		const PickResult& b = bvhResults[i];
+		if (a.count) {
+			hits++;
+		}
+		if (a.count != b.count) {
+			countDiffs++;
+		}
+		if (!SameNearestHit(a, b)) {
+			if (mismatches < 10) {
+				printf(
+					"pick %d: linear %s at %f, bvh %s at %f\n",
+					i,
+					a.count ? "hit" : "missed",
+					a.count ? a.dist : 0.0f,
+					b.count ? "hit" : "missed",
+					b.count ? b.dist : 0.0f
+				);
+			}
+			mismatches++;
+		}
+	}
+
+	printf("%d draws, %d triangles, %d picks (%d hit)\n", (int) scene.m_draws.size(), triangles, picks, hits);
+	printf("linear: %8.3f ms/pick\n", linearTime * 1000.0 / picks);
+	printf("bvh:    %8.3f ms/pick (%.1fx)\n", bvhTime * 1000.0 / picks, linearTime / bvhTime);
+	printf("nearest hit mismatches: %d, hit count differences: %d\n", mismatches, countDiffs);
+
+	bvh->Release();
+	linear->Release();
+	camera->Release();
+	root->Release();
+	// Releasing the replayed meshes calls back into the device's renderer, so the device goes after them
+	delete replay;
+	device->Release();
+	d3drm->Release();
+	SDL_Quit();
+
+	return mismatches ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+// Renders the generated island along the benchmark camera path with the scanline rasterizer and with every
+// edge row kernel this CPU supports, for each texture filter, and fails if any frame checksum differs.
+// Usage: miniwin-rastercheck [frames] [width] [height]
+
+#include "benchscene.h"
+#include "d3drm_impl.h"
+#include "d3drmrenderer_software.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static std::vector<Uint32> RenderIsland(const char* rasterizer, const char* filter, int frames, int width, int height)
+{
+	std::vector<Uint32> checksums;
+
+	SDL_SetHint(MINIWIN_HINT_SOFTWARE_RASTERIZER, rasterizer);
+	SDL_SetHint(MINIWIN_HINT_SOFTWARE_TEXTURE_FILTER, filter);
+	Direct3DRMSoftwareRenderer* renderer = Direct3DRMSoftwareRenderer::CreateOffscreen(width, height);
+	if (!renderer) {
+		return checksums;
+	}
+
+	IDirect3DRM* d3drm;
+	IDirect3DRMDevice2* device;
+	Direct3DRMCreate(&d3drm);
+	d3drm->CreateDeviceFromD3D(nullptr, renderer, &device);
+
+	IDirect3DRMFrame2* root;
+	IDirect3DRMFrame2* camera;
+	d3drm->CreateFrame(nullptr, &root);
+	d3drm->CreateFrame(root, &camera);
+	root->SetSceneBackgroundRGB(0.5f, 0.7f, 1.0f);
+	BuildIsland(d3drm, root);
+
+	IDirect3DRMViewport* viewport;
+	d3drm->CreateViewport(device, camera, 0, 0, width, height, &viewport);
+	viewport->SetFront(0.5f);
+	viewport->SetBack(400.0f);
+	viewport->SetField(0.5f);
+
+	for (int i = 0; i < frames; ++i) {
+		CircleIsland(camera, i, frames);
+		viewport->Clear();
+		viewport->Render(root);
+		checksums.push_back(SurfaceChecksum(renderer->GetOutputSurface()));
+	}
+
+	viewport->Release();
+	camera->Release();
+	root->Release();
+	device->Release();
+	d3drm->Release();
+
+	return checksums;
+}
+
+int main(int argc, char* argv[])
+{
+	int frames = argc > 1 ? atoi(argv[1]) : 60;
+	int width = argc > 2 ? atoi(argv[2]) : 320;
+	int height = argc > 3 ? atoi(argv[3]) : 240;
+
+	SDL_Init(0);
+
+	static const char* const filters[] = {"nearest", "mipmap", "bilinear"};
+	static const char* const kernels[] = {"edge-scalar", "edge-sse2", "edge-avx2", "edge-neon", "edge-wasm128"};
+
+	int failures = 0;
+	for (const char* filter : filters) {
+		std::vector<Uint32> reference = RenderIsland("scanline", filter, frames, width, height);
+		if ((int) reference.size() != frames) {
+			printf("%s: failed to render\n", filter);
+			return 1;
+		}
+
+		EdgeRowRasterizer scalar = SelectEdgeRowRasterizer("edge-scalar");
+		for (const char* kernel : kernels) {
+			// Unsupported kernels fall back to the scalar one, which was already compared
+			if (SDL_strcmp(kernel, "edge-scalar") != 0 && SelectEdgeRowRasterizer(kernel) == scalar) {
+				continue;
+			}
+
+			std::vector<Uint32> checksums = RenderIsland(kernel, filter, frames, width, height);
+			int mismatch = -1;
+			for (int i = 0; i < frames && mismatch < 0; ++i) {
+				if (i >= (int) checksums.size() || checksums[i] != reference[i]) {
+					mismatch = i;
+				}
+			}
+
+			if (mismatch < 0) {
+				printf("%-12s %-8s ok\n", kernel, filter);
+			}
+			else {
+				printf("%-12s %-8s differs from scanline from frame %d\n", kernel, filter, mismatch);
+				failures++;
+			}
+		}
+	}
+
+	SDL_Quit();
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,98 @@
+// Renders the generated island headless with the software renderer along a fixed camera path and
+// reports the time spent per stage together with a checksum of every rendered frame.
+// Usage: miniwin-renderbench [frames] [width] [height] [capture]
+// With a capture path the measured frames are also recorded for miniwin-replay.
+
+#include "benchscene.h"
+#include "d3drm_impl.h"
+#include "d3drmrenderer_capture.h"
+#include "d3drmrenderer_software.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static double TicksToMs(Uint64 ticks, int frames)
+{
+	return (double) ticks * 1000.0 / SDL_GetPerformanceFrequency() / frames;
+}
+
+int main(int argc, char* argv[])
+{
+	int frames = argc > 1 ? atoi(argv[1]) : 300;
+	int width = argc > 2 ? atoi(argv[2]) : 640;
+	int height = argc > 3 ? atoi(argv[3]) : 480;
+	const char* capture = argc > 4 ? argv[4] : nullptr;
+
+	SDL_Init(0);
+
+	Direct3DRMSoftwareRenderer* renderer = Direct3DRMSoftwareRenderer::CreateOffscreen(width, height);
+	if (!renderer) {
+		return 1;
+	}
+
+	IDirect3DRM* d3drm;
+	IDirect3DRMDevice2* device;
+	Direct3DRMCreate(&d3drm);
+	if (capture) {
+		// Skips the warm-up frame
+		char buffer[16];
+		SDL_SetHint(MINIWIN_HINT_CAPTURE_SKIP, "1");
+		SDL_SetHint(MINIWIN_HINT_CAPTURE_FRAMES, SDL_itoa(frames, buffer, 10));
+		d3drm->CreateDeviceFromD3D(nullptr, new Direct3DRMCaptureRenderer(renderer, capture), &device);
+	}
+	else {
+		d3drm->CreateDeviceFromD3D(nullptr, renderer, &device);
+	}
+
+	IDirect3DRMFrame2* root;
+	IDirect3DRMFrame2* camera;
+	d3drm->CreateFrame(nullptr, &root);
+	d3drm->CreateFrame(root, &camera);
+	root->SetSceneBackgroundRGB(0.5f, 0.7f, 1.0f);
+	BuildIsland(d3drm, root);
+
+	IDirect3DRMViewport* viewport;
+	d3drm->CreateViewport(device, camera, 0, 0, width, height, &viewport);
+	viewport->SetFront(0.5f);
+	viewport->SetBack(400.0f);
+	viewport->SetField(0.5f);
+
+	// Warm up the texture and mesh caches outside the measurement
+	CircleIsland(camera, 0, frames);
+	viewport->Render(root);
+
+	renderer->EnableStats(true);
+	Uint32 checksum = 2166136261u;
+	Uint64 total = 0;
+	for (int i = 0; i < frames; ++i) {
+		CircleIsland(camera, i, frames);
+		Uint64 start = SDL_GetPerformanceCounter();
+		viewport->Clear();
+		viewport->Render(root);
+		total += SDL_GetPerformanceCounter() - start;
+		checksum = SurfaceChecksum(renderer->GetOutputSurface(), checksum);
+	}
+
+	const SoftwareRenderStats& stats = renderer->GetStats();
+	printf("%d frames at %dx%d\n", frames, width, height);
+	printf("frame:     %8.3f ms\n", TicksToMs(total, frames));
+	printf("transform: %8.3f ms\n", TicksToMs(stats.transform, frames));
+	printf("light:     %8.3f ms\n", TicksToMs(stats.light, frames));
+	printf("clip:      %8.3f ms\n", TicksToMs(stats.clip, frames));
+	printf("raster:    %8.3f ms\n", TicksToMs(stats.raster, frames));
+	printf("blend:     %8.3f ms\n", TicksToMs(stats.blend, frames));
+	printf("present:   %8.3f ms\n", TicksToMs(stats.present, frames));
+	printf("draws:     %8u per frame\n", stats.draws / frames);
+	printf("triangles: %8u per frame\n", stats.triangles / frames);
+	printf("checksum:  %08x\n", checksum);
+
+	viewport->Release();
+	camera->Release();
+	root->Release();
+	device->Release();
+	d3drm->Release();
+	SDL_Quit();
+
+	return 0;
+}
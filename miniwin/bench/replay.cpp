@@ -0,0 +1,87 @@
+// Replays a renderer capture (see MINIWIN_HINT_CAPTURE) headless and reports the time spent in
+// each renderer call together with a checksum of every replayed frame.
+// Usage: miniwin-replay capture [renderer] [loops]
+
+#include "benchscene.h"
+#include "d3drm_impl.h"
+#include "d3drmrenderer_capture.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static double TicksToMs(Uint64 ticks)
+{
+	return (double) ticks * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		printf("Usage: %s capture [renderer] [loops]\n", argv[0]);
+		return 1;
+	}
+	const char* rendererName = argc > 2 ? argv[2] : "software";
+	int loops = argc > 3 ? atoi(argv[3]) : 1;
+
+	SDL_Init(0);
+
+	IDirect3DRM* d3drm;
+	Direct3DRMCreate(&d3drm);
+
+	RenderCaptureReplay* replay = new RenderCaptureReplay(d3drm);
+	if (!replay->Open(argv[1])) {
+		return 1;
+	}
+
+	Direct3DRMRenderer* renderer = CreateReplayRenderer(rendererName, replay->GetWidth(), replay->GetHeight());
+	if (!renderer) {
+		return 1;
+	}
+
+	int frames = 0;
+	Uint64 total = 0;
+	Uint32 checksum = 2166136261u;
+	for (int loop = 0; loop < loops; ++loop) {
+		replay->Rewind();
+		for (;;) {
+			Uint64 start = SDL_GetPerformanceCounter();
+			if (!replay->ReplayFrame(renderer)) {
+				break;
+			}
+			total += SDL_GetPerformanceCounter() - start;
+			frames++;
+			if (renderer->GetOutputSurface()) {
+				checksum = SurfaceChecksum(renderer->GetOutputSurface(), checksum);
+			}
+		}
+	}
+
+	printf("%d frames at %dx%d on %s\n", frames, replay->GetWidth(), replay->GetHeight(), rendererName);
+	if (frames > 0) {
+		printf("frame: %10.3f ms\n", TicksToMs(total) / frames);
+		printf("%-22s %8s %12s %12s\n", "call", "calls", "ms/frame", "us/call");
+		for (int op = 0; op < CAPTURE_OP_COUNT; ++op) {
+			const ReplayCallStats& stats = replay->GetCallStats(static_cast<CaptureOp>(op));
+			if (stats.calls == 0) {
+				continue;
+			}
+			printf(
+				"%-22s %8u %12.3f %12.3f\n",
+				RenderCaptureReplay::GetOpName(static_cast<CaptureOp>(op)),
+				stats.calls,
+				TicksToMs(stats.ticks) / frames,
+				TicksToMs(stats.ticks) * 1000.0 / stats.calls
+			);
+		}
+		printf("checksum: %08x\n", checksum);
+	}
+
+	// Releasing the replayed textures and meshes calls back into the renderer, so it goes last
+	delete replay;
+	delete renderer;
+	d3drm->Release();
+	SDL_Quit();
+
+	return frames > 0 ? 0 : 1;
+}
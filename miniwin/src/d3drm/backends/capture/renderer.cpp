@@ -0,0 +1,451 @@
+#include "d3drmrenderer_capture.h"
+#include "d3drmtexture_impl.h"
+#include "ddsurface_impl.h"
+
+#include <SDL2/SDL.h>
+
+struct Direct3DRMCaptureRenderer::DestroyContext {
+	Direct3DRMCaptureRenderer* renderer;
+	IDirect3DRMObject* object;
+};
+
+Direct3DRMCaptureRenderer::Direct3DRMCaptureRenderer(Direct3DRMRenderer* renderer, const char* path)
+	: m_renderer(renderer)
+{
+	m_file = SDL_RWFromFile(path, "wb");
+	if (!m_file) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open capture file %s: %s", path, SDL_GetError());
+	}
+	else {
+		SDL_WriteLE32(m_file, CAPTURE_MAGIC);
+		SDL_WriteLE32(m_file, CAPTURE_VERSION);
+		SDL_WriteLE32(m_file, renderer->GetWidth());
+		SDL_WriteLE32(m_file, renderer->GetHeight());
+	}
+
+	const char* frames = SDL_GetHint(MINIWIN_HINT_CAPTURE_FRAMES);
+	m_frames = frames ? SDL_atoi(frames) : 1;
+	const char* skip = SDL_GetHint(MINIWIN_HINT_CAPTURE_SKIP);
+	m_skipFrames = skip ? SDL_atoi(skip) : 0;
+}
+
+Direct3DRMCaptureRenderer::~Direct3DRMCaptureRenderer()
+{
+	StopRecording();
+	delete m_renderer;
+}
+
+void Direct3DRMCaptureRenderer::StartRecording()
+{
+	if (m_recording || !m_file || m_skipFrames > 0 || m_frames <= 0) {
+		return;
+	}
+	m_recording = true;
+
+	// The projection only changes along with the viewport, so it is usually set long before
+	if (m_hasProjection) {
+		WriteOp(CAPTURE_SET_PROJECTION);
+		WriteMatrix(m_projection);
+		WriteFloat(m_front);
+		WriteFloat(m_back);
+	}
+}
+
+void Direct3DRMCaptureRenderer::StopRecording()
+{
+	m_recording = false;
+	if (m_file) {
+		if (!m_buffer.empty()) {
+			SDL_RWwrite(m_file, m_buffer.data(), m_buffer.size(), 1);
+		}
+		SDL_RWclose(m_file);
+		m_file = nullptr;
+	}
+	m_buffer.clear();
+}
+
+void Direct3DRMCaptureRenderer::Write(const void* data, size_t size)
+{
+	const Uint8* bytes = static_cast<const Uint8*>(data);
+	m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+}
+
+void Direct3DRMCaptureRenderer::WriteUint32(Uint32 value)
+{
+	value = SDL_SwapLE32(value);
+	Write(&value, sizeof(value));
+}
+
+void Direct3DRMCaptureRenderer::WriteFloats(const float* values, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		float value = SDL_SwapFloatLE(values[i]);
+		Write(&value, sizeof(value));
+	}
+}
+
+void Direct3DRMCaptureRenderer::WriteColor(const SDL_Color& color)
+{
+	Uint8 rgba[4] = {color.r, color.g, color.b, color.a};
+	Write(rgba, sizeof(rgba));
+}
+
+void Direct3DRMCaptureRenderer::WriteVector(const D3DVECTOR& vector)
+{
+	WriteFloat(vector.x);
+	WriteFloat(vector.y);
+	WriteFloat(vector.z);
+}
+
+void Direct3DRMCaptureRenderer::WriteInstance(const DrawInstance& instance)
+{
+	WriteMatrix(instance.modelViewMatrix);
+	WriteFloats(&instance.normalMatrix[0][0], 9);
+}
+
+Uint32 Direct3DRMCaptureRenderer::WriteTexture(IDirect3DRMTexture* iTexture)
+{
+	auto texture = static_cast<Direct3DRMTextureImpl*>(iTexture);
+	auto it = m_textures.find(iTexture);
+	if (it == m_textures.end()) {
+		it = m_textures.emplace(iTexture, CapturedTexture{m_nextCaptureId++, texture->m_version, false}).first;
+		auto* ctx = new DestroyContext{this, iTexture};
+		iTexture->AddDestroyCallback(
+			[](IDirect3DRMObject* obj, void* arg) {
+				auto* ctx = static_cast<DestroyContext*>(arg);
+				ctx->renderer->OnTextureDestroyed(static_cast<IDirect3DRMTexture*>(ctx->object));
+				delete ctx;
+			},
+			ctx
+		);
+	}
+
+	CapturedTexture& captured = it->second;
+	if (captured.version != texture->m_version) {
+		captured.version = texture->m_version;
+		captured.written = false;
+	}
+	if (captured.written || !m_recording) {
+		return captured.captureId;
+	}
+
+	SDL_Surface* source = static_cast<DirectDrawSurfaceImpl*>(texture->m_surface)->m_surface;
+	// RGBA32 is the format with r, g, b, a in memory on either byte order
+	SDL_Surface* pixels = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_RGBA32, 0);
+	if (!pixels) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to convert captured texture: %s", SDL_GetError());
+		return captured.captureId;
+	}
+
+	WriteOp(CAPTURE_TEXTURE);
+	WriteUint32(captured.captureId);
+	WriteUint32(pixels->w);
+	WriteUint32(pixels->h);
+	for (int y = 0; y < pixels->h; ++y) {
+		Write(static_cast<Uint8*>(pixels->pixels) + y * pixels->pitch, pixels->w * 4);
+	}
+	SDL_FreeSurface(pixels);
+	captured.written = true;
+	return captured.captureId;
+}
+
+Uint32 Direct3DRMCaptureRenderer::WriteMesh(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup)
+{
+	auto it = m_meshes.find(mesh);
+	if (it == m_meshes.end()) {
+		it = m_meshes.emplace(mesh, std::vector<CapturedMesh>()).first;
+		auto* ctx = new DestroyContext{this, mesh};
+		mesh->AddDestroyCallback(
+			[](IDirect3DRMObject* obj, void* arg) {
+				auto* ctx = static_cast<DestroyContext*>(arg);
+				ctx->renderer->OnMeshDestroyed(static_cast<IDirect3DRMMesh*>(ctx->object));
+				delete ctx;
+			},
+			ctx
+		);
+	}
+
+	CapturedMesh* captured = nullptr;
+	for (CapturedMesh& group : it->second) {
+		if (group.meshGroup == meshGroup) {
+			captured = &group;
+			break;
+		}
+	}
+	if (!captured) {
+		it->second.push_back({m_nextCaptureId++, meshGroup, meshGroup->version, false});
+		captured = &it->second.back();
+	}
+
+	if (captured->version != meshGroup->version) {
+		captured->version = meshGroup->version;
+		captured->written = false;
+	}
+	if (captured->written || !m_recording) {
+		return captured->captureId;
+	}
+
+	Uint32 texture = meshGroup->texture ? WriteTexture(meshGroup->texture) : NO_TEXTURE_ID;
+
+	WriteOp(CAPTURE_MESH);
+	WriteUint32(captured->captureId);
+	WriteColor(meshGroup->color);
+	WriteUint32(static_cast<Uint32>(meshGroup->quality));
+	WriteUint32(texture);
+	WriteUint32(meshGroup->vertices.size());
+	WriteUint32(meshGroup->indices.size());
+	for (const D3DRMVERTEX& vertex : meshGroup->vertices) {
+		WriteVector(vertex.position);
+		WriteVector(vertex.normal);
+		WriteFloat(vertex.texCoord.u);
+		WriteFloat(vertex.texCoord.v);
+	}
+	for (DWORD index : meshGroup->indices) {
+		WriteUint32(index);
+	}
+	captured->written = true;
+	return captured->captureId;
+}
+
+Uint32 Direct3DRMCaptureRenderer::CaptureTextureId(Uint32 textureId)
+{
+	auto it = m_textureIds.find(textureId);
+	if (textureId == NO_TEXTURE_ID || it == m_textureIds.end()) {
+		return NO_TEXTURE_ID;
+	}
+	return WriteTexture(it->second);
+}
+
+Uint32 Direct3DRMCaptureRenderer::CaptureMeshId(DWORD meshId)
+{
+	auto it = m_meshIds.find(meshId);
+	if (it == m_meshIds.end()) {
+		return NO_TEXTURE_ID;
+	}
+	return WriteMesh(it->second.first, it->second.second);
+}
+
+void Direct3DRMCaptureRenderer::WriteAppearance(const Appearance& appearance)
+{
+	WriteColor(appearance.color);
+	WriteFloat(appearance.shininess);
+	WriteUint32(CaptureTextureId(appearance.textureId));
+	WriteUint32(appearance.flat);
+}
+
+void Direct3DRMCaptureRenderer::OnTextureDestroyed(IDirect3DRMTexture* texture)
+{
+	auto it = m_textures.find(texture);
+	if (it == m_textures.end()) {
+		return;
+	}
+	if (m_recording) {
+		WriteOp(CAPTURE_RELEASE_TEXTURE);
+		WriteUint32(it->second.captureId);
+	}
+	m_textures.erase(it);
+}
+
+void Direct3DRMCaptureRenderer::OnMeshDestroyed(IDirect3DRMMesh* mesh)
+{
+	auto it = m_meshes.find(mesh);
+	if (it == m_meshes.end()) {
+		return;
+	}
+	if (m_recording) {
+		for (const CapturedMesh& group : it->second) {
+			WriteOp(CAPTURE_RELEASE_MESH);
+			WriteUint32(group.captureId);
+		}
+	}
+	m_meshes.erase(it);
+}
+
+void Direct3DRMCaptureRenderer::PushLights(const SceneLight* lights, size_t count)
+{
+	StartRecording();
+	if (m_recording) {
+		WriteOp(CAPTURE_PUSH_LIGHTS);
+		WriteUint32(count);
+		for (size_t i = 0; i < count; ++i) {
+			const SceneLight& light = lights[i];
+			WriteFloat(light.color.r);
+			WriteFloat(light.color.g);
+			WriteFloat(light.color.b);
+			WriteFloat(light.color.a);
+			WriteVector(light.position);
+			WriteFloat(light.positional);
+			WriteVector(light.direction);
+			WriteFloat(light.directional);
+		}
+	}
+	m_renderer->PushLights(lights, count);
+}
+
+void Direct3DRMCaptureRenderer::SetProjection(const D3DRMMATRIX4D& projection, D3DVALUE front, D3DVALUE back)
+{
+	memcpy(m_projection, projection, sizeof(D3DRMMATRIX4D));
+	m_front = front;
+	m_back = back;
+	m_hasProjection = true;
+	if (m_recording) {
+		WriteOp(CAPTURE_SET_PROJECTION);
+		WriteMatrix(m_projection);
+		WriteFloat(front);
+		WriteFloat(back);
+	}
+	m_renderer->SetProjection(projection, front, back);
+}
+
+void Direct3DRMCaptureRenderer::SetFrustumPlanes(const Plane* frustumPlanes)
+{
+	if (m_recording) {
+		WriteOp(CAPTURE_SET_FRUSTUM_PLANES);
+		for (int i = 0; i < 6; ++i) {
+			WriteVector(frustumPlanes[i].normal);
+			WriteFloat(frustumPlanes[i].d);
+		}
+	}
+	m_renderer->SetFrustumPlanes(frustumPlanes);
+}
+
+Uint32 Direct3DRMCaptureRenderer::GetTextureId(IDirect3DRMTexture* texture)
+{
+	Uint32 id = m_renderer->GetTextureId(texture);
+	m_textureIds[id] = texture;
+	if (m_recording) {
+		Uint32 captureId = WriteTexture(texture);
+		WriteOp(CAPTURE_GET_TEXTURE_ID);
+		WriteUint32(captureId);
+	}
+	return id;
+}
+
+Uint32 Direct3DRMCaptureRenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup)
+{
+	Uint32 id = m_renderer->GetMeshId(mesh, meshGroup);
+	m_meshIds[id] = {mesh, meshGroup};
+	if (m_recording) {
+		Uint32 captureId = WriteMesh(mesh, meshGroup);
+		WriteOp(CAPTURE_GET_MESH_ID);
+		WriteUint32(captureId);
+	}
+	return id;
+}
+
+DWORD Direct3DRMCaptureRenderer::GetWidth()
+{
+	return m_renderer->GetWidth();
+}
+
+DWORD Direct3DRMCaptureRenderer::GetHeight()
+{
+	return m_renderer->GetHeight();
+}
+
+void Direct3DRMCaptureRenderer::GetDesc(D3DDEVICEDESC* halDesc, D3DDEVICEDESC* helDesc)
+{
+	m_renderer->GetDesc(halDesc, helDesc);
+}
+
+const char* Direct3DRMCaptureRenderer::GetName()
+{
+	return m_renderer->GetName();
+}
+
+HRESULT Direct3DRMCaptureRenderer::BeginFrame()
+{
+	StartRecording();
+	if (m_recording) {
+		WriteOp(CAPTURE_BEGIN_FRAME);
+	}
+	return m_renderer->BeginFrame();
+}
+
+void Direct3DRMCaptureRenderer::EnableTransparency()
+{
+	if (m_recording) {
+		WriteOp(CAPTURE_ENABLE_TRANSPARENCY);
+	}
+	m_renderer->EnableTransparency();
+}
+
+void Direct3DRMCaptureRenderer::SubmitDraw(
+	DWORD meshId,
+	const D3DRMMATRIX4D& modelViewMatrix,
+	const Matrix3x3& normalMatrix,
+	const Appearance& appearance
+)
+{
+	if (m_recording) {
+		Uint32 captureId = CaptureMeshId(meshId);
+		DrawInstance instance;
+		memcpy(instance.modelViewMatrix, modelViewMatrix, sizeof(D3DRMMATRIX4D));
+		memcpy(instance.normalMatrix, normalMatrix, sizeof(Matrix3x3));
+		WriteOp(CAPTURE_SUBMIT_DRAW);
+		WriteUint32(captureId);
+		WriteInstance(instance);
+		WriteAppearance(appearance);
+	}
+	m_renderer->SubmitDraw(meshId, modelViewMatrix, normalMatrix, appearance);
+}
+
+void Direct3DRMCaptureRenderer::SubmitDrawInstanced(
+	DWORD meshId,
+	const DrawInstance* instances,
+	size_t count,
+	const Appearance& appearance
+)
+{
+	if (m_recording) {
+		Uint32 captureId = CaptureMeshId(meshId);
+		WriteOp(CAPTURE_SUBMIT_DRAW_INSTANCED);
+		WriteUint32(captureId);
+		WriteUint32(count);
+		for (size_t i = 0; i < count; ++i) {
+			WriteInstance(instances[i]);
+		}
+		WriteAppearance(appearance);
+	}
+	m_renderer->SubmitDrawInstanced(meshId, instances, count, appearance);
+}
+
+bool Direct3DRMCaptureRenderer::BuildOcclusionPyramid()
+{
+	if (m_recording) {
+		WriteOp(CAPTURE_BUILD_OCCLUSION_PYRAMID);
+	}
+	return m_renderer->BuildOcclusionPyramid();
+}
+
+bool Direct3DRMCaptureRenderer::IsBoxOccluded(const D3DRMBOX& viewBox)
+{
+	if (m_recording) {
+		WriteOp(CAPTURE_IS_BOX_OCCLUDED);
+		WriteVector(viewBox.min);
+		WriteVector(viewBox.max);
+	}
+	return m_renderer->IsBoxOccluded(viewBox);
+}
+
+HRESULT Direct3DRMCaptureRenderer::FinalizeFrame()
+{
+	HRESULT result = m_renderer->FinalizeFrame();
+	if (m_recording) {
+		WriteOp(CAPTURE_FINALIZE_FRAME);
+		SDL_RWwrite(m_file, m_buffer.data(), m_buffer.size(), 1);
+		m_buffer.clear();
+		if (--m_frames <= 0) {
+			StopRecording();
+		}
+	}
+	else if (m_skipFrames > 0) {
+		m_skipFrames--;
+	}
+	return result;
+}
+
+SDL_Surface* Direct3DRMCaptureRenderer::GetOutputSurface()
+{
+	return m_renderer->GetOutputSurface();
+}
@@ -0,0 +1,491 @@
+#include "d3drmmesh_impl.h"
+#include "d3drmrenderer_capture.h"
+#ifdef USE_OPENGL1
+#include "d3drmrenderer_opengl1.h"
+#endif
+#ifdef USE_OPENGLES2
+#include "d3drmrenderer_opengles2.h"
+#endif
+#ifdef _WIN32
+#include "d3drmrenderer_directx9.h"
+#endif
+#ifdef USE_SDL3GPU
+#include "d3drmrenderer_sdl3gpu.h"
+#endif
+#include "d3drmrenderer_software.h"
+#include "ddsurface_impl.h"
+
+#include <SDL2/SDL.h>
+
+RenderCaptureReplay::RenderCaptureReplay(IDirect3DRM* d3drm) : m_d3drm(d3drm)
+{
+}
+
+RenderCaptureReplay::~RenderCaptureReplay()
+{
+	while (!m_meshes.empty()) {
+		ReleaseMesh(m_meshes.begin()->first);
+	}
+	while (!m_textures.empty()) {
+		ReleaseTexture(m_textures.begin()->first);
+	}
+}
+
+bool RenderCaptureReplay::Open(const char* path)
+{
+	SDL_RWops* file = SDL_RWFromFile(path, "rb");
+	if (!file) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open capture file %s: %s", path, SDL_GetError());
+		return false;
+	}
+
+	// Everything is read up front so file access does not end up in the timings
+	Sint64 size = SDL_RWsize(file);
+	m_data.resize(size > 0 ? size : 0);
+	bool ok = !m_data.empty() && SDL_RWread(file, m_data.data(), m_data.size(), 1) == 1;
+	SDL_RWclose(file);
+
+	m_offset = 0;
+	ok = ok && ReadUint32(m_header.magic) && ReadUint32(m_header.version) && ReadUint32(m_header.width) &&
+		 ReadUint32(m_header.height);
+	if (!ok || m_header.magic != CAPTURE_MAGIC || m_header.version != CAPTURE_VERSION) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s is not a capture file", path);
+		return false;
+	}
+	return true;
+}
+
+const void* RenderCaptureReplay::Read(size_t size)
+{
+	if (m_data.size() - m_offset < size) {
+		m_offset = m_data.size();
+		return nullptr;
+	}
+	const void* data = m_data.data() + m_offset;
+	m_offset += size;
+	return data;
+}
+
+bool RenderCaptureReplay::ReadUint8(Uint8& value)
+{
+	const void* data = Read(sizeof(value));
+	if (data) {
+		value = *static_cast<const Uint8*>(data);
+	}
+	return data;
+}
+
+bool RenderCaptureReplay::ReadUint32(Uint32& value)
+{
+	const void* data = Read(sizeof(value));
+	if (data) {
+		SDL_memcpy(&value, data, sizeof(value));
+		value = SDL_SwapLE32(value);
+	}
+	return data;
+}
+
+bool RenderCaptureReplay::ReadFloats(float* values, size_t count)
+{
+	const Uint8* data = static_cast<const Uint8*>(Read(count * sizeof(float)));
+	if (!data) {
+		return false;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		SDL_memcpy(&values[i], data + i * sizeof(float), sizeof(float));
+		values[i] = SDL_SwapFloatLE(values[i]);
+	}
+	return true;
+}
+
+bool RenderCaptureReplay::ReadColor(SDL_Color& color)
+{
+	const Uint8* rgba = static_cast<const Uint8*>(Read(4));
+	if (rgba) {
+		color = {rgba[0], rgba[1], rgba[2], rgba[3]};
+	}
+	return rgba;
+}
+
+bool RenderCaptureReplay::ReadVector(D3DVECTOR& vector)
+{
+	return ReadFloat(vector.x) && ReadFloat(vector.y) && ReadFloat(vector.z);
+}
+
+bool RenderCaptureReplay::ReadInstance(DrawInstance& instance)
+{
+	return ReadMatrix(instance.modelViewMatrix) && ReadFloats(&instance.normalMatrix[0][0], 9);
+}
+
+bool RenderCaptureReplay::ReadAppearance(Appearance& appearance)
+{
+	return ReadColor(appearance.color) && ReadFloat(appearance.shininess) && ReadUint32(appearance.textureId) &&
+		   ReadUint32(appearance.flat);
+}
+
+bool RenderCaptureReplay::ReadTexture()
+{
+	Uint32 captureId, width, height;
+	if (!ReadUint32(captureId) || !ReadUint32(width) || !ReadUint32(height)) {
+		return false;
+	}
+	const Uint8* pixels = static_cast<const Uint8*>(Read((size_t) width * height * 4));
+	if (!pixels) {
+		return false;
+	}
+
+	// Redefined textures are updated in place, so the renderer sees a version change as in the game
+	auto it = m_textures.find(captureId);
+	if (it != m_textures.end()) {
+		SDL_Surface* surface = static_cast<DirectDrawSurfaceImpl*>(it->second.surface)->m_surface;
+		if ((Uint32) surface->w != width || (Uint32) surface->h != height) {
+			ReleaseTexture(captureId);
+			it = m_textures.end();
+		}
+	}
+	if (it == m_textures.end()) {
+		ReplayTexture texture;
+		texture.surface = new DirectDrawSurfaceImpl(width, height, SDL_PIXELFORMAT_RGBA32);
+		m_d3drm->CreateTextureFromSurface(texture.surface, &texture.texture);
+		texture.id = NO_TEXTURE_ID;
+		it = m_textures.emplace(captureId, texture).first;
+	}
+	else {
+		it->second.texture->Changed(TRUE, FALSE);
+		it->second.id = NO_TEXTURE_ID;
+	}
+
+	SDL_Surface* surface = static_cast<DirectDrawSurfaceImpl*>(it->second.surface)->m_surface;
+	for (Uint32 y = 0; y < height; ++y) {
+		SDL_memcpy(static_cast<Uint8*>(surface->pixels) + y * surface->pitch, pixels + y * width * 4, width * 4);
+	}
+	return true;
+}
+
+bool RenderCaptureReplay::ReadMesh()
+{
+	Uint32 captureId;
+	CaptureMeshDesc desc;
+	if (!ReadUint32(captureId) || !ReadColor(desc.color) || !ReadUint32(desc.quality) || !ReadUint32(desc.texture) ||
+		!ReadUint32(desc.vertexCount) || !ReadUint32(desc.indexCount) || !HasRecords(desc.vertexCount) ||
+		!HasRecords(desc.indexCount)) {
+		return false;
+	}
+
+	std::vector<D3DRMVERTEX> groupVertices(desc.vertexCount);
+	for (D3DRMVERTEX& vertex : groupVertices) {
+		if (!ReadVector(vertex.position) || !ReadVector(vertex.normal) || !ReadFloat(vertex.texCoord.u) ||
+			!ReadFloat(vertex.texCoord.v)) {
+			return false;
+		}
+	}
+	std::vector<unsigned int> faces(desc.indexCount);
+	for (unsigned int& index : faces) {
+		Uint32 value;
+		if (!ReadUint32(value)) {
+			return false;
+		}
+		index = value;
+	}
+
+	// A changed mesh group gets a new mesh, which costs the renderer the same upload
+	ReleaseMesh(captureId);
+
+	ReplayMesh mesh;
+	D3DRMGROUPINDEX group;
+	m_d3drm->CreateMesh(&mesh.mesh);
+	mesh.mesh->AddGroup(desc.vertexCount, desc.indexCount / 3, 3, faces.data(), &group);
+	mesh.mesh->SetVertices(group, 0, desc.vertexCount, groupVertices.data());
+	mesh.mesh->SetGroupColor(group, desc.color.a << 24 | desc.color.r << 16 | desc.color.g << 8 | desc.color.b);
+	mesh.mesh->SetGroupQuality(group, static_cast<D3DRMRENDERQUALITY>(desc.quality));
+	auto texture = m_textures.find(desc.texture);
+	if (texture != m_textures.end()) {
+		mesh.mesh->SetGroupTexture(group, texture->second.texture);
+	}
+	mesh.id = NO_TEXTURE_ID;
+	m_meshes.emplace(captureId, mesh);
+	return true;
+}
+
+void RenderCaptureReplay::ReleaseTexture(Uint32 captureId)
+{
+	auto it = m_textures.find(captureId);
+	if (it == m_textures.end()) {
+		return;
+	}
+	it->second.texture->Release();
+	it->second.surface->Release();
+	m_textures.erase(it);
+}
+
+void RenderCaptureReplay::ReleaseMesh(Uint32 captureId)
+{
+	auto it = m_meshes.find(captureId);
+	if (it == m_meshes.end()) {
+		return;
+	}
+	it->second.mesh->Release();
+	m_meshes.erase(it);
+}
+
+bool RenderCaptureReplay::ReplayFrame(Direct3DRMRenderer* renderer)
+{
+	// Renderer IDs are looked up when a capture first asks for them, which is timed like any other call
+	auto textureId = [&](Uint32 captureId) {
+		auto it = m_textures.find(captureId);
+		if (it == m_textures.end()) {
+			return (Uint32) NO_TEXTURE_ID;
+		}
+		if (it->second.id == NO_TEXTURE_ID) {
+			Uint64 start = SDL_GetPerformanceCounter();
+			it->second.id = renderer->GetTextureId(it->second.texture);
+			m_stats[CAPTURE_GET_TEXTURE_ID].ticks += SDL_GetPerformanceCounter() - start;
+			m_stats[CAPTURE_GET_TEXTURE_ID].calls++;
+		}
+		return it->second.id;
+	};
+	auto meshId = [&](Uint32 captureId) {
+		auto it = m_meshes.find(captureId);
+		if (it == m_meshes.end()) {
+			return (Uint32) NO_TEXTURE_ID;
+		}
+		if (it->second.id == NO_TEXTURE_ID) {
+			auto* mesh = static_cast<Direct3DRMMeshImpl*>(it->second.mesh);
+			Uint64 start = SDL_GetPerformanceCounter();
+			it->second.id = renderer->GetMeshId(mesh, &mesh->GetGroup(0));
+			m_stats[CAPTURE_GET_MESH_ID].ticks += SDL_GetPerformanceCounter() - start;
+			m_stats[CAPTURE_GET_MESH_ID].calls++;
+		}
+		return it->second.id;
+	};
+
+	Uint8 op;
+	while (ReadUint8(op)) {
+		if (op >= CAPTURE_OP_COUNT) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown capture op %d", op);
+			return false;
+		}
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		switch (op) {
+		case CAPTURE_TEXTURE:
+			if (!ReadTexture()) {
+				return false;
+			}
+			continue;
+		case CAPTURE_RELEASE_TEXTURE:
+		case CAPTURE_RELEASE_MESH: {
+			Uint32 captureId;
+			if (!ReadUint32(captureId)) {
+				return false;
+			}
+			op == CAPTURE_RELEASE_TEXTURE ? ReleaseTexture(captureId) : ReleaseMesh(captureId);
+			continue;
+		}
+		case CAPTURE_MESH:
+			if (!ReadMesh()) {
+				return false;
+			}
+			continue;
+		case CAPTURE_GET_TEXTURE_ID:
+		case CAPTURE_GET_MESH_ID: {
+			Uint32 captureId;
+			if (!ReadUint32(captureId)) {
+				return false;
+			}
+			op == CAPTURE_GET_TEXTURE_ID ? textureId(captureId) : meshId(captureId);
+			continue;
+		}
+		case CAPTURE_PUSH_LIGHTS: {
+			Uint32 count;
+			if (!ReadUint32(count) || !HasRecords(count)) {
+				return false;
+			}
+			m_lights.resize(count);
+			for (SceneLight& light : m_lights) {
+				if (!ReadFloat(light.color.r) || !ReadFloat(light.color.g) || !ReadFloat(light.color.b) ||
+					!ReadFloat(light.color.a) || !ReadVector(light.position) || !ReadFloat(light.positional) ||
+					!ReadVector(light.direction) || !ReadFloat(light.directional)) {
+					return false;
+				}
+			}
+			start = SDL_GetPerformanceCounter();
+			renderer->PushLights(m_lights.data(), m_lights.size());
+			break;
+		}
+		case CAPTURE_SET_PROJECTION: {
+			D3DRMMATRIX4D projection;
+			D3DVALUE front, back;
+			if (!ReadMatrix(projection) || !ReadFloat(front) || !ReadFloat(back)) {
+				return false;
+			}
+			start = SDL_GetPerformanceCounter();
+			renderer->SetProjection(projection, front, back);
+			break;
+		}
+		case CAPTURE_SET_FRUSTUM_PLANES: {
+			Plane planes[6];
+			for (Plane& plane : planes) {
+				if (!ReadVector(plane.normal) || !ReadFloat(plane.d)) {
+					return false;
+				}
+			}
+			start = SDL_GetPerformanceCounter();
+			renderer->SetFrustumPlanes(planes);
+			break;
+		}
+		case CAPTURE_BEGIN_FRAME: {
+			// The viewport clears the output before rendering, which is not a renderer call
+			SDL_Surface* output = renderer->GetOutputSurface();
+			if (output) {
+				SDL_FillRect(output, nullptr, SDL_MapRGB(output->format, 0, 0, 0));
+			}
+			start = SDL_GetPerformanceCounter();
+			renderer->BeginFrame();
+			break;
+		}
+		case CAPTURE_ENABLE_TRANSPARENCY:
+			renderer->EnableTransparency();
+			break;
+		case CAPTURE_SUBMIT_DRAW: {
+			Uint32 mesh;
+			DrawInstance instance;
+			Appearance appearance;
+			if (!ReadUint32(mesh) || !ReadInstance(instance) || !ReadAppearance(appearance)) {
+				return false;
+			}
+			Uint32 id = meshId(mesh);
+			appearance.textureId = textureId(appearance.textureId);
+			if (id == NO_TEXTURE_ID) {
+				continue;
+			}
+			start = SDL_GetPerformanceCounter();
+			renderer->SubmitDraw(id, instance.modelViewMatrix, instance.normalMatrix, appearance);
+			break;
+		}
+		case CAPTURE_SUBMIT_DRAW_INSTANCED: {
+			Uint32 mesh, count;
+			if (!ReadUint32(mesh) || !ReadUint32(count) || !HasRecords(count)) {
+				return false;
+			}
+			m_instances.resize(count);
+			for (DrawInstance& instance : m_instances) {
+				if (!ReadInstance(instance)) {
+					return false;
+				}
+			}
+			Appearance appearance;
+			if (!ReadAppearance(appearance)) {
+				return false;
+			}
+			Uint32 id = meshId(mesh);
+			appearance.textureId = textureId(appearance.textureId);
+			if (id == NO_TEXTURE_ID) {
+				continue;
+			}
+			start = SDL_GetPerformanceCounter();
+			renderer->SubmitDrawInstanced(id, m_instances.data(), m_instances.size(), appearance);
+			break;
+		}
+		case CAPTURE_BUILD_OCCLUSION_PYRAMID:
+			renderer->BuildOcclusionPyramid();
+			break;
+		case CAPTURE_IS_BOX_OCCLUDED: {
+			D3DRMBOX box;
+			if (!ReadVector(box.min) || !ReadVector(box.max)) {
+				return false;
+			}
+			start = SDL_GetPerformanceCounter();
+			renderer->IsBoxOccluded(box);
+			break;
+		}
+		case CAPTURE_FINALIZE_FRAME:
+			renderer->FinalizeFrame();
+			break;
+		}
+
+		m_stats[op].ticks += SDL_GetPerformanceCounter() - start;
+		m_stats[op].calls++;
+		if (op == CAPTURE_FINALIZE_FRAME) {
+			return true;
+		}
+	}
+	return false;
+}
+
+const char* RenderCaptureReplay::GetOpName(CaptureOp op)
+{
+	switch (op) {
+	case CAPTURE_TEXTURE:
+		return "Texture";
+	case CAPTURE_RELEASE_TEXTURE:
+		return "ReleaseTexture";
+	case CAPTURE_MESH:
+		return "Mesh";
+	case CAPTURE_RELEASE_MESH:
+		return "ReleaseMesh";
+	case CAPTURE_GET_TEXTURE_ID:
+		return "GetTextureId";
+	case CAPTURE_GET_MESH_ID:
+		return "GetMeshId";
+	case CAPTURE_PUSH_LIGHTS:
+		return "PushLights";
+	case CAPTURE_SET_PROJECTION:
+		return "SetProjection";
+	case CAPTURE_SET_FRUSTUM_PLANES:
+		return "SetFrustumPlanes";
+	case CAPTURE_BEGIN_FRAME:
+		return "BeginFrame";
+	case CAPTURE_ENABLE_TRANSPARENCY:
+		return "EnableTransparency";
+	case CAPTURE_SUBMIT_DRAW:
+		return "SubmitDraw";
+	case CAPTURE_SUBMIT_DRAW_INSTANCED:
+		return "SubmitDrawInstanced";
+	case CAPTURE_BUILD_OCCLUSION_PYRAMID:
+		return "BuildOcclusionPyramid";
+	case CAPTURE_IS_BOX_OCCLUDED:
+		return "IsBoxOccluded";
+	case CAPTURE_FINALIZE_FRAME:
+		return "FinalizeFrame";
+	default:
+		return "?";
+	}
+}
+
+Direct3DRMRenderer* CreateReplayRenderer(const char* name, DWORD width, DWORD height)
+{
+	if (SDL_strcasecmp(name, "software") == 0) {
+		return Direct3DRMSoftwareRenderer::CreateOffscreen(width, height);
+	}
+
+	Direct3DRMRenderer* renderer = nullptr;
+#ifdef USE_SDL3GPU
+	if (SDL_strcasecmp(name, "sdl3gpu") == 0) {
+		renderer = Direct3DRMSDL3GPURenderer::Create(width, height);
+	}
+#endif
+#ifdef USE_OPENGLES2
+	if (SDL_strcasecmp(name, "opengles2") == 0) {
+		renderer = OpenGLES2Renderer::Create(width, height);
+	}
+#endif
+#ifdef USE_OPENGL1
+	if (SDL_strcasecmp(name, "opengl1") == 0) {
+		renderer = OpenGL1Renderer::Create(width, height);
+	}
+#endif
+#ifdef _WIN32
+	if (SDL_strcasecmp(name, "directx9") == 0) {
+		renderer = DirectX9Renderer::Create(width, height);
+	}
+#endif
+	if (!renderer) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Renderer %s is not available", name);
+		return nullptr;
+	}
+	if (!DDBackBuffer) {
+		DDBackBuffer = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA8888);
+	}
+	return renderer;
+}
@@ -64,8 +64,10 @@ void DirectX9Renderer::AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture*
 			if (cache.dxTexture) {
 				ReleaseD3DTexture(cache.dxTexture);
 				cache.dxTexture = nullptr;
-				cache.texture = nullptr;
 			}
+			// A failed re-upload leaves no handle, but the ID still maps to this texture
+			cache.texture = nullptr;
+			ctx->renderer->m_textureIds.Release(ctx->textureId);
 			delete ctx;
 		},
 		ctx
@@ -77,22 +79,21 @@ Uint32 DirectX9Renderer::GetTextureId(IDirect3DRMTexture* iTexture)
 	auto texture = static_cast<Direct3DRMTextureImpl*>(iTexture);
 	auto surface = static_cast<DirectDrawSurfaceImpl*>(texture->m_surface);
 
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& tex = m_textures[i];
-		if (tex.texture == texture) {
-			if (tex.version != texture->m_version) {
-				if (tex.dxTexture) {
-					ReleaseD3DTexture(tex.dxTexture);
-					tex.dxTexture = nullptr;
-				}
-				tex.dxTexture = UploadSurfaceToD3DTexture(surface->m_surface);
-				if (!tex.dxTexture) {
-					return NO_TEXTURE_ID;
-				}
-				tex.version = texture->m_version;
+	Uint32 id;
+	if (m_textureIds.Find(texture, id)) {
+		auto& tex = m_textures[id];
+		if (tex.version != texture->m_version) {
+			if (tex.dxTexture) {
+				ReleaseD3DTexture(tex.dxTexture);
+				tex.dxTexture = nullptr;
+			}
+			tex.dxTexture = UploadSurfaceToD3DTexture(surface->m_surface);
+			if (!tex.dxTexture) {
+				return NO_TEXTURE_ID;
 			}
-			return i;
+			tex.version = texture->m_version;
 		}
+		return id;
 	}
 
 	IDirect3DTexture9* newTex = UploadSurfaceToD3DTexture(surface->m_surface);
@@ -100,20 +101,10 @@ Uint32 DirectX9Renderer::GetTextureId(IDirect3DRMTexture* iTexture)
 		return NO_TEXTURE_ID;
 	}
 
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& tex = m_textures[i];
-		if (!tex.texture) {
-			tex.texture = texture;
-			tex.version = texture->m_version;
-			tex.dxTexture = newTex;
-			AddTextureDestroyCallback(i, texture);
-			return i;
-		}
-	}
-
-	m_textures.push_back({texture, texture->m_version, newTex});
-	AddTextureDestroyCallback((Uint32) (m_textures.size() - 1), texture);
-	return (Uint32) (m_textures.size() - 1);
+	id = m_textureIds.Acquire(texture);
+	HandleSlot(m_textures, id) = {texture, texture->m_version, newTex};
+	AddTextureDestroyCallback(id, texture);
+	return id;
 }
 
 D3D9MeshCacheEntry UploadD3D9Mesh(const MeshGroup& meshGroup)
@@ -180,6 +171,7 @@ void DirectX9Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
 				cache.ibo = nullptr;
 			}
 			cache.meshGroup = nullptr;
+			ctx->renderer->m_meshIds.Release(ctx->id);
 
 			delete ctx;
 		},
@@ -189,27 +181,19 @@ void DirectX9Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
 
 Uint32 DirectX9Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup)
 {
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
-				cache = UploadD3D9Mesh(*meshGroup);
-			}
-			return i;
-		}
-	}
-
-	auto newCache = UploadD3D9Mesh(*meshGroup);
-
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		if (!m_meshs[i].meshGroup) {
-			m_meshs[i] = std::move(newCache);
-			return i;
+	Uint32 id;
+	if (m_meshIds.Find(meshGroup, id)) {
+		auto& cache = m_meshs[id];
+		if (cache.version != meshGroup->version) {
+			cache = UploadD3D9Mesh(*meshGroup);
 		}
+		return id;
 	}
 
-	m_meshs.push_back(std::move(newCache));
-	return static_cast<Uint32>(m_meshs.size() - 1);
+	id = m_meshIds.Acquire(meshGroup);
+	HandleSlot(m_meshs, id) = UploadD3D9Mesh(*meshGroup);
+	AddMeshDestroyCallback(id, mesh);
+	return id;
 }
 
 DWORD DirectX9Renderer::GetWidth()
@@ -140,8 +140,10 @@ void OpenGL1Renderer::AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture* t
 			if (cache.glTextureId != 0) {
 				glDeleteTextures(1, &cache.glTextureId);
 				cache.glTextureId = 0;
-				cache.texture = nullptr;
 			}
+			// A failed re-upload leaves no handle, but the ID still maps to this texture
+			cache.texture = nullptr;
+			ctx->renderer->m_textureIds.Release(ctx->textureId);
 			delete ctx;
 		},
 		ctx
@@ -153,30 +155,29 @@ Uint32 OpenGL1Renderer::GetTextureId(IDirect3DRMTexture* iTexture)
 	auto texture = static_cast<Direct3DRMTextureImpl*>(iTexture);
 	auto surface = static_cast<DirectDrawSurfaceImpl*>(texture->m_surface);
 
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& tex = m_textures[i];
-		if (tex.texture == texture) {
-			if (tex.version != texture->m_version) {
-				glDeleteTextures(1, &tex.glTextureId);
-				glGenTextures(1, &tex.glTextureId);
-				glBindTexture(GL_TEXTURE_2D, tex.glTextureId);
-
-				SDL_PixelFormat* fmt = SDL_AllocFormat(SDL_PIXELFORMAT_ABGR8888);
-				SDL_Surface* surf = SDL_ConvertSurface(surface->m_surface, fmt, 0);
-				if (!surf) {
-					SDL_FreeFormat(fmt);
-					return NO_TEXTURE_ID;
-				}
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, surf->w, surf->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surf->pixels);
-				SDL_FreeSurface(surf);
+	Uint32 id;
+	if (m_textureIds.Find(texture, id)) {
+		auto& tex = m_textures[id];
+		if (tex.version != texture->m_version) {
+			glDeleteTextures(1, &tex.glTextureId);
+			glGenTextures(1, &tex.glTextureId);
+			glBindTexture(GL_TEXTURE_2D, tex.glTextureId);
+
+			SDL_PixelFormat* fmt = SDL_AllocFormat(SDL_PIXELFORMAT_ABGR8888);
+			SDL_Surface* surf = SDL_ConvertSurface(surface->m_surface, fmt, 0);
+			if (!surf) {
 				SDL_FreeFormat(fmt);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-				tex.version = texture->m_version;
+				return NO_TEXTURE_ID;
 			}
-			return i;
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, surf->w, surf->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surf->pixels);
+			SDL_FreeSurface(surf);
+			SDL_FreeFormat(fmt);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+			tex.version = texture->m_version;
 		}
+		return id;
 	}
 
 	GLuint texId;
@@ -195,20 +196,10 @@ Uint32 OpenGL1Renderer::GetTextureId(IDirect3DRMTexture* iTexture)
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& tex = m_textures[i];
-		if (!tex.texture) {
-			tex.texture = texture;
-			tex.version = texture->m_version;
-			tex.glTextureId = texId;
-			AddTextureDestroyCallback(i, texture);
-			return i;
-		}
-	}
-
-	m_textures.push_back({texture, texture->m_version, texId});
-	AddTextureDestroyCallback((Uint32) (m_textures.size() - 1), texture);
-	return (Uint32) (m_textures.size() - 1);
+	id = m_textureIds.Acquire(texture);
+	HandleSlot(m_textures, id) = {texture, texture->m_version, texId};
+	AddTextureDestroyCallback(id, texture);
+	return id;
 }
 
 GLMeshCacheEntry GLUploadMesh(const MeshGroup& meshGroup, bool useVBOs)
@@ -309,6 +300,7 @@ void OpenGL1Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
 				glDeleteBuffers(1, &cache.vboTexcoords);
 				glDeleteBuffers(1, &cache.ibo);
 			}
+			ctx->renderer->m_meshIds.Release(ctx->id);
 			delete ctx;
 		},
 		ctx
@@ -317,30 +309,19 @@ void OpenGL1Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
 
 Uint32 OpenGL1Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup)
 {
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
-				cache = std::move(GLUploadMesh(*meshGroup, m_useVBOs));
-			}
-			return i;
-		}
-	}
-
-	auto newCache = GLUploadMesh(*meshGroup, m_useVBOs);
-
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
-			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
-			return i;
+	Uint32 id;
+	if (m_meshIds.Find(meshGroup, id)) {
+		auto& cache = m_meshs[id];
+		if (cache.version != meshGroup->version) {
+			cache = std::move(GLUploadMesh(*meshGroup, m_useVBOs));
 		}
+		return id;
 	}
 
-	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
-	return (Uint32) (m_meshs.size() - 1);
+	id = m_meshIds.Acquire(meshGroup);
+	HandleSlot(m_meshs, id) = GLUploadMesh(*meshGroup, m_useVBOs);
+	AddMeshDestroyCallback(id, mesh);
+	return id;
 }
 
 DWORD OpenGL1Renderer::GetWidth()
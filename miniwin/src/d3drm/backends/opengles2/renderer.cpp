@@ -268,8 +268,10 @@ void OpenGLES2Renderer::AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture*
 			if (cache.glTextureId != 0) {
 				glDeleteTextures(1, &cache.glTextureId);
 				cache.glTextureId = 0;
-				cache.texture = nullptr;
 			}
+			// A failed re-upload leaves no handle, but the ID still maps to this texture
+			cache.texture = nullptr;
+			ctx->renderer->m_textureIds.Release(ctx->textureId);
 			delete ctx;
 		},
 		ctx
@@ -281,27 +283,26 @@ Uint32 OpenGLES2Renderer::GetTextureId(IDirect3DRMTexture* iTexture)
 	auto texture = static_cast<Direct3DRMTextureImpl*>(iTexture);
 	auto surface = static_cast<DirectDrawSurfaceImpl*>(texture->m_surface);
 
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& tex = m_textures[i];
-		if (tex.texture == texture) {
-			if (tex.version != texture->m_version) {
-				glDeleteTextures(1, &tex.glTextureId);
-				glGenTextures(1, &tex.glTextureId);
-				glBindTexture(GL_TEXTURE_2D, tex.glTextureId);
-
-				SDL_Surface* surf = SDL_ConvertSurface(surface->m_surface, SDL_PIXELFORMAT_ABGR8888);
-				if (!surf) {
-					return NO_TEXTURE_ID;
-				}
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, surf->w, surf->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surf->pixels);
-				SDL_DestroySurface(surf);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-				tex.version = texture->m_version;
+	Uint32 id;
+	if (m_textureIds.Find(texture, id)) {
+		auto& tex = m_textures[id];
+		if (tex.version != texture->m_version) {
+			glDeleteTextures(1, &tex.glTextureId);
+			glGenTextures(1, &tex.glTextureId);
+			glBindTexture(GL_TEXTURE_2D, tex.glTextureId);
+
+			SDL_Surface* surf = SDL_ConvertSurface(surface->m_surface, SDL_PIXELFORMAT_ABGR8888);
+			if (!surf) {
+				return NO_TEXTURE_ID;
 			}
-			return i;
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, surf->w, surf->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surf->pixels);
+			SDL_DestroySurface(surf);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+			tex.version = texture->m_version;
 		}
+		return id;
 	}
 
 	GLuint texId;
@@ -317,20 +318,10 @@ Uint32 OpenGLES2Renderer::GetTextureId(IDirect3DRMTexture* iTexture)
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& tex = m_textures[i];
-		if (!tex.texture) {
-			tex.texture = texture;
-			tex.version = texture->m_version;
-			tex.glTextureId = texId;
-			AddTextureDestroyCallback(i, texture);
-			return i;
-		}
-	}
-
-	m_textures.push_back({texture, texture->m_version, texId});
-	AddTextureDestroyCallback((Uint32) (m_textures.size() - 1), texture);
-	return (Uint32) (m_textures.size() - 1);
+	id = m_textureIds.Acquire(texture);
+	HandleSlot(m_textures, id) = {texture, texture->m_version, texId};
+	AddTextureDestroyCallback(id, texture);
+	return id;
 }
 
 GLES2MeshCacheEntry GLES2UploadMesh(const MeshGroup& meshGroup)
@@ -417,6 +408,7 @@ void OpenGLES2Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
 			glDeleteBuffers(1, &cache.vboNormals);
 			glDeleteBuffers(1, &cache.vboTexcoords);
 			glDeleteBuffers(1, &cache.ibo);
+			ctx->renderer->m_meshIds.Release(ctx->id);
 			delete ctx;
 		},
 		ctx
@@ -425,30 +417,19 @@ void OpenGLES2Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
 
 Uint32 OpenGLES2Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup)
 {
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
-				cache = std::move(GLES2UploadMesh(*meshGroup));
-			}
-			return i;
-		}
-	}
-
-	auto newCache = GLES2UploadMesh(*meshGroup);
-
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
-			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
-			return i;
+	Uint32 id;
+	if (m_meshIds.Find(meshGroup, id)) {
+		auto& cache = m_meshs[id];
+		if (cache.version != meshGroup->version) {
+			cache = std::move(GLES2UploadMesh(*meshGroup));
 		}
+		return id;
 	}
 
-	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
-	return (Uint32) (m_meshs.size() - 1);
+	id = m_meshIds.Acquire(meshGroup);
+	HandleSlot(m_meshs, id) = GLES2UploadMesh(*meshGroup);
+	AddMeshDestroyCallback(id, mesh);
+	return id;
 }
 
 DWORD OpenGLES2Renderer::GetWidth()
@@ -395,8 +395,10 @@ void Direct3DRMSDL3GPURenderer::AddTextureDestroyCallback(Uint32 id, IDirect3DRM
 			if (cache.gpuTexture) {
 				SDL_ReleaseGPUTexture(ctx->renderer->m_device, cache.gpuTexture);
 				cache.gpuTexture = nullptr;
-				cache.texture = nullptr;
 			}
+			// A failed re-upload leaves no handle, but the ID still maps to this texture
+			cache.texture = nullptr;
+			ctx->renderer->m_textureIds.Release(ctx->id);
 			delete ctx;
 		},
 		ctx
@@ -472,19 +474,18 @@ Uint32 Direct3DRMSDL3GPURenderer::GetTextureId(IDirect3DRMTexture* iTexture)
 	auto surface = static_cast<DirectDrawSurfaceImpl*>(texture->m_surface);
 	SDL_Surface* surf = surface->m_surface;
 
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& tex = m_textures[i];
-		if (tex.texture == texture) {
-			if (tex.version != texture->m_version) {
-				SDL_ReleaseGPUTexture(m_device, tex.gpuTexture);
-				tex.gpuTexture = CreateTextureFromSurface(surf);
-				if (!tex.gpuTexture) {
-					return NO_TEXTURE_ID;
-				}
-				tex.version = texture->m_version;
+	Uint32 id;
+	if (m_textureIds.Find(texture, id)) {
+		auto& tex = m_textures[id];
+		if (tex.version != texture->m_version) {
+			SDL_ReleaseGPUTexture(m_device, tex.gpuTexture);
+			tex.gpuTexture = CreateTextureFromSurface(surf);
+			if (!tex.gpuTexture) {
+				return NO_TEXTURE_ID;
 			}
-			return i;
+			tex.version = texture->m_version;
 		}
+		return id;
 	}
 
 	SDL_GPUTexture* newTex = CreateTextureFromSurface(surf);
@@ -492,18 +493,10 @@ Uint32 Direct3DRMSDL3GPURenderer::GetTextureId(IDirect3DRMTexture* iTexture)
 		return NO_TEXTURE_ID;
 	}
 
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& tex = m_textures[i];
-		if (!tex.texture) {
-			tex = {texture, texture->m_version, newTex};
-			AddTextureDestroyCallback(i, texture);
-			return i;
-		}
-	}
-
-	m_textures.push_back({texture, texture->m_version, newTex});
-	AddTextureDestroyCallback((Uint32) (m_textures.size() - 1), texture);
-	return (Uint32) (m_textures.size() - 1);
+	id = m_textureIds.Acquire(texture);
+	HandleSlot(m_textures, id) = {texture, texture->m_version, newTex};
+	AddTextureDestroyCallback(id, texture);
+	return id;
 }
 
 SDL3MeshCache Direct3DRMSDL3GPURenderer::UploadMesh(const MeshGroup& meshGroup)
@@ -608,6 +601,7 @@ void Direct3DRMSDL3GPURenderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMes
 			auto& cache = ctx->renderer->m_meshs[ctx->id];
 			SDL_ReleaseGPUBuffer(ctx->renderer->m_device, cache.vertexBuffer);
 			cache.meshGroup = nullptr;
+			ctx->renderer->m_meshIds.Release(ctx->id);
 			delete ctx;
 		},
 		ctx
@@ -616,31 +610,20 @@ void Direct3DRMSDL3GPURenderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMes
 
 Uint32 Direct3DRMSDL3GPURenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup)
 {
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
-				SDL_ReleaseGPUBuffer(m_device, cache.vertexBuffer);
-				cache = std::move(UploadMesh(*meshGroup));
-			}
-			return i;
-		}
-	}
-
-	auto newCache = UploadMesh(*meshGroup);
-
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
-			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
-			return i;
+	Uint32 id;
+	if (m_meshIds.Find(meshGroup, id)) {
+		auto& cache = m_meshs[id];
+		if (cache.version != meshGroup->version) {
+			SDL_ReleaseGPUBuffer(m_device, cache.vertexBuffer);
+			cache = std::move(UploadMesh(*meshGroup));
 		}
+		return id;
 	}
 
-	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
-	return (Uint32) (m_meshs.size() - 1);
+	id = m_meshIds.Acquire(meshGroup);
+	HandleSlot(m_meshs, id) = UploadMesh(*meshGroup);
+	AddMeshDestroyCallback(id, mesh);
+	return id;
 }
 
 DWORD Direct3DRMSDL3GPURenderer::GetWidth()
@@ -0,0 +1,315 @@
+#include "d3drmrenderer_software.h"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define EDGE_RASTER_X86
+#endif
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define EDGE_RASTER_NEON
+#endif
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define EDGE_RASTER_WASM
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EDGE_TARGET(x) __attribute__((target(x)))
+#else
+#define EDGE_TARGET(x)
+#endif
+
+// Every kernel must write exactly the fragments WriteSpan writes for the same span, so each lane
+// repeats its arithmetic: t = (x - left.x) / span, then left + t * (right - left) for every
+// attribute, with no fused multiply-add (see miniwin/CMakeLists.txt).
+
+// The per-span constants WriteSpan derives from the span's end points
+struct SpanDeltas {
+	float x, span;
+	float z, dz;
+	float r, dr, g, dg, b, db;
+	float oneOverW, dOneOverW, uOverW, dUOverW, vOverW, dVOverW;
+};
+
+static inline SpanDeltas MakeSpanDeltas(const EdgeRow& row)
+{
+	const VertexXY& l = *row.left;
+	const VertexXY& r = *row.right;
+
+	SpanDeltas d;
+	d.x = l.x;
+	d.span = r.x - l.x;
+	d.z = l.z;
+	d.dz = r.z - l.z;
+	// Channels are subtracted as integers before the conversion, like in WriteSpan
+	d.r = l.color.r;
+	d.dr = (float) (r.color.r - l.color.r);
+	d.g = l.color.g;
+	d.dg = (float) (r.color.g - l.color.g);
+	d.b = l.color.b;
+	d.db = (float) (r.color.b - l.color.b);
+	d.oneOverW = l.one_over_w;
+	d.dOneOverW = r.one_over_w - l.one_over_w;
+	d.uOverW = l.u_over_w;
+	d.dUOverW = r.u_over_w - l.u_over_w;
+	d.vOverW = l.v_over_w;
+	d.dVOverW = r.v_over_w - l.v_over_w;
+	return d;
+}
+
+static void RasterizeEdgeRowScalar(const EdgeRow& row, int x0, int x1)
+{
+	const SpanDeltas d = MakeSpanDeltas(row);
+
+	EdgeBlock block;
+	for (int bx = x0; bx <= x1; bx += EDGE_BLOCK_WIDTH) {
+		block.x = bx;
+		block.mask = 0;
+
+		int count = std::min(EDGE_BLOCK_WIDTH, x1 - bx + 1);
+		for (int i = 0; i < count; ++i) {
+			float t = ((float) (bx + i) - d.x) / d.span;
+			float z = d.z + t * d.dz;
+			if (z >= row.zRow[bx + i]) {
+				continue;
+			}
+
+			block.mask |= 1u << i;
+			block.z[i] = z;
+			if (row.gouraud) {
+				block.r[i] = d.r + t * d.dr;
+				block.g[i] = d.g + t * d.dg;
+				block.b[i] = d.b + t * d.db;
+			}
+			if (row.textured) {
+				float invW = 1.0f / (d.oneOverW + t * d.dOneOverW);
+				block.u[i] = (d.uOverW + t * d.dUOverW) * invW;
+				block.v[i] = (d.vOverW + t * d.dVOverW) * invW;
+			}
+		}
+
+		if (block.mask) {
+			row.tri->block(*row.format, *row.tri, block, row.zRow, row.pixelRow);
+		}
+	}
+}
+
+#ifdef EDGE_RASTER_X86
+EDGE_TARGET("sse2") static inline __m128 LerpSSE2(float a, float d, __m128 t)
+{
+	return _mm_add_ps(_mm_set1_ps(a), _mm_mul_ps(t, _mm_set1_ps(d)));
+}
+
+EDGE_TARGET("sse2") static void RasterizeEdgeRowSSE2(const EdgeRow& row, int x0, int x1)
+{
+	const SpanDeltas d = MakeSpanDeltas(row);
+	const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+	EdgeBlock block;
+	int x = x0;
+	for (; x + 4 <= x1 + 1; x += 4) {
+		__m128 fx = _mm_add_ps(_mm_set1_ps((float) x), lanes);
+		__m128 t = _mm_div_ps(_mm_sub_ps(fx, _mm_set1_ps(d.x)), _mm_set1_ps(d.span));
+		__m128 z = LerpSSE2(d.z, d.dz, t);
+
+		// Not greater or equal, so that a NaN depth passes like it does in WriteSpan
+		block.mask = _mm_movemask_ps(_mm_cmpnge_ps(z, _mm_loadu_ps(row.zRow + x)));
+		if (!block.mask) {
+			continue;
+		}
+
+		block.x = x;
+		_mm_storeu_ps(block.z, z);
+		if (row.gouraud) {
+			_mm_storeu_ps(block.r, LerpSSE2(d.r, d.dr, t));
+			_mm_storeu_ps(block.g, LerpSSE2(d.g, d.dg, t));
+			_mm_storeu_ps(block.b, LerpSSE2(d.b, d.db, t));
+		}
+		if (row.textured) {
+			__m128 invW = _mm_div_ps(_mm_set1_ps(1.0f), LerpSSE2(d.oneOverW, d.dOneOverW, t));
+			_mm_storeu_ps(block.u, _mm_mul_ps(LerpSSE2(d.uOverW, d.dUOverW, t), invW));
+			_mm_storeu_ps(block.v, _mm_mul_ps(LerpSSE2(d.vOverW, d.dVOverW, t), invW));
+		}
+		row.tri->block(*row.format, *row.tri, block, row.zRow, row.pixelRow);
+	}
+
+	if (x <= x1) {
+		RasterizeEdgeRowScalar(row, x, x1);
+	}
+}
+
+EDGE_TARGET("avx2") static inline __m256 LerpAVX2(float a, float d, __m256 t)
+{
+	return _mm256_add_ps(_mm256_set1_ps(a), _mm256_mul_ps(t, _mm256_set1_ps(d)));
+}
+
+EDGE_TARGET("avx2") static void RasterizeEdgeRowAVX2(const EdgeRow& row, int x0, int x1)
+{
+	const SpanDeltas d = MakeSpanDeltas(row);
+	const __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+	EdgeBlock block;
+	int x = x0;
+	for (; x + 8 <= x1 + 1; x += 8) {
+		__m256 fx = _mm256_add_ps(_mm256_set1_ps((float) x), lanes);
+		__m256 t = _mm256_div_ps(_mm256_sub_ps(fx, _mm256_set1_ps(d.x)), _mm256_set1_ps(d.span));
+		__m256 z = LerpAVX2(d.z, d.dz, t);
+
+		block.mask = _mm256_movemask_ps(_mm256_cmp_ps(z, _mm256_loadu_ps(row.zRow + x), _CMP_NGE_UQ));
+		if (!block.mask) {
+			continue;
+		}
+
+		block.x = x;
+		_mm256_storeu_ps(block.z, z);
+		if (row.gouraud) {
+			_mm256_storeu_ps(block.r, LerpAVX2(d.r, d.dr, t));
+			_mm256_storeu_ps(block.g, LerpAVX2(d.g, d.dg, t));
+			_mm256_storeu_ps(block.b, LerpAVX2(d.b, d.db, t));
+		}
+		if (row.textured) {
+			__m256 invW = _mm256_div_ps(_mm256_set1_ps(1.0f), LerpAVX2(d.oneOverW, d.dOneOverW, t));
+			_mm256_storeu_ps(block.u, _mm256_mul_ps(LerpAVX2(d.uOverW, d.dUOverW, t), invW));
+			_mm256_storeu_ps(block.v, _mm256_mul_ps(LerpAVX2(d.vOverW, d.dVOverW, t), invW));
+		}
+		row.tri->block(*row.format, *row.tri, block, row.zRow, row.pixelRow);
+	}
+
+	if (x <= x1) {
+		RasterizeEdgeRowScalar(row, x, x1);
+	}
+}
+#endif
+
+#ifdef EDGE_RASTER_NEON
+static inline float32x4_t LerpNEON(float a, float d, float32x4_t t)
+{
+	return vaddq_f32(vdupq_n_f32(a), vmulq_f32(t, vdupq_n_f32(d)));
+}
+
+static inline Uint32 MoveMaskNEON(uint32x4_t mask)
+{
+	static const uint32_t bits[4] = {1, 2, 4, 8};
+	return vaddvq_u32(vandq_u32(mask, vld1q_u32(bits)));
+}
+
+static void RasterizeEdgeRowNEON(const EdgeRow& row, int x0, int x1)
+{
+	const SpanDeltas d = MakeSpanDeltas(row);
+	static const float laneOffsets[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+	const float32x4_t lanes = vld1q_f32(laneOffsets);
+
+	EdgeBlock block;
+	int x = x0;
+	for (; x + 4 <= x1 + 1; x += 4) {
+		float32x4_t fx = vaddq_f32(vdupq_n_f32((float) x), lanes);
+		float32x4_t t = vdivq_f32(vsubq_f32(fx, vdupq_n_f32(d.x)), vdupq_n_f32(d.span));
+		float32x4_t z = LerpNEON(d.z, d.dz, t);
+
+		block.mask = MoveMaskNEON(vmvnq_u32(vcgeq_f32(z, vld1q_f32(row.zRow + x))));
+		if (!block.mask) {
+			continue;
+		}
+
+		block.x = x;
+		vst1q_f32(block.z, z);
+		if (row.gouraud) {
+			vst1q_f32(block.r, LerpNEON(d.r, d.dr, t));
+			vst1q_f32(block.g, LerpNEON(d.g, d.dg, t));
+			vst1q_f32(block.b, LerpNEON(d.b, d.db, t));
+		}
+		if (row.textured) {
+			float32x4_t invW = vdivq_f32(vdupq_n_f32(1.0f), LerpNEON(d.oneOverW, d.dOneOverW, t));
+			vst1q_f32(block.u, vmulq_f32(LerpNEON(d.uOverW, d.dUOverW, t), invW));
+			vst1q_f32(block.v, vmulq_f32(LerpNEON(d.vOverW, d.dVOverW, t), invW));
+		}
+		row.tri->block(*row.format, *row.tri, block, row.zRow, row.pixelRow);
+	}
+
+	if (x <= x1) {
+		RasterizeEdgeRowScalar(row, x, x1);
+	}
+}
+#endif
+
+#ifdef EDGE_RASTER_WASM
+static inline v128_t LerpWasm(float a, float d, v128_t t)
+{
+	return wasm_f32x4_add(wasm_f32x4_splat(a), wasm_f32x4_mul(t, wasm_f32x4_splat(d)));
+}
+
+static void RasterizeEdgeRowWasm(const EdgeRow& row, int x0, int x1)
+{
+	const SpanDeltas d = MakeSpanDeltas(row);
+	const v128_t lanes = wasm_f32x4_make(0.0f, 1.0f, 2.0f, 3.0f);
+
+	EdgeBlock block;
+	int x = x0;
+	for (; x + 4 <= x1 + 1; x += 4) {
+		v128_t fx = wasm_f32x4_add(wasm_f32x4_splat((float) x), lanes);
+		v128_t t = wasm_f32x4_div(wasm_f32x4_sub(fx, wasm_f32x4_splat(d.x)), wasm_f32x4_splat(d.span));
+		v128_t z = LerpWasm(d.z, d.dz, t);
+
+		block.mask = wasm_i32x4_bitmask(wasm_v128_not(wasm_f32x4_ge(z, wasm_v128_load(row.zRow + x))));
+		if (!block.mask) {
+			continue;
+		}
+
+		block.x = x;
+		wasm_v128_store(block.z, z);
+		if (row.gouraud) {
+			wasm_v128_store(block.r, LerpWasm(d.r, d.dr, t));
+			wasm_v128_store(block.g, LerpWasm(d.g, d.dg, t));
+			wasm_v128_store(block.b, LerpWasm(d.b, d.db, t));
+		}
+		if (row.textured) {
+			v128_t invW = wasm_f32x4_div(wasm_f32x4_splat(1.0f), LerpWasm(d.oneOverW, d.dOneOverW, t));
+			wasm_v128_store(block.u, wasm_f32x4_mul(LerpWasm(d.uOverW, d.dUOverW, t), invW));
+			wasm_v128_store(block.v, wasm_f32x4_mul(LerpWasm(d.vOverW, d.dVOverW, t), invW));
+		}
+		row.tri->block(*row.format, *row.tri, block, row.zRow, row.pixelRow);
+	}
+
+	if (x <= x1) {
+		RasterizeEdgeRowScalar(row, x, x1);
+	}
+}
+#endif
+
+EdgeRowRasterizer SelectEdgeRowRasterizer(const char* name)
+{
+	if (!name || SDL_strcasecmp(name, "scanline") == 0) {
+		return nullptr;
+	}
+	if (SDL_strncasecmp(name, "edge", 4) != 0) {
+		SDL_Log("Unknown software rasterizer '%s', using scanline", name);
+		return nullptr;
+	}
+
+	bool best = SDL_strcasecmp(name, "edge") == 0;
+#ifdef EDGE_RASTER_X86
+	if ((best || SDL_strcasecmp(name, "edge-avx2") == 0) && SDL_HasAVX2()) {
+		return RasterizeEdgeRowAVX2;
+	}
+	if ((best || SDL_strcasecmp(name, "edge-sse2") == 0) && SDL_HasSSE2()) {
+		return RasterizeEdgeRowSSE2;
+	}
+#endif
+#ifdef EDGE_RASTER_NEON
+	if ((best || SDL_strcasecmp(name, "edge-neon") == 0) && SDL_HasNEON()) {
+		return RasterizeEdgeRowNEON;
+	}
+#endif
+#ifdef EDGE_RASTER_WASM
+	if (best || SDL_strcasecmp(name, "edge-wasm128") == 0) {
+		return RasterizeEdgeRowWasm;
+	}
+#endif
+
+	if (!best && SDL_strcasecmp(name, "edge-scalar") != 0) {
+		SDL_Log("Software rasterizer '%s' is not supported on this CPU, using edge-scalar", name);
+	}
+	return RasterizeEdgeRowScalar;
+}
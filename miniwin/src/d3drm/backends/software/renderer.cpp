@@ -23,14 +23,297 @@
 #include <wasm_simd128.h>
 #endif
 
-Direct3DRMSoftwareRenderer::Direct3DRMSoftwareRenderer(DWORD width, DWORD height) : m_width(width), m_height(height)
+Direct3DRMSoftwareRenderer::Direct3DRMSoftwareRenderer(DWORD width, DWORD height)
+	: m_outputWidth(width), m_outputHeight(height)
 {
+	SDL_AtomicSet(&m_nextTile, 0);
+
+	m_edgeRow = SelectEdgeRowRasterizer(SDL_GetHint(MINIWIN_HINT_SOFTWARE_RASTERIZER));
+
+	const char* filter = SDL_GetHint(MINIWIN_HINT_SOFTWARE_TEXTURE_FILTER);
+	m_mipmaps = !filter || SDL_strcasecmp(filter, "nearest") != 0;
+	m_bilinear = filter && SDL_strcasecmp(filter, "bilinear") == 0;
+
+	const char* scale = SDL_GetHint(MINIWIN_HINT_SOFTWARE_RENDER_SCALE);
+	m_maxRenderScale = std::clamp(scale ? (float) SDL_atof(scale) : 1.0f, 0.1f, 1.0f);
+	const char* minScale = SDL_GetHint(MINIWIN_HINT_SOFTWARE_MIN_RENDER_SCALE);
+	m_minRenderScale = std::clamp(minScale ? (float) SDL_atof(minScale) : 0.5f, 0.1f, m_maxRenderScale);
+	const char* budget = SDL_GetHint(MINIWIN_HINT_SOFTWARE_FRAME_BUDGET);
+	m_frameBudget = budget ? std::max((float) SDL_atof(budget), 0.0f) / 1000.0f : 0.0f;
+	m_renderScale = m_maxRenderScale;
+	UpdateRenderSize();
+}
+
+Direct3DRMSoftwareRenderer::~Direct3DRMSoftwareRenderer()
+{
+	StopWorkers();
+	SDL_FreeSurface(m_renderTarget);
+	SDL_FreeSurface(m_offscreen);
+}
+
+Direct3DRMSoftwareRenderer* Direct3DRMSoftwareRenderer::CreateOffscreen(DWORD width, DWORD height)
+{
+	SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA8888);
+	if (!surface) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create offscreen surface: %s", SDL_GetError());
+		return nullptr;
+	}
+	auto* renderer = new Direct3DRMSoftwareRenderer(width, height);
+	renderer->m_offscreen = surface;
+	return renderer;
+}
+
+SDL_Surface* Direct3DRMSoftwareRenderer::GetOutputSurface()
+{
+	return m_offscreen ? m_offscreen : DDBackBuffer;
+}
+
+// Adds the ticks since start to a stage of m_stats and restarts the clock
+void Direct3DRMSoftwareRenderer::StatLap(Uint64& stage, Uint64& start)
+{
+	if (m_statsEnabled) {
+		Uint64 now = SDL_GetPerformanceCounter();
+		stage += now - start;
+		start = now;
+	}
+}
+
+// Reallocates everything sized by the render resolution, only called between frames
+void Direct3DRMSoftwareRenderer::Resize(DWORD width, DWORD height)
+{
+	m_width = width;
+	m_height = height;
 	m_zBuffer.resize(m_width * m_height);
+	AllocateHiZ();
+
+	m_tilesX = (m_width + TileSize - 1) / TileSize;
+	m_tilesY = (m_height + TileSize - 1) / TileSize;
+	m_tileBins.clear();
+	m_tileBins.resize(m_tilesX * m_tilesY);
+
+	SDL_FreeSurface(m_renderTarget);
+	m_renderTarget = nullptr;
+}
+
+void Direct3DRMSoftwareRenderer::UpdateRenderSize()
+{
+	DWORD width = std::max<DWORD>(1, (DWORD) (m_outputWidth * m_renderScale + 0.5f));
+	DWORD height = std::max<DWORD>(1, (DWORD) (m_outputHeight * m_renderScale + 0.5f));
+	if (width != m_width || height != m_height) {
+		Resize(width, height);
+	}
+}
+
+// Steers the render scale towards the frame budget. Frame time is treated as proportional to the
+// pixel count, so the scale follows the square root of the budget ratio.
+void Direct3DRMSoftwareRenderer::UpdateDynamicResolution(float frameTime)
+{
+	m_frameTime = m_frameTime > 0.0f ? m_frameTime * 0.9f + frameTime * 0.1f : frameTime;
+	if (++m_framesSinceResize < ResolutionInterval) {
+		return;
+	}
+
+	float ratio = m_frameBudget / m_frameTime;
+	float scale = m_renderScale;
+	if (ratio < 1.0f) {
+		// Over budget: drop straight to the estimated scale
+		scale = m_renderScale * std::sqrt(ratio);
+	}
+	else if (ratio > 1.25f) {
+		// Well under budget: recover in small steps so a single fast frame does not cause oscillation
+		scale = std::min(m_renderScale * std::sqrt(ratio), m_renderScale * 1.1f);
+	}
+	scale = std::clamp(scale, m_minRenderScale, m_maxRenderScale);
+
+	if (std::fabs(scale - m_renderScale) > 0.02f) {
+		m_renderScale = scale;
+		m_frameTime = 0.0f;
+		m_framesSinceResize = 0;
+	}
+}
+
+// Nearest neighbour upscale of the pixels the scene wrote, found by their depth. Copying the whole render
+// target back would run the 2D drawn before the scene through a down and up scale every frame.
+void Direct3DRMSoftwareRenderer::CompositeRenderTarget()
+{
+	SDL_Surface* output = GetOutputSurface();
+	if (!SDL_LockSurface(output)) {
+		return;
+	}
+
+	m_compositeColumns.resize(m_outputWidth);
+	for (DWORD x = 0; x < m_outputWidth; ++x) {
+		m_compositeColumns[x] = x * m_width / m_outputWidth;
+	}
+
+	const int bpp = m_bytesPerPixel;
+	const float inf = std::numeric_limits<float>::infinity();
+	for (DWORD y = 0; y < m_outputHeight; ++y) {
+		DWORD srcY = y * m_height / m_outputHeight;
+		const float* zRow = &m_zBuffer[srcY * m_width];
+		const Uint8* srcRow = m_pixels + srcY * m_pitch;
+		Uint8* dstRow = static_cast<Uint8*>(output->pixels) + y * output->pitch;
+		for (DWORD x = 0; x < m_outputWidth; ++x) {
+			DWORD srcX = m_compositeColumns[x];
+			if (zRow[srcX] != inf) {
+				memcpy(dstRow + x * bpp, srcRow + srcX * bpp, bpp);
+			}
+		}
+	}
+
+	SDL_UnlockSurface(output);
+}
+
+void Direct3DRMSoftwareRenderer::StartWorkers()
+{
+	m_workersStarted = true;
+
+	int workerCount = std::min(SDL_GetCPUCount() - 1, MaxWorkers);
+	if (workerCount <= 0) {
+		return;
+	}
+
+	m_workStart = SDL_CreateSemaphore(0);
+	m_workDone = SDL_CreateSemaphore(0);
+	if (!m_workStart || !m_workDone) {
+		return;
+	}
+
+	for (int i = 0; i < workerCount; ++i) {
+		SDL_Thread* thread = SDL_CreateThread(&Direct3DRMSoftwareRenderer::TileWorkerProc, "SoftwareTileWorker", this);
+		if (!thread) {
+			SDL_Log("Failed to create software renderer worker: %s", SDL_GetError());
+			break;
+		}
+		m_workers.push_back(thread);
+	}
+}
+
+void Direct3DRMSoftwareRenderer::StopWorkers()
+{
+	m_quit = true;
+	for (size_t i = 0; i < m_workers.size(); ++i) {
+		SDL_SemPost(m_workStart);
+	}
+	for (SDL_Thread* thread : m_workers) {
+		SDL_WaitThread(thread, nullptr);
+	}
+	m_workers.clear();
+
+	if (m_workStart) {
+		SDL_DestroySemaphore(m_workStart);
+		m_workStart = nullptr;
+	}
+	if (m_workDone) {
+		SDL_DestroySemaphore(m_workDone);
+		m_workDone = nullptr;
+	}
+}
+
+int SDLCALL Direct3DRMSoftwareRenderer::TileWorkerProc(void* data)
+{
+	auto* renderer = static_cast<Direct3DRMSoftwareRenderer*>(data);
+	for (;;) {
+		SDL_SemWait(renderer->m_workStart);
+		if (renderer->m_quit) {
+			break;
+		}
+		renderer->RasterizeTiles();
+		SDL_SemPost(renderer->m_workDone);
+	}
+	return 0;
+}
+
+void Direct3DRMSoftwareRenderer::RasterizeTiles()
+{
+	const int tileCount = m_tilesX * m_tilesY;
+	for (;;) {
+		int tile = SDL_AtomicAdd(&m_nextTile, 1);
+		if (tile >= tileCount) {
+			break;
+		}
+
+		int tileX0 = (tile % m_tilesX) * TileSize;
+		int tileY0 = (tile / m_tilesX) * TileSize;
+		int tileX1 = std::min(tileX0 + TileSize, (int) m_width);
+		int tileY1 = std::min(tileY0 + TileSize, (int) m_height);
+
+		for (Uint32 index : m_tileBins[tile]) {
+			RasterizeTriangle(m_triangles[index], tileX0, tileY0, tileX1, tileY1);
+		}
+	}
+}
+
+void Direct3DRMSoftwareRenderer::FlushTiles()
+{
+	if (m_triangles.empty()) {
+		return;
+	}
+
+	Uint64 start = StatStart();
+	SDL_AtomicSet(&m_nextTile, 0);
+	for (size_t i = 0; i < m_workers.size(); ++i) {
+		SDL_SemPost(m_workStart);
+	}
+	RasterizeTiles();
+	for (size_t i = 0; i < m_workers.size(); ++i) {
+		SDL_SemWait(m_workDone);
+	}
+
+	for (auto& bin : m_tileBins) {
+		bin.clear();
+	}
+	if (m_statsEnabled) {
+		m_stats.triangles += m_triangles.size();
+		StatLap(m_transparentPass ? m_stats.blend : m_stats.raster, start);
+	}
+	m_triangles.clear();
 }
 
 void Direct3DRMSoftwareRenderer::PushLights(const SceneLight* lights, size_t count)
 {
+	if (count == m_lights.size() && memcmp(m_lights.data(), lights, count * sizeof(SceneLight)) == 0) {
+		return;
+	}
+
 	m_lights.assign(lights, lights + count);
+	m_lightsVersion++;
+
+	m_preparedLights.clear();
+	m_viewDependentLights = false;
+	for (const auto& light : m_lights) {
+		PreparedLight& prepared = m_preparedLights.emplace_back();
+		prepared.color = light.color;
+		prepared.position = light.position;
+
+		if (light.directional == 1.0f) {
+			prepared.type = LIGHT_DIRECTIONAL;
+			prepared.lightVec = Normalize({-light.direction.x, -light.direction.y, -light.direction.z});
+		}
+		else if (light.positional == 1.0f) {
+			prepared.type = LIGHT_POSITIONAL;
+			m_viewDependentLights = true;
+		}
+		else {
+			prepared.type = LIGHT_AMBIENT;
+		}
+	}
+}
+
+const float* Direct3DRMSoftwareRenderer::GetSpecularTable(float shininess)
+{
+	auto it = m_specularTables.find(shininess);
+	if (it != m_specularTables.end()) {
+		return it->second.data();
+	}
+
+	std::vector<float>& table = m_specularTables[shininess];
+	table.resize(SPECULAR_TABLE_SIZE + 1);
+	for (int i = 0; i < SPECULAR_TABLE_SIZE; ++i) {
+		table[i] = std::pow(i / (float) (SPECULAR_TABLE_SIZE - 1), shininess);
+	}
+	table[SPECULAR_TABLE_SIZE] = table[SPECULAR_TABLE_SIZE - 1];
+	return table.data();
 }
 
 void Direct3DRMSoftwareRenderer::SetFrustumPlanes(const Plane* frustumPlanes)
@@ -87,6 +370,117 @@ void Direct3DRMSoftwareRenderer::ClearZBuffer()
 	}
 }
 
+void Direct3DRMSoftwareRenderer::AllocateHiZ()
+{
+	int width = (m_width + HIZ_TILE_SIZE - 1) / HIZ_TILE_SIZE;
+	int height = (m_height + HIZ_TILE_SIZE - 1) / HIZ_TILE_SIZE;
+	m_hiZ.clear();
+	for (;;) {
+		m_hiZ.push_back({width, height, std::vector<float>(width * height)});
+		if (width == 1 && height == 1) {
+			break;
+		}
+		width = (width + 1) / 2;
+		height = (height + 1) / 2;
+	}
+}
+
+bool Direct3DRMSoftwareRenderer::BuildOcclusionPyramid()
+{
+	FlushTiles();
+
+	HiZLevel& base = m_hiZ[0];
+	std::fill(base.maxDepth.begin(), base.maxDepth.end(), -std::numeric_limits<float>::infinity());
+	for (DWORD y = 0; y < m_height; ++y) {
+		const float* zRow = &m_zBuffer[y * m_width];
+		float* texelRow = &base.maxDepth[(y / HIZ_TILE_SIZE) * base.width];
+		for (DWORD x = 0; x < m_width; ++x) {
+			float& texel = texelRow[x / HIZ_TILE_SIZE];
+			texel = std::max(texel, zRow[x]);
+		}
+	}
+
+	for (size_t level = 1; level < m_hiZ.size(); ++level) {
+		const HiZLevel& fine = m_hiZ[level - 1];
+		HiZLevel& coarse = m_hiZ[level];
+		for (int y = 0; y < coarse.height; ++y) {
+			int y0 = y * 2;
+			int y1 = std::min(y0 + 1, fine.height - 1);
+			for (int x = 0; x < coarse.width; ++x) {
+				int x0 = x * 2;
+				int x1 = std::min(x0 + 1, fine.width - 1);
+				coarse.maxDepth[y * coarse.width + x] = std::max(
+					std::max(fine.maxDepth[y0 * fine.width + x0], fine.maxDepth[y0 * fine.width + x1]),
+					std::max(fine.maxDepth[y1 * fine.width + x0], fine.maxDepth[y1 * fine.width + x1])
+				);
+			}
+		}
+	}
+
+	m_hiZValid = true;
+	return true;
+}
+
+bool Direct3DRMSoftwareRenderer::IsBoxOccluded(const D3DRMBOX& viewBox)
+{
+	// Boxes crossing the near plane would need clipping to project, treat them as visible
+	if (!m_hiZValid || viewBox.min.z < m_front) {
+		return false;
+	}
+
+	float minX = std::numeric_limits<float>::infinity();
+	float minY = minX;
+	float nearZ = minX;
+	float maxX = -minX;
+	float maxY = -minX;
+	for (int i = 0; i < 8; ++i) {
+		D3DVECTOR corner = {
+			i & 1 ? viewBox.max.x : viewBox.min.x,
+			i & 2 ? viewBox.max.y : viewBox.min.y,
+			i & 4 ? viewBox.max.z : viewBox.min.z
+		};
+		D3DRMVECTOR4D p;
+		ProjectVertex(corner, p);
+		minX = std::min(minX, p.x);
+		maxX = std::max(maxX, p.x);
+		minY = std::min(minY, p.y);
+		maxY = std::max(maxY, p.y);
+		nearZ = std::min(nearZ, p.z);
+	}
+
+	int x0 = std::max(0, (int) std::floor(minX));
+	int y0 = std::max(0, (int) std::floor(minY));
+	int x1 = std::min((int) m_width - 1, (int) std::ceil(maxX));
+	int y1 = std::min((int) m_height - 1, (int) std::ceil(maxY));
+	if (x0 > x1 || y0 > y1) {
+		return false;
+	}
+
+	// Walk up the pyramid until the box covers no more than 4x4 texels
+	size_t level = 0;
+	x0 /= HIZ_TILE_SIZE;
+	y0 /= HIZ_TILE_SIZE;
+	x1 /= HIZ_TILE_SIZE;
+	y1 /= HIZ_TILE_SIZE;
+	while (level + 1 < m_hiZ.size() && (x1 - x0 >= 4 || y1 - y0 >= 4)) {
+		++level;
+		x0 /= 2;
+		y0 /= 2;
+		x1 /= 2;
+		y1 /= 2;
+	}
+
+	const HiZLevel& hiZ = m_hiZ[level];
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			if (!(nearZ > hiZ.maxDepth[y * hiZ.width + x])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 void Direct3DRMSoftwareRenderer::ProjectVertex(const D3DVECTOR& v, D3DRMVECTOR4D& p) const
 {
 	float px = m_projection[0][0] * v.x + m_projection[1][0] * v.y + m_projection[2][0] * v.z + m_projection[3][0];
@@ -150,7 +544,11 @@ bool IsTriangleOutsideViewCone(
 	return false;
 }
 
-void Direct3DRMSoftwareRenderer::DrawTriangleClipped(const D3DRMVERTEX (&v)[3], const Appearance& appearance)
+void Direct3DRMSoftwareRenderer::DrawTriangleClipped(
+	const D3DRMVERTEX (&v)[3],
+	const SDL_Color (&c)[3],
+	const Appearance& appearance
+)
 {
 	bool in0 = v[0].position.z >= m_front;
 	bool in1 = v[1].position.z >= m_front;
@@ -166,66 +564,59 @@ void Direct3DRMSoftwareRenderer::DrawTriangleClipped(const D3DRMVERTEX (&v)[3],
 	}
 
 	if (insideCount == 3) {
-		DrawTriangleProjected(v[0], v[1], v[2], appearance);
+		DrawTriangleProjected(v[0], v[1], v[2], c[0], c[1], c[2], appearance);
+		return;
 	}
-	else if (insideCount == 2) {
-		D3DRMVERTEX split;
+
+	// Flat meshes only light the first vertex of each face, but clipping can rotate the others to the front
+	SDL_Color lit[3] = {c[0], c[1], c[2]};
+	if (appearance.flat) {
+		lit[1] = ApplyLighting(v[1].position, v[1].normal, appearance);
+		lit[2] = ApplyLighting(v[2].position, v[2].normal, appearance);
+	}
+
+	auto split = [&](int a, int b) {
+		D3DRMVERTEX s = SplitEdge(v[a], v[b], m_front);
+		return std::make_pair(s, ApplyLighting(s.position, s.normal, appearance));
+	};
+
+	if (insideCount == 2) {
 		if (!in0) {
-			split = SplitEdge(v[2], v[0], m_front);
-			DrawTriangleProjected(v[1], v[2], split, appearance);
-			DrawTriangleProjected(v[1], split, SplitEdge(v[1], v[0], m_front), appearance);
+			auto s0 = split(2, 0);
+			auto s1 = split(1, 0);
+			DrawTriangleProjected(v[1], v[2], s0.first, lit[1], lit[2], s0.second, appearance);
+			DrawTriangleProjected(v[1], s0.first, s1.first, lit[1], s0.second, s1.second, appearance);
 		}
 		else if (!in1) {
-			split = SplitEdge(v[0], v[1], m_front);
-			DrawTriangleProjected(v[2], v[0], split, appearance);
-			DrawTriangleProjected(v[2], split, SplitEdge(v[2], v[1], m_front), appearance);
+			auto s0 = split(0, 1);
+			auto s1 = split(2, 1);
+			DrawTriangleProjected(v[2], v[0], s0.first, lit[2], lit[0], s0.second, appearance);
+			DrawTriangleProjected(v[2], s0.first, s1.first, lit[2], s0.second, s1.second, appearance);
 		}
 		else {
-			split = SplitEdge(v[1], v[2], m_front);
-			DrawTriangleProjected(v[0], v[1], split, appearance);
-			DrawTriangleProjected(v[0], split, SplitEdge(v[0], v[2], m_front), appearance);
+			auto s0 = split(1, 2);
+			auto s1 = split(0, 2);
+			DrawTriangleProjected(v[0], v[1], s0.first, lit[0], lit[1], s0.second, appearance);
+			DrawTriangleProjected(v[0], s0.first, s1.first, lit[0], s0.second, s1.second, appearance);
 		}
 	}
 	else if (in0) {
-		DrawTriangleProjected(v[0], SplitEdge(v[0], v[1], m_front), SplitEdge(v[0], v[2], m_front), appearance);
+		auto s0 = split(0, 1);
+		auto s1 = split(0, 2);
+		DrawTriangleProjected(v[0], s0.first, s1.first, lit[0], s0.second, s1.second, appearance);
 	}
 	else if (in1) {
-		DrawTriangleProjected(SplitEdge(v[1], v[0], m_front), v[1], SplitEdge(v[1], v[2], m_front), appearance);
+		auto s0 = split(1, 0);
+		auto s1 = split(1, 2);
+		DrawTriangleProjected(s0.first, v[1], s1.first, s0.second, lit[1], s1.second, appearance);
 	}
 	else {
-		DrawTriangleProjected(SplitEdge(v[2], v[0], m_front), SplitEdge(v[2], v[1], m_front), v[2], appearance);
+		auto s0 = split(2, 0);
+		auto s1 = split(2, 1);
+		DrawTriangleProjected(s0.first, s1.first, v[2], s0.second, s1.second, lit[2], appearance);
 	}
 }
 
-Uint32 Direct3DRMSoftwareRenderer::BlendPixel(Uint8* pixelAddr, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
-{
-	Uint32 dstPixel;
-	switch (m_bytesPerPixel) {
-	case 1:
-		dstPixel = *pixelAddr;
-		break;
-	case 2:
-		dstPixel = *(Uint16*) pixelAddr;
-		break;
-	case 4:
-		dstPixel = *(Uint32*) pixelAddr;
-		break;
-	}
-
-	Uint8 dstR, dstG, dstB, dstA;
-	SDL_GetRGBA(dstPixel, m_format, &dstR, &dstG, &dstB, &dstA);
-
-	float alpha = a / 255.0f;
-	float invAlpha = 1.0f - alpha;
-
-	Uint8 outR = static_cast<Uint8>(r * alpha + dstR * invAlpha);
-	Uint8 outG = static_cast<Uint8>(g * alpha + dstG * invAlpha);
-	Uint8 outB = static_cast<Uint8>(b * alpha + dstB * invAlpha);
-	Uint8 outA = static_cast<Uint8>(a + dstA * invAlpha);
-
-	return SDL_MapRGBA(m_format, outR, outG, outB, outA);
-}
-
 SDL_Color Direct3DRMSoftwareRenderer::ApplyLighting(
 	const D3DVECTOR& position,
 	const D3DVECTOR& oNormal,
@@ -237,26 +628,25 @@ SDL_Color Direct3DRMSoftwareRenderer::ApplyLighting(
 
 	D3DVECTOR normal = Normalize(TransformNormal(oNormal, m_normalMatrix));
 
-	for (const auto& light : m_lights) {
-		FColor lightColor = light.color;
+	for (const auto& light : m_preparedLights) {
+		const FColor& lightColor = light.color;
 
-		if (light.positional == 0.0f && light.directional == 0.0f) {
-			// Ambient light
+		if (light.type == LIGHT_AMBIENT) {
 			diffuse.r += lightColor.r;
 			diffuse.g += lightColor.g;
 			diffuse.b += lightColor.b;
 			continue;
 		}
 
-		// TODO lightVec only has to be calculated once per frame for directional lights
 		D3DVECTOR lightVec;
-		if (light.directional == 1.0f) {
-			lightVec = {-light.direction.x, -light.direction.y, -light.direction.z};
+		if (light.type == LIGHT_DIRECTIONAL) {
+			lightVec = light.lightVec;
 		}
-		else if (light.positional == 1.0f) {
-			lightVec = {light.position.x - position.x, light.position.y - position.y, light.position.z - position.z};
+		else {
+			lightVec = Normalize(
+				{light.position.x - position.x, light.position.y - position.y, light.position.z - position.z}
+			);
 		}
-		lightVec = Normalize(lightVec);
 
 		float dotNL = DotProduct(normal, lightVec);
 		if (dotNL > 0.0f) {
@@ -266,12 +656,14 @@ SDL_Color Direct3DRMSoftwareRenderer::ApplyLighting(
 			diffuse.b += dotNL * lightColor.b;
 
 			// Specular
-			if (appearance.shininess > 0.0f && light.directional == 1.0f) {
+			if (m_drawSpecular && light.type == LIGHT_DIRECTIONAL) {
 				D3DVECTOR viewVec = Normalize({-position.x, -position.y, -position.z});
 				D3DVECTOR H = Normalize({lightVec.x + viewVec.x, lightVec.y + viewVec.y, lightVec.z + viewVec.z});
 
-				float dotNH = std::max(DotProduct(normal, H), 0.0f);
-				float spec = std::pow(dotNH, appearance.shininess);
+				float dotNH = std::min(std::max(DotProduct(normal, H), 0.0f), 1.0f);
+				float f = dotNH * (SPECULAR_TABLE_SIZE - 1);
+				int i = static_cast<int>(f);
+				float spec = m_drawSpecular[i] + (f - i) * (m_drawSpecular[i + 1] - m_drawSpecular[i]);
 
 				specular.r += spec * lightColor.r;
 				specular.g += spec * lightColor.g;
@@ -288,12 +680,45 @@ SDL_Color Direct3DRMSoftwareRenderer::ApplyLighting(
 	};
 }
 
-struct VertexXY {
-	float x, y, z, w;
-	SDL_Color color;
-	float u_over_w, v_over_w;
-	float one_over_w;
-};
+void Direct3DRMSoftwareRenderer::LightMesh(
+	MeshCache& mesh,
+	const D3DRMMATRIX4D& modelViewMatrix,
+	const Appearance& appearance
+)
+{
+	// Without specular or positional lights the result only depends on the normals, so a moving camera
+	// does not invalidate the cache
+	bool viewDependent = m_drawSpecular || m_viewDependentLights;
+
+	if (mesh.litValid && mesh.litLightsVersion == m_lightsVersion && mesh.litShininess == appearance.shininess &&
+		memcmp(&mesh.litColor, &appearance.color, sizeof(SDL_Color)) == 0 &&
+		memcmp(mesh.litNormalMatrix, m_normalMatrix, sizeof(Matrix3x3)) == 0 &&
+		(!viewDependent || memcmp(mesh.litModelView, modelViewMatrix, sizeof(D3DRMMATRIX4D)) == 0)) {
+		return;
+	}
+
+	mesh.litColors.resize(m_transformedVerts.size());
+	if (appearance.flat) {
+		// Faces are unshared after FlattenSurfaces and only take their first vertex's color
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+			const D3DRMVERTEX& v = m_transformedVerts[mesh.indices[i]];
+			mesh.litColors[mesh.indices[i]] = ApplyLighting(v.position, v.normal, appearance);
+		}
+	}
+	else {
+		for (size_t i = 0; i < m_transformedVerts.size(); ++i) {
+			const D3DRMVERTEX& v = m_transformedVerts[i];
+			mesh.litColors[i] = ApplyLighting(v.position, v.normal, appearance);
+		}
+	}
+
+	mesh.litValid = true;
+	mesh.litLightsVersion = m_lightsVersion;
+	mesh.litShininess = appearance.shininess;
+	mesh.litColor = appearance.color;
+	memcpy(mesh.litNormalMatrix, m_normalMatrix, sizeof(Matrix3x3));
+	memcpy(mesh.litModelView, modelViewMatrix, sizeof(D3DRMMATRIX4D));
+}
 
 VertexXY InterpolateVertex(float y, const VertexXY& v0, const VertexXY& v1)
 {
@@ -330,10 +755,376 @@ inline bool IsBackface(const D3DVECTOR& v0, const D3DVECTOR& v1, const D3DVECTOR
 	return DotProduct(normal, v0) >= 0.0f;
 }
 
+template <int BPP>
+inline Uint32 LoadPixel(const Uint8* addr)
+{
+	switch (BPP) {
+	case 1:
+		return *addr;
+	case 2:
+		return *reinterpret_cast<const Uint16*>(addr);
+	case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		return (addr[0] << 16) | (addr[1] << 8) | addr[2];
+#else
+		return addr[0] | (addr[1] << 8) | (addr[2] << 16);
+#endif
+	default:
+		return *reinterpret_cast<const Uint32*>(addr);
+	}
+}
+
+template <int BPP>
+inline void StorePixel(Uint8* addr, Uint32 pixel)
+{
+	switch (BPP) {
+	case 1:
+		*addr = static_cast<Uint8>(pixel);
+		break;
+	case 2:
+		*reinterpret_cast<Uint16*>(addr) = static_cast<Uint16>(pixel);
+		break;
+	case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		addr[0] = static_cast<Uint8>(pixel >> 16);
+		addr[1] = static_cast<Uint8>(pixel >> 8);
+		addr[2] = static_cast<Uint8>(pixel);
+#else
+		addr[0] = static_cast<Uint8>(pixel);
+		addr[1] = static_cast<Uint8>(pixel >> 8);
+		addr[2] = static_cast<Uint8>(pixel >> 16);
+#endif
+		break;
+	default:
+		*reinterpret_cast<Uint32*>(addr) = pixel;
+		break;
+	}
+}
+
+// Same results as SDL_GetRGBA
+template <int BPP>
+inline void DecodePixel(const PixelFormatInfo& fmt, Uint32 pixel, Uint8& r, Uint8& g, Uint8& b, Uint8& a)
+{
+	const SDL_Palette* palette = fmt.format->palette;
+	if (BPP == 1 && palette) {
+		if (pixel < (Uint32) palette->ncolors) {
+			const SDL_Color& color = palette->colors[pixel];
+			r = color.r;
+			g = color.g;
+			b = color.b;
+			a = color.a;
+		}
+		else {
+			r = g = b = a = 0;
+		}
+		return;
+	}
+
+	r = fmt.expand[0][(pixel & fmt.mask[0]) >> fmt.shift[0]];
+	g = fmt.expand[1][(pixel & fmt.mask[1]) >> fmt.shift[1]];
+	b = fmt.expand[2][(pixel & fmt.mask[2]) >> fmt.shift[2]];
+	a = fmt.expand[3][(pixel & fmt.mask[3]) >> fmt.shift[3]];
+}
+
+// Same results as SDL_MapRGBA
+template <int BPP>
+inline Uint32 EncodePixel(const PixelFormatInfo& fmt, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+	if (BPP == 1 && fmt.format->palette) {
+		return SDL_MapRGBA(fmt.format, r, g, b, a);
+	}
+
+	return (r >> fmt.loss[0]) << fmt.shift[0] | (g >> fmt.loss[1]) << fmt.shift[1] |
+		   (b >> fmt.loss[2]) << fmt.shift[2] | ((Uint32) (a >> fmt.loss[3]) << fmt.shift[3] & fmt.mask[3]);
+}
+
+template <int BPP>
+inline Uint32 BlendPixel(const PixelFormatInfo& fmt, const Uint8* pixelAddr, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+	Uint8 dstR, dstG, dstB, dstA;
+	DecodePixel<BPP>(fmt, LoadPixel<BPP>(pixelAddr), dstR, dstG, dstB, dstA);
+
+	float alpha = a / 255.0f;
+	float invAlpha = 1.0f - alpha;
+
+	Uint8 outR = static_cast<Uint8>(r * alpha + dstR * invAlpha);
+	Uint8 outG = static_cast<Uint8>(g * alpha + dstG * invAlpha);
+	Uint8 outB = static_cast<Uint8>(b * alpha + dstB * invAlpha);
+	Uint8 outA = static_cast<Uint8>(a + dstA * invAlpha);
+
+	return EncodePixel<BPP>(fmt, outR, outG, outB, outA);
+}
+
+enum TextureSampling {
+	SAMPLE_NONE,
+	SAMPLE_POINT,
+	SAMPLE_BILINEAR
+};
+
+template <int BPP>
+inline void SampleBilinear(
+	const PixelFormatInfo& fmt,
+	const TextureSampler& texture,
+	float u,
+	float v,
+	Uint8& r,
+	Uint8& g,
+	Uint8& b
+)
+{
+	float fx = u * texture.widthScale;
+	float fy = v * texture.heightScale;
+	int x0 = static_cast<int>(fx);
+	int y0 = static_cast<int>(fy);
+	int x1 = x0 < texture.widthScale ? x0 + 1 : 0;
+	int y1 = y0 < texture.heightScale ? y0 + 1 : 0;
+	int wx = static_cast<int>((fx - x0) * 256.0f);
+	int wy = static_cast<int>((fy - y0) * 256.0f);
+
+	const Uint8* row0 = texture.texels + y0 * texture.pitch;
+	const Uint8* row1 = texture.texels + y1 * texture.pitch;
+	Uint8 c[4][4];
+	DecodePixel<BPP>(fmt, LoadPixel<BPP>(row0 + x0 * BPP), c[0][0], c[0][1], c[0][2], c[0][3]);
+	DecodePixel<BPP>(fmt, LoadPixel<BPP>(row0 + x1 * BPP), c[1][0], c[1][1], c[1][2], c[1][3]);
+	DecodePixel<BPP>(fmt, LoadPixel<BPP>(row1 + x0 * BPP), c[2][0], c[2][1], c[2][2], c[2][3]);
+	DecodePixel<BPP>(fmt, LoadPixel<BPP>(row1 + x1 * BPP), c[3][0], c[3][1], c[3][2], c[3][3]);
+
+	Uint8 out[3];
+	for (int i = 0; i < 3; ++i) {
+		int top = c[0][i] * (256 - wx) + c[1][i] * wx;
+		int bottom = c[2][i] * (256 - wx) + c[3][i] * wx;
+		out[i] = static_cast<Uint8>((top * (256 - wy) + bottom * wy) >> 16);
+	}
+	r = out[0];
+	g = out[1];
+	b = out[2];
+}
+
+template <int BPP, int Sampling, bool Blended>
+inline void ShadeFragment(
+	const PixelFormatInfo& fmt,
+	const RasterTriangle& tri,
+	float& zref,
+	float z,
+	Uint8 r,
+	Uint8 g,
+	Uint8 b,
+	float u,
+	float v,
+	Uint8* pixelAddr
+)
+{
+	if (Blended) {
+		StorePixel<BPP>(pixelAddr, BlendPixel<BPP>(fmt, pixelAddr, r, g, b, tri.alpha));
+		return;
+	}
+
+	zref = z;
+
+	if (Sampling != SAMPLE_NONE) {
+		const TextureSampler& texture = tri.texture;
+
+		// Tile textures
+		u -= std::floor(u);
+		v -= std::floor(v);
+
+		Uint8 tr, tg, tb, ta;
+		if (Sampling == SAMPLE_BILINEAR) {
+			SampleBilinear<BPP>(fmt, texture, u, v, tr, tg, tb);
+		}
+		else {
+			int texX = static_cast<int>(u * texture.widthScale);
+			int texY = static_cast<int>(v * texture.heightScale);
+
+			const Uint8* texelAddr = texture.texels + texY * texture.pitch + texX * BPP;
+			DecodePixel<BPP>(fmt, LoadPixel<BPP>(texelAddr), tr, tg, tb, ta);
+		}
+
+		// Multiply vertex color by texel color
+		r = (r * tr + 127) / 255;
+		g = (g * tg + 127) / 255;
+		b = (b * tb + 127) / 255;
+	}
+
+	StorePixel<BPP>(pixelAddr, EncodePixel<BPP>(fmt, r, g, b, 255));
+}
+
+template <int BPP, bool Flat, int Sampling, bool Blended>
+void WriteSpan(
+	const PixelFormatInfo& fmt,
+	const RasterTriangle& tri,
+	const VertexXY& left,
+	const VertexXY& right,
+	int startX,
+	int endX,
+	float* zRow,
+	Uint8* pixelRow
+)
+{
+	const float span = right.x - left.x;
+
+	for (int x = startX; x <= endX; ++x) {
+		float t = (x - left.x) / span;
+		float z = left.z + t * (right.z - left.z);
+
+		float& zref = zRow[x];
+		if (z >= zref) {
+			continue;
+		}
+
+		Uint8 r, g, b;
+		if (Flat) {
+			r = tri.flatColor.r;
+			g = tri.flatColor.g;
+			b = tri.flatColor.b;
+		}
+		else {
+			r = static_cast<Uint8>(left.color.r + t * (right.color.r - left.color.r));
+			g = static_cast<Uint8>(left.color.g + t * (right.color.g - left.color.g));
+			b = static_cast<Uint8>(left.color.b + t * (right.color.b - left.color.b));
+		}
+
+		float u = 0.0f, v = 0.0f;
+		if (Sampling != SAMPLE_NONE) {
+			// Perspective correct interpolate texture coords
+			float one_over_w = left.one_over_w + t * (right.one_over_w - left.one_over_w);
+			float u_over_w = left.u_over_w + t * (right.u_over_w - left.u_over_w);
+			float v_over_w = left.v_over_w + t * (right.v_over_w - left.v_over_w);
+
+			float inv_w = 1.0f / one_over_w;
+			u = u_over_w * inv_w;
+			v = v_over_w * inv_w;
+		}
+
+		ShadeFragment<BPP, Sampling, Blended>(fmt, tri, zref, z, r, g, b, u, v, pixelRow + x * BPP);
+	}
+}
+
+template <int BPP, bool Flat, int Sampling, bool Blended>
+void WriteBlock(const PixelFormatInfo& fmt, const RasterTriangle& tri, const EdgeBlock& block, float* zRow, Uint8* pixelRow)
+{
+	for (int i = 0; i < EDGE_BLOCK_WIDTH; ++i) {
+		if (!(block.mask & (1u << i))) {
+			continue;
+		}
+
+		int x = block.x + i;
+		Uint8 r, g, b;
+		if (Flat) {
+			r = tri.flatColor.r;
+			g = tri.flatColor.g;
+			b = tri.flatColor.b;
+		}
+		else {
+			r = static_cast<Uint8>(block.r[i]);
+			g = static_cast<Uint8>(block.g[i]);
+			b = static_cast<Uint8>(block.b[i]);
+		}
+
+		ShadeFragment<BPP, Sampling, Blended>(
+			fmt,
+			tri,
+			zRow[x],
+			block.z[i],
+			r,
+			g,
+			b,
+			block.u[i],
+			block.v[i],
+			pixelRow + x * BPP
+		);
+	}
+}
+
+template <int BPP, bool Flat, int Sampling, bool Blended>
+void AssignWriters(SpanWriter& span, BlockWriter& block)
+{
+	span = WriteSpan<BPP, Flat, Sampling, Blended>;
+	block = WriteBlock<BPP, Flat, Sampling, Blended>;
+}
+
+template <int BPP>
+void SelectWriters(bool flat, int sampling, bool blended, SpanWriter& span, BlockWriter& block)
+{
+	// Translucent surfaces are never textured, matching the hardware backends
+	if (blended) {
+		flat ? AssignWriters<BPP, true, SAMPLE_NONE, true>(span, block)
+			 : AssignWriters<BPP, false, SAMPLE_NONE, true>(span, block);
+	}
+	else if (sampling == SAMPLE_BILINEAR) {
+		flat ? AssignWriters<BPP, true, SAMPLE_BILINEAR, false>(span, block)
+			 : AssignWriters<BPP, false, SAMPLE_BILINEAR, false>(span, block);
+	}
+	else if (sampling == SAMPLE_POINT) {
+		flat ? AssignWriters<BPP, true, SAMPLE_POINT, false>(span, block)
+			 : AssignWriters<BPP, false, SAMPLE_POINT, false>(span, block);
+	}
+	else {
+		flat ? AssignWriters<BPP, true, SAMPLE_NONE, false>(span, block)
+			 : AssignWriters<BPP, false, SAMPLE_NONE, false>(span, block);
+	}
+}
+
+bool SelectWriters(int bytesPerPixel, bool flat, int sampling, bool blended, SpanWriter& span, BlockWriter& block)
+{
+	switch (bytesPerPixel) {
+	case 1:
+		SelectWriters<1>(flat, sampling, blended, span, block);
+		return true;
+	case 2:
+		SelectWriters<2>(flat, sampling, blended, span, block);
+		return true;
+	case 3:
+		SelectWriters<3>(flat, sampling, blended, span, block);
+		return true;
+	case 4:
+		SelectWriters<4>(flat, sampling, blended, span, block);
+		return true;
+	default:
+		return false;
+	}
+}
+
+void Direct3DRMSoftwareRenderer::UpdateFormatInfo(const SDL_PixelFormat* format)
+{
+	m_format = format;
+	m_formatEnum = format->format;
+	m_formatInfo.format = format;
+	m_formatInfo.mask[0] = format->Rmask;
+	m_formatInfo.mask[1] = format->Gmask;
+	m_formatInfo.mask[2] = format->Bmask;
+	m_formatInfo.mask[3] = format->Amask;
+	m_formatInfo.shift[0] = format->Rshift;
+	m_formatInfo.shift[1] = format->Gshift;
+	m_formatInfo.shift[2] = format->Bshift;
+	m_formatInfo.shift[3] = format->Ashift;
+	m_formatInfo.loss[0] = format->Rloss;
+	m_formatInfo.loss[1] = format->Gloss;
+	m_formatInfo.loss[2] = format->Bloss;
+	m_formatInfo.loss[3] = format->Aloss;
+	m_bytesPerPixel = format->BytesPerPixel;
+
+	// Let SDL tell us how every channel value expands to 8 bits
+	memset(m_formatInfo.expand, 0, sizeof(m_formatInfo.expand));
+	if (!format->palette) {
+		for (int c = 0; c < 4; ++c) {
+			Uint32 maxValue = std::min<Uint32>(m_formatInfo.mask[c] >> m_formatInfo.shift[c], 255);
+			for (Uint32 v = 0; v <= maxValue; ++v) {
+				Uint8 rgba[4];
+				SDL_GetRGBA(v << m_formatInfo.shift[c], format, &rgba[0], &rgba[1], &rgba[2], &rgba[3]);
+				m_formatInfo.expand[c][v] = rgba[c];
+			}
+		}
+	}
+}
+
 void Direct3DRMSoftwareRenderer::DrawTriangleProjected(
 	const D3DRMVERTEX& v0,
 	const D3DRMVERTEX& v1,
 	const D3DRMVERTEX& v2,
+	SDL_Color c0,
+	SDL_Color c1,
+	SDL_Color c2,
 	const Appearance& appearance
 )
 {
@@ -346,37 +1137,28 @@ void Direct3DRMSoftwareRenderer::DrawTriangleProjected(
 	ProjectVertex(v1.position, p1);
 	ProjectVertex(v2.position, p2);
 
-	Uint8 r, g, b;
-	SDL_Color c0 = ApplyLighting(v0.position, v0.normal, appearance);
-	SDL_Color c1 = {}, c2 = {};
-	if (!appearance.flat) {
-		c1 = ApplyLighting(v1.position, v1.normal, appearance);
-		c2 = ApplyLighting(v2.position, v2.normal, appearance);
+	if (appearance.flat) {
+		c1 = c2 = SDL_Color{};
 	}
 
-	Uint8* pixels = (Uint8*) DDBackBuffer->pixels;
-	int pitch = DDBackBuffer->pitch;
-
-	VertexXY verts[3] = {
-		{p0.x, p0.y, p0.z, p0.w, c0, v0.texCoord.u, v0.texCoord.v},
-		{p1.x, p1.y, p1.z, p1.w, c1, v1.texCoord.u, v1.texCoord.v},
-		{p2.x, p2.y, p2.z, p2.w, c2, v2.texCoord.u, v2.texCoord.v}
+	RasterTriangle tri = {
+		{{p0.x, p0.y, p0.z, p0.w, c0, v0.texCoord.u, v0.texCoord.v},
+		 {p1.x, p1.y, p1.z, p1.w, c1, v1.texCoord.u, v1.texCoord.v},
+		 {p2.x, p2.y, p2.z, p2.w, c2, v2.texCoord.u, v2.texCoord.v}},
+		c0,
+		appearance.color.a,
+		appearance.flat != 0,
+		m_drawSpan,
+		m_drawBlock,
+		{}
 	};
+	VertexXY* verts = tri.verts;
 
-	Uint32 textureId = appearance.textureId;
-	int texturePitch;
-	Uint8* texels = nullptr;
-	int texWidthScale;
-	int texHeightScale;
-	if (textureId != NO_TEXTURE_ID) {
-		SDL_Surface* texture = m_textures[textureId].cached;
-		if (texture) {
-			texturePitch = texture->pitch;
-			texels = static_cast<Uint8*>(texture->pixels);
-			texWidthScale = texture->w - 1;
-			texHeightScale = texture->h - 1;
-		}
+	if (m_drawTexture) {
+		tri.texture = SelectTextureLevel(p0, p1, p2, v0.texCoord, v1.texCoord, v2.texCoord);
+	}
 
+	if (appearance.textureId != NO_TEXTURE_ID) {
 		verts[0].u_over_w = v0.texCoord.u / p0.w;
 		verts[0].v_over_w = v0.texCoord.v / p0.w;
 		verts[0].one_over_w = 1.0f / p0.w;
@@ -401,11 +1183,46 @@ void Direct3DRMSoftwareRenderer::DrawTriangleProjected(
 		std::swap(verts[0], verts[1]);
 	}
 
+	// Bin the triangle into every tile its screen bounds touch
 	int minY = std::max(0, (int) std::ceil(verts[0].y));
 	int maxY = std::min((int) m_height - 1, (int) std::floor(verts[2].y));
+	float minXf = std::min(verts[0].x, std::min(verts[1].x, verts[2].x));
+	float maxXf = std::max(verts[0].x, std::max(verts[1].x, verts[2].x));
+	int minX = std::max(0, (int) std::ceil(minXf));
+	int maxX = std::min((int) m_width - 1, (int) std::floor(maxXf));
+	if (minY > maxY || minX > maxX) {
+		return;
+	}
+
+	Uint32 index = static_cast<Uint32>(m_triangles.size());
+	m_triangles.push_back(tri);
+
+	for (int ty = minY / TileSize; ty <= maxY / TileSize; ++ty) {
+		for (int tx = minX / TileSize; tx <= maxX / TileSize; ++tx) {
+			m_tileBins[ty * m_tilesX + tx].push_back(index);
+		}
+	}
+}
+
+void Direct3DRMSoftwareRenderer::RasterizeTriangle(
+	const RasterTriangle& tri,
+	int tileX0,
+	int tileY0,
+	int tileX1,
+	int tileY1
+)
+{
+	const VertexXY* verts = tri.verts;
+
+	int minY = std::max(tileY0, (int) std::ceil(verts[0].y));
+	int maxY = std::min(tileY1 - 1, (int) std::floor(verts[2].y));
+
+	VertexXY left, right;
+	EdgeRow row = {&m_formatInfo, &tri, &left, &right};
+	row.gouraud = !tri.flat;
+	row.textured = tri.texture.texels && tri.alpha == 255;
 
 	for (int y = minY; y <= maxY; ++y) {
-		VertexXY left, right;
 		if (y < verts[1].y) {
 			left = InterpolateVertex(y, verts[0], verts[1]);
 			right = InterpolateVertex(y, verts[0], verts[2]);
@@ -419,102 +1236,168 @@ void Direct3DRMSoftwareRenderer::DrawTriangleProjected(
 			std::swap(left, right);
 		}
 
-		int startX = std::max(0, (int) std::ceil(left.x));
-		int endX = std::min((int) m_width - 1, (int) std::floor(right.x));
+		int startX = std::max(tileX0, (int) std::ceil(left.x));
+		int endX = std::min(tileX1 - 1, (int) std::floor(right.x));
 
 		float span = right.x - left.x;
 		if (span == 0.0f) {
 			continue;
 		}
 
-		for (int x = startX; x <= endX; ++x) {
-			float t = (x - left.x) / span;
-			float z = left.z + t * (right.z - left.z);
+		if (m_edgeRow) {
+			row.zRow = &m_zBuffer[y * m_width];
+			row.pixelRow = m_pixels + y * m_pitch;
+			m_edgeRow(row, startX, endX);
+		}
+		else {
+			tri.span(m_formatInfo, tri, left, right, startX, endX, &m_zBuffer[y * m_width], m_pixels + y * m_pitch);
+		}
+	}
+}
 
-			int zidx = y * m_width + x;
-			float& zref = m_zBuffer[zidx];
-			if (z >= zref) {
-				continue;
-			}
+void FreeTextureLevels(std::vector<SDL_Surface*>& levels)
+{
+	for (SDL_Surface* level : levels) {
+		SDL_UnlockSurface(level);
+		SDL_FreeSurface(level);
+	}
+	levels.clear();
+}
 
-			Uint8 r, g, b;
-			if (appearance.flat) {
-				r = c0.r;
-				g = c0.g;
-				b = c0.b;
-			}
-			else {
-				r = static_cast<Uint8>(left.color.r + t * (right.color.r - left.color.r));
-				g = static_cast<Uint8>(left.color.g + t * (right.color.g - left.color.g));
-				b = static_cast<Uint8>(left.color.b + t * (right.color.b - left.color.b));
-			}
+Uint32 ReadPixel(const SDL_Surface* surface, int x, int y)
+{
+	const Uint8* addr = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+	switch (surface->format->BytesPerPixel) {
+	case 1:
+		return LoadPixel<1>(addr + x);
+	case 2:
+		return LoadPixel<2>(addr + x * 2);
+	case 3:
+		return LoadPixel<3>(addr + x * 3);
+	default:
+		return LoadPixel<4>(addr + x * 4);
+	}
+}
 
-			Uint8* pixelAddr = pixels + y * pitch + x * m_bytesPerPixel;
-			Uint32 finalColor;
-
-			if (appearance.color.a == 255) {
-				zref = z;
-
-				if (texels) {
-					// Perspective correct interpolate texture coords
-					float one_over_w = left.one_over_w + t * (right.one_over_w - left.one_over_w);
-					float u_over_w = left.u_over_w + t * (right.u_over_w - left.u_over_w);
-					float v_over_w = left.v_over_w + t * (right.v_over_w - left.v_over_w);
-
-					float inv_w = 1.0f / one_over_w;
-					float u = u_over_w * inv_w;
-					float v = v_over_w * inv_w;
-
-					// Tile textures
-					u -= std::floor(u);
-					v -= std::floor(v);
-
-					int texX = static_cast<int>(u * texWidthScale);
-					int texY = static_cast<int>(v * texHeightScale);
-
-					Uint8* texelAddr = texels + texY * texturePitch + texX * m_bytesPerPixel;
-
-					Uint32 texelColor;
-					switch (m_bytesPerPixel) {
-					case 1:
-						texelColor = *texelAddr;
-						break;
-					case 2:
-						texelColor = *(Uint16*) texelAddr;
-						break;
-					case 4:
-						texelColor = *(Uint32*) texelAddr;
-						break;
-					}
-
-					Uint8 tr, tg, tb, ta;
-					SDL_GetRGBA(texelColor, m_format, &tr, &tg, &tb, &ta);
-
-					// Multiply vertex color by texel color
-					r = (r * tr + 127) / 255;
-					g = (g * tg + 127) / 255;
-					b = (b * tb + 127) / 255;
-				}
-
-				finalColor = SDL_MapRGBA(m_format, r, g, b, 255);
-			}
-			else {
-				finalColor = BlendPixel(pixelAddr, r, g, b, appearance.color.a);
-			}
+void WritePixel(SDL_Surface* surface, int x, int y, Uint32 pixel)
+{
+	Uint8* addr = static_cast<Uint8*>(surface->pixels) + y * surface->pitch;
+	switch (surface->format->BytesPerPixel) {
+	case 1:
+		StorePixel<1>(addr + x, pixel);
+		break;
+	case 2:
+		StorePixel<2>(addr + x * 2, pixel);
+		break;
+	case 3:
+		StorePixel<3>(addr + x * 3, pixel);
+		break;
+	default:
+		StorePixel<4>(addr + x * 4, pixel);
+		break;
+	}
+}
+
+// Builds the next mip level with a 2x2 box filter
+SDL_Surface* DownsampleSurface(const SDL_Surface* src)
+{
+	int w = std::max(1, src->w / 2);
+	int h = std::max(1, src->h / 2);
+	const SDL_PixelFormat* format = src->format;
 
-			switch (m_bytesPerPixel) {
-			case 1:
-				*pixelAddr = static_cast<Uint8>(finalColor);
-				break;
-			case 2:
-				*reinterpret_cast<Uint16*>(pixelAddr) = static_cast<Uint16>(finalColor);
-				break;
-			case 4:
-				*reinterpret_cast<Uint32*>(pixelAddr) = finalColor;
-				break;
+	SDL_Surface* dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, format->BitsPerPixel, format->format);
+	if (!dst) {
+		return nullptr;
+	}
+	if (format->palette) {
+		SDL_SetSurfacePalette(dst, format->palette);
+	}
+	SDL_LockSurface(dst);
+
+	for (int y = 0; y < h; ++y) {
+		int sy0 = std::min(y * 2, src->h - 1);
+		int sy1 = std::min(y * 2 + 1, src->h - 1);
+		for (int x = 0; x < w; ++x) {
+			int sx0 = std::min(x * 2, src->w - 1);
+			int sx1 = std::min(x * 2 + 1, src->w - 1);
+			const Uint32 texels[4] = {
+				ReadPixel(src, sx0, sy0),
+				ReadPixel(src, sx1, sy0),
+				ReadPixel(src, sx0, sy1),
+				ReadPixel(src, sx1, sy1)
+			};
+
+			int sum[4] = {};
+			for (Uint32 texel : texels) {
+				Uint8 r, g, b, a;
+				SDL_GetRGBA(texel, format, &r, &g, &b, &a);
+				sum[0] += r;
+				sum[1] += g;
+				sum[2] += b;
+				sum[3] += a;
 			}
+
+			WritePixel(
+				dst,
+				x,
+				y,
+				SDL_MapRGBA(format, (sum[0] + 2) / 4, (sum[1] + 2) / 4, (sum[2] + 2) / 4, (sum[3] + 2) / 4)
+			);
+		}
+	}
+
+	return dst;
+}
+
+std::vector<SDL_Surface*> Direct3DRMSoftwareRenderer::UploadTexture(SDL_Surface* source)
+{
+	std::vector<SDL_Surface*> levels;
+
+	SDL_Surface* level = SDL_ConvertSurface(source, GetOutputSurface()->format, 0);
+	if (!level) {
+		return levels;
+	}
+	SDL_LockSurface(level);
+	levels.push_back(level);
+
+	while (m_mipmaps && (level->w > 1 || level->h > 1)) {
+		level = DownsampleSurface(level);
+		if (!level) {
+			break;
 		}
+		levels.push_back(level);
 	}
+
+	return levels;
+}
+
+// Picks the mip level whose texels are closest to one per covered pixel for this triangle
+TextureSampler Direct3DRMSoftwareRenderer::SelectTextureLevel(
+	const D3DRMVECTOR4D& p0,
+	const D3DRMVECTOR4D& p1,
+	const D3DRMVECTOR4D& p2,
+	const TexCoord& t0,
+	const TexCoord& t1,
+	const TexCoord& t2
+) const
+{
+	const std::vector<SDL_Surface*>& levels = m_drawTexture->levels;
+	size_t level = 0;
+
+	float screenArea = std::fabs((p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y));
+	if (levels.size() > 1 && screenArea > 0.0f) {
+		float uvArea = std::fabs((t1.u - t0.u) * (t2.v - t0.v) - (t2.u - t0.u) * (t1.v - t0.v));
+		float texelsPerPixel = uvArea * levels[0]->w * levels[0]->h / screenArea;
+
+		// Every level has a quarter of the texels of the one before it
+		while (level + 1 < levels.size() && texelsPerPixel >= 4.0f) {
+			texelsPerPixel *= 0.25f;
+			++level;
+		}
+	}
+
+	SDL_Surface* surface = levels[level];
+	return {static_cast<Uint8*>(surface->pixels), surface->pitch, surface->w - 1, surface->h - 1};
 }
 
 struct CacheDestroyContext {
@@ -529,12 +1412,14 @@ void Direct3DRMSoftwareRenderer::AddTextureDestroyCallback(Uint32 id, IDirect3DR
 		[](IDirect3DRMObject* obj, void* arg) {
 			auto* ctx = static_cast<CacheDestroyContext*>(arg);
 			auto& cacheEntry = ctx->renderer->m_textures[ctx->id];
-			if (cacheEntry.cached) {
-				SDL_UnlockSurface(cacheEntry.cached);
-				SDL_FreeSurface(cacheEntry.cached);
-				cacheEntry.cached = nullptr;
-				cacheEntry.texture = nullptr;
+			if (!cacheEntry.levels.empty()) {
+				// Binned triangles may still sample these surfaces
+				ctx->renderer->FlushTiles();
+				FreeTextureLevels(cacheEntry.levels);
 			}
+			// Even without levels the ID must not keep pointing at the destroyed texture
+			cacheEntry.texture = nullptr;
+			ctx->renderer->m_textureIds.Release(ctx->id);
 			delete ctx;
 		},
 		ctx
@@ -547,37 +1432,24 @@ Uint32 Direct3DRMSoftwareRenderer::GetTextureId(IDirect3DRMTexture* iTexture)
 	auto surface = static_cast<DirectDrawSurfaceImpl*>(texture->m_surface);
 
 	// Check if already mapped
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& texRef = m_textures[i];
-		if (texRef.texture == texture) {
-			if (texRef.version != texture->m_version) {
-				// Update animated textures
-				SDL_FreeSurface(texRef.cached);
-				texRef.cached = SDL_ConvertSurface(surface->m_surface, DDBackBuffer->format, 0);
-				SDL_LockSurface(texRef.cached);
-				texRef.version = texture->m_version;
-			}
-			return i;
-		}
-	}
-
-	SDL_Surface* convertedRender = SDL_ConvertSurface(surface->m_surface, DDBackBuffer->format, 0);
-	SDL_LockSurface(convertedRender);
-
-	// Reuse freed slot
-	for (Uint32 i = 0; i < m_textures.size(); ++i) {
-		auto& texRef = m_textures[i];
-		if (!texRef.texture) {
-			texRef = {texture, texture->m_version, convertedRender};
-			AddTextureDestroyCallback(i, texture);
-			return i;
+	Uint32 id;
+	if (m_textureIds.Find(texture, id)) {
+		auto& texRef = m_textures[id];
+		if (texRef.version != texture->m_version) {
+			// Update animated textures
+			FlushTiles();
+			FreeTextureLevels(texRef.levels);
+			texRef.levels = UploadTexture(surface->m_surface);
+			texRef.version = texture->m_version;
 		}
+		return id;
 	}
 
-	// Append new
-	m_textures.push_back({texture, texture->m_version, convertedRender});
-	AddTextureDestroyCallback(static_cast<Uint32>(m_textures.size() - 1), texture);
-	return static_cast<Uint32>(m_textures.size() - 1);
+	// Reuses a freed slot if there is one
+	id = m_textureIds.Acquire(texture);
+	HandleSlot(m_textures, id) = {texture, texture->m_version, UploadTexture(surface->m_surface)};
+	AddTextureDestroyCallback(id, texture);
+	return id;
 }
 
 MeshCache UploadMesh(const MeshGroup& meshGroup)
@@ -616,6 +1488,7 @@ void Direct3DRMSoftwareRenderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMe
 				cacheEntry.meshGroup = nullptr;
 				cacheEntry.vertices.clear();
 				cacheEntry.indices.clear();
+				ctx->renderer->m_meshIds.Release(ctx->id);
 			}
 			delete ctx;
 		},
@@ -625,40 +1498,29 @@ void Direct3DRMSoftwareRenderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMe
 
 Uint32 Direct3DRMSoftwareRenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup)
 {
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
-				cache = std::move(UploadMesh(*meshGroup));
-			}
-			return i;
-		}
-	}
-
-	auto newCache = UploadMesh(*meshGroup);
-
-	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
-			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
-			return i;
+	Uint32 id;
+	if (m_meshIds.Find(meshGroup, id)) {
+		auto& cache = m_meshs[id];
+		if (cache.version != meshGroup->version) {
+			cache = std::move(UploadMesh(*meshGroup));
 		}
+		return id;
 	}
 
-	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
-	return (Uint32) (m_meshs.size() - 1);
+	id = m_meshIds.Acquire(meshGroup);
+	HandleSlot(m_meshs, id) = UploadMesh(*meshGroup);
+	AddMeshDestroyCallback(id, mesh);
+	return id;
 }
 
 DWORD Direct3DRMSoftwareRenderer::GetWidth()
 {
-	return m_width;
+	return m_outputWidth;
 }
 
 DWORD Direct3DRMSoftwareRenderer::GetHeight()
 {
-	return m_height;
+	return m_outputHeight;
 }
 
 void Direct3DRMSoftwareRenderer::GetDesc(D3DDEVICEDESC* halDesc, D3DDEVICEDESC* helDesc)
@@ -681,33 +1543,111 @@ const char* Direct3DRMSoftwareRenderer::GetName()
 
 HRESULT Direct3DRMSoftwareRenderer::BeginFrame()
 {
-	if (!DDBackBuffer || !SDL_LockSurface(DDBackBuffer)) {
+	SDL_Surface* output = GetOutputSurface();
+	if (!output) {
+		return DDERR_GENERIC;
+	}
+	m_frameStart = SDL_GetPerformanceCounter();
+	m_transparentPass = false;
+
+	// Follow the back buffer if it was recreated at another size
+	m_outputWidth = output->w;
+	m_outputHeight = output->h;
+	UpdateRenderSize();
+
+	// Below the back buffer's size, render into a surface seeded with the scaled down back buffer, so blended
+	// geometry has what was drawn there before the scene underneath it. Only the pixels the scene covers are
+	// scaled back up, the rest of the back buffer never leaves it.
+	m_frameTarget = output;
+	if (m_width != m_outputWidth || m_height != m_outputHeight) {
+		if (m_renderTarget && m_renderTarget->format->format != output->format->format) {
+			SDL_FreeSurface(m_renderTarget);
+			m_renderTarget = nullptr;
+		}
+		if (!m_renderTarget) {
+			m_renderTarget = SDL_CreateRGBSurfaceWithFormat(
+				0,
+				m_width,
+				m_height,
+				output->format->BitsPerPixel,
+				output->format->format
+			);
+			if (!m_renderTarget) {
+				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create render target: %s", SDL_GetError());
+				return DDERR_GENERIC;
+			}
+			SDL_SetSurfaceBlendMode(m_renderTarget, SDL_BLENDMODE_NONE);
+		}
+		Uint64 start = StatStart();
+		SDL_BlendMode blendMode;
+		SDL_GetSurfaceBlendMode(output, &blendMode);
+		SDL_SetSurfaceBlendMode(output, SDL_BLENDMODE_NONE);
+		SDL_BlitScaled(output, nullptr, m_renderTarget, nullptr);
+		SDL_SetSurfaceBlendMode(output, blendMode);
+		StatLap(m_stats.present, start);
+		m_frameTarget = m_renderTarget;
+	}
+
+	if (!SDL_LockSurface(m_frameTarget)) {
 		return DDERR_GENERIC;
 	}
 	ClearZBuffer();
+	m_hiZValid = false;
+	if (!m_workersStarted) {
+		StartWorkers();
+	}
 
-	m_format = DDBackBuffer->format;
-	m_palette = m_format->palette;
-	m_bytesPerPixel = m_format->BitsPerPixel / 8;
+	if (m_frameTarget->format != m_format || m_frameTarget->format->format != m_formatEnum) {
+		UpdateFormatInfo(m_frameTarget->format);
+	}
+	m_pixels = static_cast<Uint8*>(m_frameTarget->pixels);
+	m_pitch = m_frameTarget->pitch;
 
 	return DD_OK;
 }
 
 void Direct3DRMSoftwareRenderer::EnableTransparency()
 {
+	// Only split the passes when measuring, a single flush per frame is cheaper
+	if (m_statsEnabled) {
+		FlushTiles();
+	}
+	m_transparentPass = true;
 }
 
-void Direct3DRMSoftwareRenderer::SubmitDraw(
-	DWORD meshId,
+// Resolves the texture, pixel routines and specular table shared by every instance of a draw
+bool Direct3DRMSoftwareRenderer::PrepareDraw(const Appearance& appearance)
+{
+	m_drawTexture = nullptr;
+	if (appearance.textureId != NO_TEXTURE_ID && !m_textures[appearance.textureId].levels.empty()) {
+		m_drawTexture = &m_textures[appearance.textureId];
+	}
+	int sampling = !m_drawTexture ? SAMPLE_NONE : m_bilinear ? SAMPLE_BILINEAR : SAMPLE_POINT;
+	if (!SelectWriters(
+			m_bytesPerPixel,
+			appearance.flat != 0,
+			sampling,
+			appearance.color.a != 255,
+			m_drawSpan,
+			m_drawBlock
+		)) {
+		return false;
+	}
+
+	m_drawSpecular = appearance.shininess > 0.0f ? GetSpecularTable(appearance.shininess) : nullptr;
+	return true;
+}
+
+void Direct3DRMSoftwareRenderer::DrawMesh(
+	MeshCache& mesh,
 	const D3DRMMATRIX4D& modelViewMatrix,
 	const Matrix3x3& normalMatrix,
 	const Appearance& appearance
 )
 {
+	Uint64 start = StatStart();
 	memcpy(m_normalMatrix, normalMatrix, sizeof(Matrix3x3));
 
-	auto& mesh = m_meshs[meshId];
-
 	// Pre-transform all vertex positions and normals
 	m_transformedVerts.clear();
 	m_transformedVerts.reserve(mesh.vertices.size());
@@ -717,6 +1657,10 @@ void Direct3DRMSoftwareRenderer::SubmitDraw(
 		dst.normal = src.normal;
 		dst.texCoord = src.texCoord;
 	}
+	StatLap(m_stats.transform, start);
+
+	LightMesh(mesh, modelViewMatrix, appearance);
+	StatLap(m_stats.light, start);
 
 	// Assemble triangles using index buffer
 	for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
@@ -724,14 +1668,59 @@ void Direct3DRMSoftwareRenderer::SubmitDraw(
 			{m_transformedVerts[mesh.indices[i]],
 			 m_transformedVerts[mesh.indices[i + 1]],
 			 m_transformedVerts[mesh.indices[i + 2]]},
+			{mesh.litColors[mesh.indices[i]], mesh.litColors[mesh.indices[i + 1]], mesh.litColors[mesh.indices[i + 2]]},
 			appearance
 		);
 	}
+	StatLap(m_stats.clip, start);
+	if (m_statsEnabled) {
+		m_stats.draws++;
+	}
+}
+
+void Direct3DRMSoftwareRenderer::SubmitDraw(
+	DWORD meshId,
+	const D3DRMMATRIX4D& modelViewMatrix,
+	const Matrix3x3& normalMatrix,
+	const Appearance& appearance
+)
+{
+	if (PrepareDraw(appearance)) {
+		DrawMesh(m_meshs[meshId], modelViewMatrix, normalMatrix, appearance);
+	}
+}
+
+void Direct3DRMSoftwareRenderer::SubmitDrawInstanced(
+	DWORD meshId,
+	const DrawInstance* instances,
+	size_t count,
+	const Appearance& appearance
+)
+{
+	if (!PrepareDraw(appearance)) {
+		return;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		DrawMesh(m_meshs[meshId], instances[i].modelViewMatrix, instances[i].normalMatrix, appearance);
+	}
 }
 
 HRESULT Direct3DRMSoftwareRenderer::FinalizeFrame()
 {
-	SDL_UnlockSurface(DDBackBuffer);
+	FlushTiles();
+	if (m_frameTarget == m_renderTarget) {
+		Uint64 start = StatStart();
+		CompositeRenderTarget();
+		StatLap(m_stats.present, start);
+	}
+	SDL_UnlockSurface(m_frameTarget);
+	if (m_statsEnabled) {
+		m_stats.frames++;
+	}
+
+	if (m_frameBudget > 0.0f) {
+		UpdateDynamicResolution((float) (SDL_GetPerformanceCounter() - m_frameStart) / SDL_GetPerformanceFrequency());
+	}
 
 	return DD_OK;
 }
@@ -7,6 +7,7 @@
 #include "d3drmmesh_impl.h"
 #include "d3drmobject_impl.h"
 #include "d3drmrenderer.h"
+#include "d3drmrenderer_capture.h"
 #ifdef USE_OPENGL1
 #include "d3drmrenderer_opengl1.h"
 #endif
@@ -174,6 +175,10 @@ HRESULT Direct3DRMImpl::CreateDeviceFromSurface(
 		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Device GUID not recognized");
 		return E_NOINTERFACE;
 	}
+	const char* capture = SDL_GetHint(MINIWIN_HINT_CAPTURE);
+	if (capture && *capture) {
+		renderer = new Direct3DRMCaptureRenderer(renderer, capture);
+	}
 	*outDevice =
 		static_cast<IDirect3DRMDevice2*>(new Direct3DRMDevice2Impl(DDSDesc.dwWidth, DDSDesc.dwHeight, renderer));
 	return DD_OK;
@@ -5,8 +5,11 @@
 #include "d3drmvisual_impl.h"
 #include "miniwin.h"
 
+#include <algorithm>
 #include <cstring>
 
+Uint32 Direct3DRMFrameImpl::s_hierarchyVersion = 0;
+
 Direct3DRMFrameImpl::Direct3DRMFrameImpl(Direct3DRMFrameImpl* parent)
 {
 	m_children = new Direct3DRMFrameArrayImpl;
@@ -22,6 +25,7 @@ Direct3DRMFrameImpl::Direct3DRMFrameImpl(Direct3DRMFrameImpl* parent)
 
 Direct3DRMFrameImpl::~Direct3DRMFrameImpl()
 {
+	s_hierarchyVersion++;
 	m_children->Release();
 	m_lights->Release();
 	m_visuals->Release();
@@ -55,6 +59,8 @@ HRESULT Direct3DRMFrameImpl::AddChild(IDirect3DRMFrame* child)
 		SDL_assert(result == DD_OK);
 	}
 	childImpl->m_parent = this;
+	childImpl->MarkWorldDirty();
+	s_hierarchyVersion++;
 	return m_children->AddElement(child);
 }
 
@@ -64,6 +70,8 @@ HRESULT Direct3DRMFrameImpl::DeleteChild(IDirect3DRMFrame* child)
 	HRESULT result = m_children->DeleteElement(childImpl);
 	if (result == DD_OK) {
 		childImpl->m_parent = nullptr;
+		childImpl->MarkWorldDirty();
+		s_hierarchyVersion++;
 	}
 	return result;
 }
@@ -92,6 +100,7 @@ HRESULT Direct3DRMFrameImpl::AddTransform(D3DRMCOMBINETYPE combine, D3DRMMATRIX4
 	switch (combine) {
 	case D3DRMCOMBINETYPE::REPLACE:
 		std::memcpy(m_transform, matrix, sizeof(m_transform));
+		MarkWorldDirty();
 		return DD_OK;
 	default:
 		MINIWIN_NOT_IMPLEMENTED();
@@ -113,11 +122,35 @@ HRESULT Direct3DRMFrameImpl::GetPosition(IDirect3DRMFrame* reference, D3DVECTOR*
 
 HRESULT Direct3DRMFrameImpl::AddVisual(IDirect3DRMVisual* visual)
 {
-	return m_visuals->AddElement(visual);
+	HRESULT result = m_visuals->AddElement(visual);
+	if (result != DD_OK) {
+		return result;
+	}
+	s_hierarchyVersion++;
+
+	IDirect3DRMFrame* frame = nullptr;
+	visual->QueryInterface(IID_IDirect3DRMFrame, (void**) &frame);
+	if (frame) {
+		auto* frameImpl = static_cast<Direct3DRMFrameImpl*>(frame);
+		m_visualFrames.push_back(frameImpl);
+		frameImpl->MarkWorldDirty();
+		frame->Release();
+	}
+	return DD_OK;
 }
 
 HRESULT Direct3DRMFrameImpl::DeleteVisual(IDirect3DRMVisual* visual)
 {
+	IDirect3DRMFrame* frame = nullptr;
+	visual->QueryInterface(IID_IDirect3DRMFrame, (void**) &frame);
+	if (frame) {
+		auto it = std::find(m_visualFrames.begin(), m_visualFrames.end(), static_cast<Direct3DRMFrameImpl*>(frame));
+		if (it != m_visualFrames.end()) {
+			m_visualFrames.erase(it);
+		}
+		frame->Release();
+	}
+	s_hierarchyVersion++;
 	return m_visuals->DeleteElement(visual);
 }
 
@@ -183,3 +216,55 @@ HRESULT Direct3DRMFrameImpl::GetChildren(IDirect3DRMFrameArray** children)
 	m_children->AddRef();
 	return DD_OK;
 }
+
+void Direct3DRMFrameImpl::MarkWorldDirty()
+{
+	// A dirty frame always has dirty descendants, so there is nothing left to do
+	if (m_worldDirty) {
+		return;
+	}
+	m_worldDirty = true;
+	MarkChildrenWorldDirty();
+}
+
+void Direct3DRMFrameImpl::MarkChildrenWorldDirty()
+{
+	for (Direct3DRMFrameImpl* child : m_children->m_items) {
+		child->MarkWorldDirty();
+	}
+	for (Direct3DRMFrameImpl* child : m_visualFrames) {
+		child->MarkWorldDirty();
+	}
+}
+
+void Direct3DRMFrameImpl::UpdateWorldMatrix(Direct3DRMFrameImpl* parent)
+{
+	if (!m_worldDirty && m_worldParent == parent) {
+		return;
+	}
+
+	if (parent) {
+		MultiplyMatrix(m_worldMatrix, parent->m_worldMatrix, m_transform);
+	}
+	else {
+		std::memcpy(m_worldMatrix, m_transform, sizeof(m_worldMatrix));
+	}
+	D3DRMMatrixInvertForNormal(m_normalMatrix, m_worldMatrix);
+
+	m_worldParent = parent;
+	m_worldDirty = false;
+	m_worldVersion++;
+
+	// Children may still hold matrices derived from the previous value
+	MarkChildrenWorldDirty();
+}
+
+const D3DRMMATRIX4D& Direct3DRMFrameImpl::GetWorldMatrix()
+{
+	Direct3DRMFrameImpl* parent = m_parent != this ? m_parent : nullptr;
+	if (parent) {
+		parent->GetWorldMatrix();
+	}
+	UpdateWorldMatrix(parent);
+	return m_worldMatrix;
+}
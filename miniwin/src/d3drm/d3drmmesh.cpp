@@ -106,6 +106,31 @@ const MeshGroup& Direct3DRMMeshImpl::GetGroup(D3DRMGROUPINDEX groupIndex)
 	return m_groups[groupIndex];
 }
 
+const BVH& Direct3DRMMeshImpl::GetGroupBVH(D3DRMGROUPINDEX groupIndex)
+{
+	if (m_groupBVHs.size() < m_groups.size()) {
+		m_groupBVHs.resize(m_groups.size());
+	}
+
+	const MeshGroup& group = m_groups[groupIndex];
+	MeshGroupBVH& cache = m_groupBVHs[groupIndex];
+	if (cache.version != group.version) {
+		std::vector<D3DRMBOX> boxes(group.indices.size() / 3);
+		for (size_t face = 0; face < boxes.size(); ++face) {
+			const D3DVECTOR& v0 = group.vertices[group.indices[face * 3 + 0]].position;
+			const D3DVECTOR& v1 = group.vertices[group.indices[face * 3 + 1]].position;
+			const D3DVECTOR& v2 = group.vertices[group.indices[face * 3 + 2]].position;
+			boxes[face] = {
+				{std::min({v0.x, v1.x, v2.x}), std::min({v0.y, v1.y, v2.y}), std::min({v0.z, v1.z, v2.z})},
+				{std::max({v0.x, v1.x, v2.x}), std::max({v0.y, v1.y, v2.y}), std::max({v0.z, v1.z, v2.z})}
+			};
+		}
+		cache.bvh.Build(boxes);
+		cache.version = group.version;
+	}
+	return cache.bvh;
+}
+
 DWORD Direct3DRMMeshImpl::GetGroupCount()
 {
 	return m_groups.size();
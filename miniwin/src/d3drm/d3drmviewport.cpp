@@ -9,6 +9,7 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_stdinc.h>
+#include <algorithm>
 #include <cassert>
 #include <float.h>
 #include <functional>
@@ -17,46 +18,11 @@
 Direct3DRMViewportImpl::Direct3DRMViewportImpl(DWORD width, DWORD height, Direct3DRMRenderer* renderer)
 	: m_width(width), m_height(height), m_renderer(renderer)
 {
-}
-
-static void D3DRMMatrixMultiply(D3DRMMATRIX4D out, const D3DRMMATRIX4D a, const D3DRMMATRIX4D b)
-{
-	for (int i = 0; i < 4; ++i) {
-		for (int j = 0; j < 4; ++j) {
-			out[i][j] = 0.0f;
-			for (int k = 0; k < 4; ++k) {
-				out[i][j] += a[i][k] * b[k][j];
-			}
-		}
-	}
-}
-
-static void D3DRMMatrixInvertForNormal(Matrix3x3 out, const D3DRMMATRIX4D m)
-{
-	float a = m[0][0], b = m[0][1], c = m[0][2];
-	float d = m[1][0], e = m[1][1], f = m[1][2];
-	float g = m[2][0], h = m[2][1], i = m[2][2];
+	const char* picking = SDL_GetHint(MINIWIN_HINT_PICKING);
+	m_linearPick = picking && SDL_strcasecmp(picking, "linear") == 0;
 
-	float det = a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
-
-	if (fabs(det) < 1e-6f) {
-		memset(out, 0, sizeof(Matrix3x3));
-		return;
-	}
-
-	float invDet = 1.0f / det;
-
-	out[0][0] = (e * i - f * h) * invDet;
-	out[1][0] = (c * h - b * i) * invDet;
-	out[2][0] = (b * f - c * e) * invDet;
-
-	out[0][1] = (f * g - d * i) * invDet;
-	out[1][1] = (a * i - c * g) * invDet;
-	out[2][1] = (c * d - a * f) * invDet;
-
-	out[0][2] = (d * h - e * g) * invDet;
-	out[1][2] = (b * g - a * h) * invDet;
-	out[2][2] = (a * e - b * d) * invDet;
+	const char* occlusion = SDL_GetHint(MINIWIN_HINT_OCCLUSION_CULLING);
+	m_occlusionCulling = !occlusion || SDL_strcasecmp(occlusion, "off") != 0;
 }
 
 static void D3DRMMatrixInvertOrthogonal(D3DRMMATRIX4D out, const D3DRMMATRIX4D m)
@@ -79,32 +45,18 @@ static void D3DRMMatrixInvertOrthogonal(D3DRMMATRIX4D out, const D3DRMMATRIX4D m
 
 static void ComputeFrameWorldMatrix(IDirect3DRMFrame* frame, D3DRMMATRIX4D out)
 {
-	D3DRMMATRIX4D acc = {{1.f, 0.f, 0.f, 0.f}, {0.f, 1.f, 0.f, 0.f}, {0.f, 0.f, 1.f, 0.f}, {0.f, 0.f, 0.f, 1.f}};
-
-	IDirect3DRMFrame* cur = frame;
-	while (cur) {
-		auto* impl = static_cast<Direct3DRMFrameImpl*>(cur);
-		D3DRMMATRIX4D tmp;
-		D3DRMMatrixMultiply(tmp, impl->m_transform, acc);
-		memcpy(acc, tmp, sizeof(acc));
-
-		if (cur == impl->m_parent) {
-			break;
-		}
-		cur = impl->m_parent;
-	}
-	memcpy(out, acc, sizeof(acc));
+	memcpy(out, static_cast<Direct3DRMFrameImpl*>(frame)->GetWorldMatrix(), sizeof(D3DRMMATRIX4D));
 }
 
 void Direct3DRMViewportImpl::CollectLightsFromFrame(
 	IDirect3DRMFrame* frame,
-	D3DRMMATRIX4D parentToWorld,
+	Direct3DRMFrameImpl* parent,
 	std::vector<SceneLight>& lights
 )
 {
 	auto* frameImpl = static_cast<Direct3DRMFrameImpl*>(frame);
-	D3DRMMATRIX4D worldMatrix;
-	D3DRMMatrixMultiply(worldMatrix, parentToWorld, frameImpl->m_transform);
+	frameImpl->UpdateWorldMatrix(parent);
+	const D3DRMMATRIX4D& worldMatrix = frameImpl->m_worldMatrix;
 
 	IDirect3DRMLightArray* lightArray = nullptr;
 	frame->GetLights(&lightArray);
@@ -142,7 +94,7 @@ void Direct3DRMViewportImpl::CollectLightsFromFrame(
 	for (DWORD i = 0; i < n; ++i) {
 		IDirect3DRMFrame* childFrame = nullptr;
 		children->GetElement(i, &childFrame);
-		CollectLightsFromFrame(childFrame, worldMatrix, lights);
+		CollectLightsFromFrame(childFrame, frameImpl, lights);
 		childFrame->Release();
 	}
 	children->Release();
@@ -166,7 +118,12 @@ void Direct3DRMViewportImpl::BuildViewFrustumPlanes()
 	m_frustumPlanes[5] = {{0.0f, 0.0f, -1.0f}, m_back};  // Far  (Z <= m_back)
 }
 
-bool IsMeshInFrustum(Direct3DRMMeshImpl* mesh, const D3DRMMATRIX4D& worldViewMatrix, const Plane* frustumPlanes)
+bool IsMeshInFrustum(
+	Direct3DRMMeshImpl* mesh,
+	const D3DRMMATRIX4D& worldViewMatrix,
+	const Plane* frustumPlanes,
+	D3DRMBOX& viewBox
+)
 {
 	D3DRMBOX box;
 	mesh->GetBox(&box);
@@ -186,6 +143,16 @@ bool IsMeshInFrustum(Direct3DRMMeshImpl* mesh, const D3DRMMATRIX4D& worldViewMat
 		corner = TransformPoint(corner, worldViewMatrix);
 	}
 
+	viewBox.min = viewBox.max = boxCorners[0];
+	for (const D3DVECTOR& corner : boxCorners) {
+		viewBox.min.x = std::min(viewBox.min.x, corner.x);
+		viewBox.min.y = std::min(viewBox.min.y, corner.y);
+		viewBox.min.z = std::min(viewBox.min.z, corner.z);
+		viewBox.max.x = std::max(viewBox.max.x, corner.x);
+		viewBox.max.y = std::max(viewBox.max.y, corner.y);
+		viewBox.max.z = std::max(viewBox.max.z, corner.z);
+	}
+
 	for (int i = 0; i < 6; ++i) {
 		const Plane& plane = frustumPlanes[i];
 		int out = 0;
@@ -220,17 +187,12 @@ float CalculateDepth(const D3DRMMATRIX4D& viewProj, const D3DRMMATRIX4D& worldMa
 	return (clipPos.z / clipPos.w + 1.0f) * 0.5f;
 }
 
-void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3DRMMATRIX4D parentMatrix)
+void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, Direct3DRMFrameImpl* parent)
 {
 	Direct3DRMFrameImpl* frameImpl = static_cast<Direct3DRMFrameImpl*>(frame);
-	D3DRMMATRIX4D localMatrix;
-	memcpy(localMatrix, frameImpl->m_transform, sizeof(D3DRMMATRIX4D));
-
-	D3DRMMATRIX4D worldMatrix;
-	D3DRMMatrixMultiply(worldMatrix, parentMatrix, localMatrix);
-
-	Matrix3x3 worldMatrixInvert;
-	D3DRMMatrixInvertForNormal(worldMatrixInvert, worldMatrix);
+	frameImpl->UpdateWorldMatrix(parent);
+	const D3DRMMATRIX4D& worldMatrix = frameImpl->m_worldMatrix;
+	const Matrix3x3& worldMatrixInvert = frameImpl->m_normalMatrix;
 
 	IDirect3DRMVisualArray* visuals = nullptr;
 	frame->GetVisuals(&visuals);
@@ -242,7 +204,7 @@ void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3D
 		IDirect3DRMFrame* childFrame = nullptr;
 		visual->QueryInterface(IID_IDirect3DRMFrame, (void**) &childFrame);
 		if (childFrame) {
-			CollectMeshesFromFrame(childFrame, worldMatrix);
+			CollectMeshesFromFrame(childFrame, frameImpl);
 			childFrame->Release();
 			visual->Release();
 			continue;
@@ -252,8 +214,9 @@ void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3D
 		visual->QueryInterface(IID_IDirect3DRMMesh, (void**) &mesh);
 		if (mesh) {
 			D3DRMMATRIX4D modelViewMatrix;
+			D3DRMBOX viewBox;
 			MultiplyMatrix(modelViewMatrix, worldMatrix, m_viewMatrix);
-			if (IsMeshInFrustum(mesh, modelViewMatrix, m_frustumPlanes)) {
+			if (IsMeshInFrustum(mesh, modelViewMatrix, m_frustumPlanes, viewBox)) {
 				DWORD groupCount = mesh->GetGroupCount();
 				for (DWORD gi = 0; gi < groupCount; ++gi) {
 					const MeshGroup& meshGroup = mesh->GetGroup(gi);
@@ -265,25 +228,17 @@ void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3D
 						meshGroup.quality == D3DRMRENDER_FLAT || meshGroup.quality == D3DRMRENDER_UNLITFLAT
 					};
 
-					if (appearance.color.a != 255) {
-						m_deferredDraws.push_back(
-							{m_renderer->GetMeshId(mesh, &meshGroup),
-							 {},
-							 {},
-							 appearance,
-							 CalculateDepth(m_viewProjectionwMatrix, worldMatrix)}
-						);
-						memcpy(m_deferredDraws.back().modelViewMatrix, modelViewMatrix, sizeof(D3DRMMATRIX4D));
-						memcpy(m_deferredDraws.back().normalMatrix, worldMatrixInvert, sizeof(Matrix3x3));
-					}
-					else {
-						m_renderer->SubmitDraw(
-							m_renderer->GetMeshId(mesh, &meshGroup),
-							modelViewMatrix,
-							worldMatrixInvert,
-							appearance
-						);
-					}
+					auto& draws = appearance.color.a != 255 ? m_deferredDraws : m_opaqueDraws;
+					draws.push_back(
+						{m_renderer->GetMeshId(mesh, &meshGroup),
+						 {},
+						 {},
+						 appearance,
+						 CalculateDepth(m_viewProjectionwMatrix, worldMatrix),
+						 viewBox}
+					);
+					memcpy(draws.back().modelViewMatrix, modelViewMatrix, sizeof(D3DRMMATRIX4D));
+					memcpy(draws.back().normalMatrix, worldMatrixInvert, sizeof(Matrix3x3));
 				}
 			}
 			mesh->Release();
@@ -293,6 +248,93 @@ void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3D
 	visuals->Release();
 }
 
+static bool SameAppearance(const Appearance& a, const Appearance& b)
+{
+	return a.textureId == b.textureId && a.flat == b.flat && a.shininess == b.shininess && a.color.r == b.color.r &&
+		   a.color.g == b.color.g && a.color.b == b.color.b && a.color.a == b.color.a;
+}
+
+static Uint32 PackColor(const SDL_Color& c)
+{
+	return (Uint32) c.r << 24 | (Uint32) c.g << 16 | (Uint32) c.b << 8 | c.a;
+}
+
+// Orders opaque draws by render state (texture, mesh, material) and front to back within each state
+static bool OpaqueDrawLess(const DeferredDrawCommand& a, const DeferredDrawCommand& b)
+{
+	if (a.appearance.textureId != b.appearance.textureId) {
+		return a.appearance.textureId < b.appearance.textureId;
+	}
+	if (a.meshId != b.meshId) {
+		return a.meshId < b.meshId;
+	}
+	if (a.appearance.flat != b.appearance.flat) {
+		return a.appearance.flat < b.appearance.flat;
+	}
+	if (a.appearance.shininess != b.appearance.shininess) {
+		return a.appearance.shininess < b.appearance.shininess;
+	}
+	Uint32 colorA = PackColor(a.appearance.color);
+	Uint32 colorB = PackColor(b.appearance.color);
+	if (colorA != colorB) {
+		return colorA < colorB;
+	}
+	return a.depth < b.depth;
+}
+
+// Hands runs of draws sharing a mesh and appearance to the renderer as one instanced submit
+void Direct3DRMViewportImpl::SubmitDrawCommands(const DeferredDrawCommand* commands, size_t count)
+{
+	size_t i = 0;
+	while (i < count) {
+		const DeferredDrawCommand& first = commands[i];
+		size_t end = i + 1;
+		while (end < count && commands[end].meshId == first.meshId &&
+			   SameAppearance(commands[end].appearance, first.appearance)) {
+			++end;
+		}
+
+		if (end - i == 1) {
+			m_renderer->SubmitDraw(first.meshId, first.modelViewMatrix, first.normalMatrix, first.appearance);
+		}
+		else {
+			m_drawInstances.resize(end - i);
+			for (size_t j = i; j < end; ++j) {
+				DrawInstance& instance = m_drawInstances[j - i];
+				memcpy(instance.modelViewMatrix, commands[j].modelViewMatrix, sizeof(D3DRMMATRIX4D));
+				memcpy(instance.normalMatrix, commands[j].normalMatrix, sizeof(Matrix3x3));
+			}
+			m_renderer->SubmitDrawInstanced(first.meshId, m_drawInstances.data(), end - i, first.appearance);
+		}
+		i = end;
+	}
+}
+
+// Meshes spanning at least this much of the screen width (in NDC units, 2 is the full width) are
+// rasterized first and used as occluders for everything else
+#define OCCLUDER_MIN_SIZE 0.2f
+
+bool Direct3DRMViewportImpl::IsOccluder(const DeferredDrawCommand& command) const
+{
+	const D3DRMBOX& box = command.viewBox;
+	float extent = std::max(box.max.x - box.min.x, box.max.y - box.min.y);
+	float nearZ = std::max(box.min.z, m_front);
+	return extent * m_projectionMatrix[0][0] >= OCCLUDER_MIN_SIZE * nearZ;
+}
+
+// Removes draws from index first onwards whose bounds are hidden behind the occluders
+void Direct3DRMViewportImpl::CullOccludedDraws(std::vector<DeferredDrawCommand>& commands, size_t first)
+{
+	commands.erase(
+		std::remove_if(
+			commands.begin() + first,
+			commands.end(),
+			[this](const DeferredDrawCommand& command) { return m_renderer->IsBoxOccluded(command.viewBox); }
+		),
+		commands.end()
+	);
+}
+
 HRESULT Direct3DRMViewportImpl::RenderScene()
 {
 	m_backgroundColor = static_cast<Direct3DRMFrameImpl*>(m_rootFrame)->m_backgroundColor;
@@ -301,12 +343,10 @@ HRESULT Direct3DRMViewportImpl::RenderScene()
 	D3DRMMATRIX4D cameraWorld;
 	ComputeFrameWorldMatrix(m_camera, cameraWorld);
 	D3DRMMatrixInvertOrthogonal(m_viewMatrix, cameraWorld);
-	D3DRMMatrixMultiply(m_viewProjectionwMatrix, m_viewMatrix, m_projectionMatrix);
-
-	D3DRMMATRIX4D identity = {{1.f, 0.f, 0.f, 0.f}, {0.f, 1.f, 0.f, 0.f}, {0.f, 0.f, 1.f, 0.f}, {0.f, 0.f, 0.f, 1.f}};
+	MultiplyMatrix(m_viewProjectionwMatrix, m_viewMatrix, m_projectionMatrix);
 
 	std::vector<SceneLight> lights;
-	CollectLightsFromFrame(m_rootFrame, identity, lights);
+	CollectLightsFromFrame(m_rootFrame, nullptr, lights);
 	m_renderer->PushLights(lights.data(), lights.size());
 	HRESULT status = m_renderer->BeginFrame();
 	if (status != DD_OK) {
@@ -316,7 +356,27 @@ HRESULT Direct3DRMViewportImpl::RenderScene()
 	BuildViewFrustumPlanes();
 	m_renderer->SetFrustumPlanes(m_frustumPlanes);
 
-	CollectMeshesFromFrame(m_rootFrame, identity);
+	CollectMeshesFromFrame(m_rootFrame, nullptr);
+
+	std::sort(m_opaqueDraws.begin(), m_opaqueDraws.end(), OpaqueDrawLess);
+
+	// Draw the large occluders first, then skip whatever their depth hides
+	size_t occluderCount = 0;
+	if (m_occlusionCulling) {
+		auto occluders = std::stable_partition(m_opaqueDraws.begin(), m_opaqueDraws.end(), [this](const auto& command) {
+			return IsOccluder(command);
+		});
+		occluderCount = occluders - m_opaqueDraws.begin();
+	}
+	if (occluderCount > 0) {
+		SubmitDrawCommands(m_opaqueDraws.data(), occluderCount);
+		if (m_renderer->BuildOcclusionPyramid()) {
+			CullOccludedDraws(m_opaqueDraws, occluderCount);
+			CullOccludedDraws(m_deferredDraws, 0);
+		}
+	}
+	SubmitDrawCommands(m_opaqueDraws.data() + occluderCount, m_opaqueDraws.size() - occluderCount);
+	m_opaqueDraws.clear();
 
 	std::sort(
 		m_deferredDraws.begin(),
@@ -324,9 +384,7 @@ HRESULT Direct3DRMViewportImpl::RenderScene()
 		[](const DeferredDrawCommand& a, const DeferredDrawCommand& b) { return a.depth > b.depth; }
 	);
 	m_renderer->EnableTransparency();
-	for (const DeferredDrawCommand& cmd : m_deferredDraws) {
-		m_renderer->SubmitDraw(cmd.meshId, cmd.modelViewMatrix, cmd.normalMatrix, cmd.appearance);
-	}
+	SubmitDrawCommands(m_deferredDraws.data(), m_deferredDraws.size());
 	m_deferredDraws.clear();
 
 	return m_renderer->FinalizeFrame();
@@ -349,7 +407,8 @@ HRESULT Direct3DRMViewportImpl::ForceUpdate(int x, int y, int w, int h)
 
 HRESULT Direct3DRMViewportImpl::Clear()
 {
-	if (!DDBackBuffer) {
+	SDL_Surface* output = m_renderer ? m_renderer->GetOutputSurface() : DDBackBuffer;
+	if (!output) {
 		return DDERR_GENERIC;
 	}
 
@@ -357,8 +416,8 @@ HRESULT Direct3DRMViewportImpl::Clear()
 	uint8_t g = (m_backgroundColor >> 8) & 0xFF;
 	uint8_t b = m_backgroundColor & 0xFF;
 
-	Uint32 color = SDL_MapRGB(DDBackBuffer->format, r, g, b);
-	SDL_FillRect(DDBackBuffer, nullptr, color);
+	Uint32 color = SDL_MapRGB(output->format, r, g, b);
+	SDL_FillRect(output, nullptr, color);
 
 	return DD_OK;
 }
@@ -538,54 +597,6 @@ HRESULT Direct3DRMViewportImpl::InverseTransform(D3DVECTOR* world, D3DRMVECTOR4D
 	return DD_OK;
 }
 
-struct Ray {
-	D3DVECTOR origin;
-	D3DVECTOR direction;
-};
-
-// Ray-box intersection: slab method
-bool RayIntersectsBox(const Ray& ray, const D3DRMBOX& box, float& outT)
-{
-	float tmin = -FLT_MAX;
-	float tmax = FLT_MAX;
-
-	for (int i = 0; i < 3; ++i) {
-		float origin = (&ray.origin.x)[i];
-		float dir = (&ray.direction.x)[i];
-		float minB = (&box.min.x)[i];
-		float maxB = (&box.max.x)[i];
-
-		if (fabs(dir) < 1e-6f) {
-			if (origin < minB || origin > maxB) {
-				return false;
-			}
-		}
-		else {
-			float invD = 1.0f / dir;
-			float t1 = (minB - origin) * invD;
-			float t2 = (maxB - origin) * invD;
-			if (t1 > t2) {
-				std::swap(t1, t2);
-			}
-			if (t1 > tmin) {
-				tmin = t1;
-			}
-			if (t2 < tmax) {
-				tmax = t2;
-			}
-			if (tmin > tmax) {
-				return false;
-			}
-			if (tmax < 0) {
-				return false;
-			}
-		}
-	}
-
-	outT = tmin >= 0 ? tmin : tmax; // closest positive hit
-	return true;
-}
-
 // Convert screen (x,y) in viewport to picking ray in world space
 Ray BuildPickingRay(
 	float x,
@@ -630,45 +641,6 @@ Ray BuildPickingRay(
 	return Ray{rayOriginWorld, rayDirWorld};
 }
 
-bool RayIntersectsTriangle(
-	const Ray& ray,
-	const D3DVECTOR& v0,
-	const D3DVECTOR& v1,
-	const D3DVECTOR& v2,
-	float& outDist
-)
-{
-	const float EPSILON = 1e-6f;
-	D3DVECTOR edge1 = {v1.x - v0.x, v1.y - v0.y, v1.z - v0.z};
-	D3DVECTOR edge2 = {v2.x - v0.x, v2.y - v0.y, v2.z - v0.z};
-
-	D3DVECTOR h = CrossProduct(ray.direction, edge2);
-	float a = DotProduct(edge1, h);
-	if (fabs(a) < EPSILON) {
-		return false;
-	}
-
-	float f = 1.0f / a;
-	D3DVECTOR s = {ray.origin.x - v0.x, ray.origin.y - v0.y, ray.origin.z - v0.z};
-	float u = f * DotProduct(s, h);
-	if (u < 0.0f || u > 1.0f) {
-		return false;
-	}
-
-	D3DVECTOR q = CrossProduct(s, edge1);
-	float v = f * DotProduct(ray.direction, q);
-	if (v < 0.0f || u + v > 1.0f) {
-		return false;
-	}
-
-	float t = f * DotProduct(edge2, q);
-	if (t > EPSILON) {
-		outDist = t;
-		return true;
-	}
-	return false;
-}
-
 bool RayIntersectsMeshTriangles(
 	const Ray& ray,
 	Direct3DRMMeshImpl& mesh,
@@ -705,43 +677,6 @@ bool RayIntersectsMeshTriangles(
 	return false;
 }
 
-inline D3DVECTOR TransformVector(const D3DRMMATRIX4D& mat, const D3DVECTOR& vec)
-{
-	return {
-		vec.x * mat[0][0] + vec.y * mat[1][0] + vec.z * mat[2][0] + mat[3][0],
-		vec.x * mat[0][1] + vec.y * mat[1][1] + vec.z * mat[2][1] + mat[3][1],
-		vec.x * mat[0][2] + vec.y * mat[1][2] + vec.z * mat[2][2] + mat[3][2]
-	};
-}
-
-D3DRMBOX ComputeTransformedAABB(const D3DRMBOX& box, const D3DRMMATRIX4D& mat)
-{
-	D3DVECTOR corners[8] = {
-		{box.min.x, box.min.y, box.min.z},
-		{box.min.x, box.min.y, box.max.z},
-		{box.min.x, box.max.y, box.min.z},
-		{box.min.x, box.max.y, box.max.z},
-		{box.max.x, box.min.y, box.min.z},
-		{box.max.x, box.min.y, box.max.z},
-		{box.max.x, box.max.y, box.min.z},
-		{box.max.x, box.max.y, box.max.z}
-	};
-
-	D3DVECTOR transformed = TransformVector(mat, corners[0]);
-	D3DRMBOX worldBox = {transformed, transformed};
-
-	for (int i = 1; i < 8; ++i) {
-		D3DVECTOR v = TransformVector(mat, corners[i]);
-		worldBox.min.x = std::min(worldBox.min.x, v.x);
-		worldBox.min.y = std::min(worldBox.min.y, v.y);
-		worldBox.min.z = std::min(worldBox.min.z, v.z);
-		worldBox.max.x = std::max(worldBox.max.x, v.x);
-		worldBox.max.y = std::max(worldBox.max.y, v.y);
-		worldBox.max.z = std::max(worldBox.max.z, v.z);
-	}
-	return worldBox;
-}
-
 HRESULT Direct3DRMViewportImpl::Pick(float x, float y, LPDIRECT3DRMPICKEDARRAY* pickedArray)
 {
 	if (!m_rootFrame) {
@@ -762,6 +697,28 @@ HRESULT Direct3DRMViewportImpl::Pick(float x, float y, LPDIRECT3DRMPICKEDARRAY*
 		(float) m_width / (float) m_height
 	);
 
+	if (!m_linearPick) {
+		m_pickBVH.Pick(m_rootFrame, pickRay, hits);
+	}
+	else {
+		PickLinear(pickRay, hits);
+	}
+
+	std::sort(hits.begin(), hits.end(), [](const PickRecord& a, const PickRecord& b) {
+		return a.desc.dist < b.desc.dist;
+	});
+
+	*pickedArray = new Direct3DRMPickedArrayImpl(hits.data(), hits.size());
+	for (PickRecord& hit : hits) {
+		hit.frameArray->Release();
+	}
+
+	return D3DRM_OK;
+}
+
+// Reference implementation of Pick that tests every mesh in the scene
+void Direct3DRMViewportImpl::PickLinear(const Ray& pickRay, std::vector<PickRecord>& hits)
+{
 	std::function<void(IDirect3DRMFrame*, std::vector<IDirect3DRMFrame*>&)> recurse;
 	recurse = [&](IDirect3DRMFrame* frame, std::vector<IDirect3DRMFrame*>& path) {
 		path.push_back(frame);
@@ -813,17 +770,6 @@ HRESULT Direct3DRMViewportImpl::Pick(float x, float y, LPDIRECT3DRMPICKEDARRAY*
 
 	std::vector<IDirect3DRMFrame*> framePath;
 	recurse(m_rootFrame, framePath);
-
-	std::sort(hits.begin(), hits.end(), [](const PickRecord& a, const PickRecord& b) {
-		return a.desc.dist < b.desc.dist;
-	});
-
-	*pickedArray = new Direct3DRMPickedArrayImpl(hits.data(), hits.size());
-	for (PickRecord& hit : hits) {
-		hit.frameArray->Release();
-	}
-
-	return D3DRM_OK;
 }
 
 void Direct3DRMViewportImpl::CloseDevice()
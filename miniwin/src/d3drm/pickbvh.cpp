@@ -0,0 +1,416 @@
+#include "pickbvh.h"
+
+#include "d3drm_impl.h"
+#include "d3drmframe_impl.h"
+#include "d3drmmesh_impl.h"
+#include "mathutils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <float.h>
+#include <string.h>
+
+// Ray-box intersection: slab method
+bool RayIntersectsBox(const Ray& ray, const D3DRMBOX& box, float& outT)
+{
+	float tmin = -FLT_MAX;
+	float tmax = FLT_MAX;
+
+	for (int i = 0; i < 3; ++i) {
+		float origin = (&ray.origin.x)[i];
+		float dir = (&ray.direction.x)[i];
+		float minB = (&box.min.x)[i];
+		float maxB = (&box.max.x)[i];
+
+		if (fabs(dir) < 1e-6f) {
+			if (origin < minB || origin > maxB) {
+				return false;
+			}
+		}
+		else {
+			float invD = 1.0f / dir;
+			float t1 = (minB - origin) * invD;
+			float t2 = (maxB - origin) * invD;
+			if (t1 > t2) {
+				std::swap(t1, t2);
+			}
+			if (t1 > tmin) {
+				tmin = t1;
+			}
+			if (t2 < tmax) {
+				tmax = t2;
+			}
+			if (tmin > tmax) {
+				return false;
+			}
+			if (tmax < 0) {
+				return false;
+			}
+		}
+	}
+
+	outT = tmin >= 0 ? tmin : tmax; // closest positive hit
+	return true;
+}
+
+bool RayIntersectsTriangle(
+	const Ray& ray,
+	const D3DVECTOR& v0,
+	const D3DVECTOR& v1,
+	const D3DVECTOR& v2,
+	float& outDist
+)
+{
+	const float EPSILON = 1e-6f;
+	D3DVECTOR edge1 = {v1.x - v0.x, v1.y - v0.y, v1.z - v0.z};
+	D3DVECTOR edge2 = {v2.x - v0.x, v2.y - v0.y, v2.z - v0.z};
+
+	D3DVECTOR h = CrossProduct(ray.direction, edge2);
+	float a = DotProduct(edge1, h);
+	if (fabs(a) < EPSILON) {
+		return false;
+	}
+
+	float f = 1.0f / a;
+	D3DVECTOR s = {ray.origin.x - v0.x, ray.origin.y - v0.y, ray.origin.z - v0.z};
+	float u = f * DotProduct(s, h);
+	if (u < 0.0f || u > 1.0f) {
+		return false;
+	}
+
+	D3DVECTOR q = CrossProduct(s, edge1);
+	float v = f * DotProduct(ray.direction, q);
+	if (v < 0.0f || u + v > 1.0f) {
+		return false;
+	}
+
+	float t = f * DotProduct(edge2, q);
+	if (t > EPSILON) {
+		outDist = t;
+		return true;
+	}
+	return false;
+}
+
+D3DRMBOX ComputeTransformedAABB(const D3DRMBOX& box, const D3DRMMATRIX4D& mat)
+{
+	D3DVECTOR corners[8] = {
+		{box.min.x, box.min.y, box.min.z},
+		{box.min.x, box.min.y, box.max.z},
+		{box.min.x, box.max.y, box.min.z},
+		{box.min.x, box.max.y, box.max.z},
+		{box.max.x, box.min.y, box.min.z},
+		{box.max.x, box.min.y, box.max.z},
+		{box.max.x, box.max.y, box.min.z},
+		{box.max.x, box.max.y, box.max.z}
+	};
+
+	D3DVECTOR transformed = TransformPoint(corners[0], mat);
+	D3DRMBOX worldBox = {transformed, transformed};
+
+	for (int i = 1; i < 8; ++i) {
+		D3DVECTOR v = TransformPoint(corners[i], mat);
+		worldBox.min.x = std::min(worldBox.min.x, v.x);
+		worldBox.min.y = std::min(worldBox.min.y, v.y);
+		worldBox.min.z = std::min(worldBox.min.z, v.z);
+		worldBox.max.x = std::max(worldBox.max.x, v.x);
+		worldBox.max.y = std::max(worldBox.max.y, v.y);
+		worldBox.max.z = std::max(worldBox.max.z, v.z);
+	}
+	return worldBox;
+}
+
+static void GrowBox(D3DRMBOX& box, const D3DRMBOX& other)
+{
+	box.min.x = std::min(box.min.x, other.min.x);
+	box.min.y = std::min(box.min.y, other.min.y);
+	box.min.z = std::min(box.min.z, other.min.z);
+	box.max.x = std::max(box.max.x, other.max.x);
+	box.max.y = std::max(box.max.y, other.max.y);
+	box.max.z = std::max(box.max.z, other.max.z);
+}
+
+static void BuildNode(
+	BVH& bvh,
+	const std::vector<D3DRMBOX>& boxes,
+	const std::vector<D3DVECTOR>& centers,
+	Uint32 nodeIndex,
+	Uint32 begin,
+	Uint32 end
+)
+{
+	D3DRMBOX box = boxes[bvh.order[begin]];
+	D3DRMBOX centerBox = {centers[bvh.order[begin]], centers[bvh.order[begin]]};
+	for (Uint32 i = begin + 1; i < end; ++i) {
+		GrowBox(box, boxes[bvh.order[i]]);
+		GrowBox(centerBox, {centers[bvh.order[i]], centers[bvh.order[i]]});
+	}
+
+	if (end - begin <= BVH_LEAF_SIZE) {
+		bvh.nodes[nodeIndex] = {box, begin, end - begin};
+		return;
+	}
+
+	// Median split along the axis with the widest spread of centers
+	D3DVECTOR extent = {
+		centerBox.max.x - centerBox.min.x,
+		centerBox.max.y - centerBox.min.y,
+		centerBox.max.z - centerBox.min.z
+	};
+	int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+	Uint32 mid = begin + (end - begin) / 2;
+	std::nth_element(
+		bvh.order.begin() + begin,
+		bvh.order.begin() + mid,
+		bvh.order.begin() + end,
+		[&](Uint32 a, Uint32 b) { return (&centers[a].x)[axis] < (&centers[b].x)[axis]; }
+	);
+
+	Uint32 child = (Uint32) bvh.nodes.size();
+	bvh.nodes.resize(child + 2);
+	bvh.nodes[nodeIndex] = {box, child, 0};
+	BuildNode(bvh, boxes, centers, child, begin, mid);
+	BuildNode(bvh, boxes, centers, child + 1, mid, end);
+}
+
+void BVH::Build(const std::vector<D3DRMBOX>& boxes)
+{
+	nodes.clear();
+	order.resize(boxes.size());
+	if (boxes.empty()) {
+		return;
+	}
+
+	std::vector<D3DVECTOR> centers(boxes.size());
+	for (Uint32 i = 0; i < boxes.size(); ++i) {
+		order[i] = i;
+		centers[i] = {
+			(boxes[i].min.x + boxes[i].max.x) * 0.5f,
+			(boxes[i].min.y + boxes[i].max.y) * 0.5f,
+			(boxes[i].min.z + boxes[i].max.z) * 0.5f
+		};
+	}
+
+	nodes.reserve(2 * (boxes.size() / BVH_LEAF_SIZE + 1));
+	nodes.resize(1);
+	BuildNode(*this, boxes, centers, 0, 0, (Uint32) boxes.size());
+}
+
+void BVH::Refit(const std::vector<D3DRMBOX>& boxes)
+{
+	// Children follow their parent, so a reverse walk sees them first
+	for (size_t i = nodes.size(); i-- > 0;) {
+		BVHNode& node = nodes[i];
+		if (node.count) {
+			node.box = boxes[order[node.first]];
+			for (Uint32 j = node.first + 1; j < node.first + node.count; ++j) {
+				GrowBox(node.box, boxes[order[j]]);
+			}
+		}
+		else {
+			node.box = nodes[node.first].box;
+			GrowBox(node.box, nodes[node.first + 1].box);
+		}
+	}
+}
+
+static D3DRMBOX ComputeInstanceBox(const D3DRMBOX& localBox, const D3DRMMATRIX4D& worldMatrix)
+{
+	if (localBox.min.x > localBox.max.x) {
+		// Meshes without vertices collapse to their origin so they cannot stretch the tree
+		D3DVECTOR origin = {worldMatrix[3][0], worldMatrix[3][1], worldMatrix[3][2]};
+		return {origin, origin};
+	}
+	return ComputeTransformedAABB(localBox, worldMatrix);
+}
+
+// Inverts the upper 3x3 of a world matrix in double precision. The frame's m_normalMatrix cannot be used:
+// it is zeroed below a determinant of 1e-6, which a uniform scale of 0.01 already reaches.
+static bool InvertLinearPart(double out[3][3], const D3DRMMATRIX4D& m)
+{
+	double a = m[0][0], b = m[0][1], c = m[0][2];
+	double d = m[1][0], e = m[1][1], f = m[1][2];
+	double g = m[2][0], h = m[2][1], i = m[2][2];
+
+	double det = a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+	if (det == 0.0 || !std::isfinite(det)) {
+		return false;
+	}
+
+	double invDet = 1.0 / det;
+	out[0][0] = (e * i - f * h) * invDet;
+	out[0][1] = (c * h - b * i) * invDet;
+	out[0][2] = (b * f - c * e) * invDet;
+	out[1][0] = (f * g - d * i) * invDet;
+	out[1][1] = (a * i - c * g) * invDet;
+	out[1][2] = (c * d - a * f) * invDet;
+	out[2][0] = (d * h - e * g) * invDet;
+	out[2][1] = (b * g - a * h) * invDet;
+	out[2][2] = (a * e - b * d) * invDet;
+	return true;
+}
+
+// Row vector times the inverted linear part, the inverse of TransformPoint without the translation
+static D3DVECTOR TransformByInverse(const D3DVECTOR& v, const double inv[3][3])
+{
+	return {
+		(float) (v.x * inv[0][0] + v.y * inv[1][0] + v.z * inv[2][0]),
+		(float) (v.x * inv[0][1] + v.y * inv[1][1] + v.z * inv[2][1]),
+		(float) (v.x * inv[0][2] + v.y * inv[1][2] + v.z * inv[2][2])
+	};
+}
+
+// Tests the mesh in its own space, where the per-group triangle BVHs live.
+// Ray parameters are unchanged by the affine transform, so distances stay in world units.
+static bool RayIntersectsMesh(
+	const Ray& ray,
+	Direct3DRMMeshImpl& mesh,
+	const Direct3DRMFrameImpl& frame,
+	float& outDistance
+)
+{
+	const D3DRMMATRIX4D& m = frame.m_worldMatrix;
+	double inv[3][3];
+	if (!InvertLinearPart(inv, m)) {
+		// A frame scaled to nothing has no mesh space to move the ray into
+		return RayIntersectsMeshTriangles(ray, mesh, m, outDistance);
+	}
+
+	D3DVECTOR d = {ray.origin.x - m[3][0], ray.origin.y - m[3][1], ray.origin.z - m[3][2]};
+	Ray localRay = {TransformByInverse(d, inv), TransformByInverse(ray.direction, inv)};
+
+	DWORD groupCount = mesh.GetGroupCount();
+	for (DWORD gi = 0; gi < groupCount; ++gi) {
+		const MeshGroup& meshGroup = mesh.GetGroup(gi);
+		bool hit = false;
+		mesh.GetGroupBVH(gi).Traverse(localRay, [&](Uint32 face) {
+			const D3DVECTOR& v0 = meshGroup.vertices[meshGroup.indices[face * 3 + 0]].position;
+			const D3DVECTOR& v1 = meshGroup.vertices[meshGroup.indices[face * 3 + 1]].position;
+			const D3DVECTOR& v2 = meshGroup.vertices[meshGroup.indices[face * 3 + 2]].position;
+			float dist;
+			if (RayIntersectsTriangle(localRay, v0, v1, v2, dist)) {
+				if (dist < outDistance) {
+					outDistance = dist;
+				}
+				hit = true;
+			}
+			return hit;
+		});
+		if (hit) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void ScenePickBVH::Collect(
+	Direct3DRMFrameImpl* frame,
+	Direct3DRMFrameImpl* parent,
+	std::vector<IDirect3DRMFrame*>& path
+)
+{
+	frame->UpdateWorldMatrix(parent);
+	m_frames.push_back(frame);
+	m_parents.push_back(parent);
+	path.push_back(frame);
+
+	IDirect3DRMVisualArray* visuals = nullptr;
+	frame->GetVisuals(&visuals);
+	DWORD count = visuals->GetSize();
+	for (DWORD i = 0; i < count; ++i) {
+		IDirect3DRMVisual* visual = nullptr;
+		visuals->GetElement(i, &visual);
+
+		IDirect3DRMFrame* subFrame = nullptr;
+		visual->QueryInterface(IID_IDirect3DRMFrame, (void**) &subFrame);
+		if (subFrame) {
+			Collect(static_cast<Direct3DRMFrameImpl*>(subFrame), frame, path);
+			subFrame->Release();
+			visual->Release();
+			continue;
+		}
+
+		Direct3DRMMeshImpl* mesh = nullptr;
+		visual->QueryInterface(IID_IDirect3DRMMesh, (void**) &mesh);
+		if (mesh) {
+			Instance instance = {
+				frame,
+				visual,
+				mesh,
+				(Uint32) m_paths.size(),
+				(Uint32) path.size(),
+				frame->m_worldVersion
+			};
+			mesh->GetBox(&instance.localBox);
+			m_paths.insert(m_paths.end(), path.begin(), path.end());
+			m_boxes.push_back(ComputeInstanceBox(instance.localBox, frame->m_worldMatrix));
+			m_instances.push_back(instance);
+			mesh->Release();
+		}
+		visual->Release();
+	}
+	visuals->Release();
+	path.pop_back();
+}
+
+void ScenePickBVH::Refresh()
+{
+	for (size_t i = 0; i < m_frames.size(); ++i) {
+		m_frames[i]->UpdateWorldMatrix(m_parents[i]);
+	}
+
+	bool refit = false;
+	for (size_t i = 0; i < m_instances.size(); ++i) {
+		Instance& instance = m_instances[i];
+		D3DRMBOX localBox;
+		instance.mesh->GetBox(&localBox);
+		if (instance.worldVersion != instance.frame->m_worldVersion ||
+			memcmp(&localBox, &instance.localBox, sizeof(D3DRMBOX)) != 0) {
+			instance.worldVersion = instance.frame->m_worldVersion;
+			instance.localBox = localBox;
+			m_boxes[i] = ComputeInstanceBox(localBox, instance.frame->m_worldMatrix);
+			refit = true;
+		}
+	}
+
+	if (refit) {
+		m_bvh.Refit(m_boxes);
+	}
+}
+
+void ScenePickBVH::Pick(IDirect3DRMFrame* root, const Ray& ray, std::vector<PickRecord>& hits)
+{
+	if (!m_valid || m_root != root || m_hierarchyVersion != Direct3DRMFrameImpl::s_hierarchyVersion) {
+		m_root = root;
+		m_hierarchyVersion = Direct3DRMFrameImpl::s_hierarchyVersion;
+		m_valid = true;
+
+		m_frames.clear();
+		m_parents.clear();
+		m_paths.clear();
+		m_instances.clear();
+		m_boxes.clear();
+		std::vector<IDirect3DRMFrame*> path;
+		Collect(static_cast<Direct3DRMFrameImpl*>(root), nullptr, path);
+		m_bvh.Build(m_boxes);
+	}
+	else {
+		Refresh();
+	}
+
+	m_bvh.Traverse(ray, [&](Uint32 index) {
+		Instance& instance = m_instances[index];
+		float distance = FLT_MAX;
+		if (RayIntersectsBox(ray, m_boxes[index], distance) &&
+			RayIntersectsMesh(ray, *instance.mesh, *instance.frame, distance)) {
+			auto* arr = new Direct3DRMFrameArrayImpl();
+			for (Uint32 i = 0; i < instance.pathCount; ++i) {
+				arr->AddElement(m_paths[instance.pathStart + i]);
+			}
+
+			PickRecord rec = {instance.visual, arr, {distance}};
+			hits.push_back(rec);
+		}
+		return false;
+	});
+}
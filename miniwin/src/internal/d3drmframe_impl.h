@@ -1,6 +1,9 @@
 #pragma once
 
 #include "d3drmobject_impl.h"
+#include "mathutils.h"
+
+#include <vector>
 
 class Direct3DRMTextureImpl;
 class Direct3DRMLightArrayImpl;
@@ -29,11 +32,30 @@ struct Direct3DRMFrameImpl : public Direct3DRMObjectBaseImpl<IDirect3DRMFrame2>
 	HRESULT SetMaterialMode(D3DRMMATERIALMODE mode) override;
 	HRESULT GetChildren(IDirect3DRMFrameArray** children) override;
 
+	// World matrix along the m_parent chain
+	const D3DRMMATRIX4D& GetWorldMatrix();
+	// Refreshes the cached world and normal matrices as a child of parent (nullptr for a scene root).
+	// The parent's own cache must already be up to date.
+	void UpdateWorldMatrix(Direct3DRMFrameImpl* parent);
+
 	Direct3DRMFrameImpl* m_parent{};
 	D3DRMMATRIX4D m_transform =
 		{{1.f, 0.f, 0.f, 0.f}, {0.f, 1.f, 0.f, 0.f}, {0.f, 0.f, 1.f, 0.f}, {0.f, 0.f, 0.f, 1.f}};
+	D3DRMMATRIX4D m_worldMatrix;
+	Matrix3x3 m_normalMatrix;
+	Uint32 m_worldVersion = 0; // Bumped whenever m_worldMatrix is recomputed
+
+	// Bumped whenever any frame gains or loses a child or visual, or is destroyed
+	static Uint32 s_hierarchyVersion;
 
 private:
+	void MarkWorldDirty();
+	void MarkChildrenWorldDirty();
+
+	// Frames attached as visuals inherit this frame's transform like children do
+	std::vector<Direct3DRMFrameImpl*> m_visualFrames;
+	Direct3DRMFrameImpl* m_worldParent{};
+	bool m_worldDirty = true;
 	Direct3DRMFrameArrayImpl* m_children{};
 	Direct3DRMLightArrayImpl* m_lights{};
 	Direct3DRMVisualArrayImpl* m_visuals{};
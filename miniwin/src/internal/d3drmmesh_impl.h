@@ -1,6 +1,7 @@
 #pragma once
 
 #include "d3drmobject_impl.h"
+#include "pickbvh.h"
 
 #include <algorithm>
 #include <vector>
@@ -83,6 +84,8 @@ struct Direct3DRMMeshImpl : public Direct3DRMObjectBaseImpl<IDirect3DRMMesh> {
 		unsigned int* indices
 	) override;
 	const MeshGroup& GetGroup(D3DRMGROUPINDEX groupIndex);
+	// Triangle BVH of a group for picking, built on first use
+	const BVH& GetGroupBVH(D3DRMGROUPINDEX groupIndex);
 	DWORD GetGroupCount() override;
 	HRESULT SetGroupColor(D3DRMGROUPINDEX groupIndex, D3DCOLOR color) override;
 	HRESULT SetGroupColorRGB(D3DRMGROUPINDEX groupIndex, float r, float g, float b) override;
@@ -103,5 +106,6 @@ struct Direct3DRMMeshImpl : public Direct3DRMObjectBaseImpl<IDirect3DRMMesh> {
 	void UpdateBox();
 
 	std::vector<MeshGroup> m_groups;
+	std::vector<MeshGroupBVH> m_groupBVHs;
 	D3DRMBOX m_box;
 };
@@ -26,7 +26,13 @@ struct Plane {
 	float d;
 };
 
+struct DrawInstance {
+	D3DRMMATRIX4D modelViewMatrix;
+	Matrix3x3 normalMatrix;
+};
+
 extern SDL_Renderer* DDRenderer;
+extern SDL_Surface* DDBackBuffer;
 
 class Direct3DRMRenderer : public IDirect3DDevice2 {
 public:
@@ -47,7 +53,26 @@ class Direct3DRMRenderer : public IDirect3DDevice2 {
 		const Matrix3x3& normalMatrix,
 		const Appearance& appearance
 	) = 0;
+	// Draws the same mesh with the same appearance once per instance, backends may override to share per-draw setup
+	virtual void SubmitDrawInstanced(
+		DWORD meshId,
+		const DrawInstance* instances,
+		size_t count,
+		const Appearance& appearance
+	)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			SubmitDraw(meshId, instances[i].modelViewMatrix, instances[i].normalMatrix, appearance);
+		}
+	}
+	// Rasterizes the draws submitted so far and builds a coarse depth pyramid from them for IsBoxOccluded.
+	// Returns false if the backend cannot test occlusion.
+	virtual bool BuildOcclusionPyramid() { return false; }
+	// Whether a view space box lies entirely behind the depth captured by BuildOcclusionPyramid
+	virtual bool IsBoxOccluded(const D3DRMBOX& viewBox) { return false; }
 	virtual HRESULT FinalizeFrame() = 0;
+	// Surface the frame ends up in, filled by Direct3DRMViewportImpl::Clear
+	virtual SDL_Surface* GetOutputSurface() { return DDBackBuffer; }
 
 	bool ConvertEventToRenderCoordinates(SDL_Event* event)
 	{
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "d3drmrenderer.h"
+
+#include <SDL2/SDL.h>
+#include <unordered_map>
+#include <vector>
+
+// Path of a file to record the renderer calls of the following frames into. Unset by default
+#define MINIWIN_HINT_CAPTURE "MINIWIN_CAPTURE"
+
+// Number of frames to record, defaults to "1"
+#define MINIWIN_HINT_CAPTURE_FRAMES "MINIWIN_CAPTURE_FRAMES"
+
+// Number of frames to render before recording starts, defaults to "0"
+#define MINIWIN_HINT_CAPTURE_SKIP "MINIWIN_CAPTURE_SKIP"
+
+// A capture file starts with a CaptureHeader followed by one record per renderer call: a Uint8
+// CaptureOp and its arguments. Textures and meshes are written out in full the first time a frame
+// uses them and again whenever they change, so a capture replays without any game data.
+// Everything is stored little endian whatever the host: Uint32 values and IEEE floats take four bytes,
+// colors are four bytes in r, g, b, a order. Structures are written field by field in declaration order
+// without padding, e.g. a D3DRMVERTEX is position, normal, u, v and an Appearance is color, shininess,
+// textureId, flat. Matrices are written row by row.
+#define CAPTURE_MAGIC 0x5043574d // "MWCP"
+#define CAPTURE_VERSION 2
+
+struct CaptureHeader {
+	Uint32 magic;
+	Uint32 version;
+	Uint32 width;
+	Uint32 height;
+};
+#define CAPTURE_HEADER_SIZE 16
+
+enum CaptureOp : Uint8 {
+	CAPTURE_TEXTURE,         // Uint32 texture, Uint32 width, Uint32 height, r, g, b, a bytes per pixel
+	CAPTURE_RELEASE_TEXTURE, // Uint32 texture
+	CAPTURE_MESH,            // Uint32 mesh, CaptureMeshDesc, vertices, Uint32 indices
+	CAPTURE_RELEASE_MESH,    // Uint32 mesh
+	CAPTURE_GET_TEXTURE_ID,  // Uint32 texture
+	CAPTURE_GET_MESH_ID,     // Uint32 mesh
+	CAPTURE_PUSH_LIGHTS,     // Uint32 count, SceneLight[count]
+	CAPTURE_SET_PROJECTION,  // D3DRMMATRIX4D, D3DVALUE front, D3DVALUE back
+	CAPTURE_SET_FRUSTUM_PLANES, // Plane[6]
+	CAPTURE_BEGIN_FRAME,
+	CAPTURE_ENABLE_TRANSPARENCY,
+	CAPTURE_SUBMIT_DRAW,           // Uint32 mesh, DrawInstance, Appearance
+	CAPTURE_SUBMIT_DRAW_INSTANCED, // Uint32 mesh, Uint32 count, DrawInstance[count], Appearance
+	CAPTURE_BUILD_OCCLUSION_PYRAMID,
+	CAPTURE_IS_BOX_OCCLUDED, // D3DRMBOX
+	CAPTURE_FINALIZE_FRAME,
+	CAPTURE_OP_COUNT
+};
+
+// Textures and meshes are referred to by capture IDs, which are never reused within a file.
+// Appearance::textureId holds a capture ID as well, or NO_TEXTURE_ID.
+struct CaptureMeshDesc {
+	SDL_Color color;
+	Uint32 quality;
+	Uint32 texture;
+	Uint32 vertexCount;
+	Uint32 indexCount;
+};
+
+// Forwards every call to another renderer and records the calls of a range of frames
+class Direct3DRMCaptureRenderer : public Direct3DRMRenderer {
+public:
+	// Takes ownership of renderer
+	Direct3DRMCaptureRenderer(Direct3DRMRenderer* renderer, const char* path);
+	~Direct3DRMCaptureRenderer() override;
+	void PushLights(const SceneLight* vertices, size_t count) override;
+	void SetProjection(const D3DRMMATRIX4D& projection, D3DVALUE front, D3DVALUE back) override;
+	void SetFrustumPlanes(const Plane* frustumPlanes) override;
+	Uint32 GetTextureId(IDirect3DRMTexture* texture) override;
+	Uint32 GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup) override;
+	DWORD GetWidth() override;
+	DWORD GetHeight() override;
+	void GetDesc(D3DDEVICEDESC* halDesc, D3DDEVICEDESC* helDesc) override;
+	const char* GetName() override;
+	HRESULT BeginFrame() override;
+	void EnableTransparency() override;
+	void SubmitDraw(
+		DWORD meshId,
+		const D3DRMMATRIX4D& modelViewMatrix,
+		const Matrix3x3& normalMatrix,
+		const Appearance& appearance
+	) override;
+	void SubmitDrawInstanced(
+		DWORD meshId,
+		const DrawInstance* instances,
+		size_t count,
+		const Appearance& appearance
+	) override;
+	bool BuildOcclusionPyramid() override;
+	bool IsBoxOccluded(const D3DRMBOX& viewBox) override;
+	HRESULT FinalizeFrame() override;
+	SDL_Surface* GetOutputSurface() override;
+
+private:
+	struct CapturedTexture {
+		Uint32 captureId;
+		Uint8 version;
+		bool written; // Defined in the file with this version
+	};
+
+	struct CapturedMesh {
+		Uint32 captureId;
+		const MeshGroup* meshGroup;
+		int version;
+		bool written;
+	};
+
+	struct DestroyContext;
+
+	void StartRecording(); // At the first call of a frame once the skipped frames are over
+	void StopRecording();
+	void Write(const void* data, size_t size);
+	void WriteUint32(Uint32 value);
+	void WriteFloats(const float* values, size_t count);
+	void WriteFloat(float value) { WriteFloats(&value, 1); }
+	void WriteColor(const SDL_Color& color);
+	void WriteVector(const D3DVECTOR& vector);
+	void WriteMatrix(const D3DRMMATRIX4D& matrix) { WriteFloats(&matrix[0][0], 16); }
+	void WriteInstance(const DrawInstance& instance);
+	void WriteOp(CaptureOp op)
+	{
+		Uint8 value = op;
+		Write(&value, 1);
+	}
+	Uint32 WriteTexture(IDirect3DRMTexture* texture);
+	Uint32 WriteMesh(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup);
+	Uint32 CaptureTextureId(Uint32 textureId);
+	Uint32 CaptureMeshId(DWORD meshId);
+	void WriteAppearance(const Appearance& appearance);
+	void OnTextureDestroyed(IDirect3DRMTexture* texture);
+	void OnMeshDestroyed(IDirect3DRMMesh* mesh);
+
+	Direct3DRMRenderer* m_renderer;
+	SDL_RWops* m_file;
+	std::vector<Uint8> m_buffer; // Records of the current frame, written to m_file when it ends
+	bool m_recording = false;
+	int m_skipFrames;
+	int m_frames;
+	Uint32 m_nextCaptureId = 0;
+	std::unordered_map<IDirect3DRMTexture*, CapturedTexture> m_textures;
+	std::unordered_map<IDirect3DRMMesh*, std::vector<CapturedMesh>> m_meshes;
+	std::unordered_map<Uint32, IDirect3DRMTexture*> m_textureIds; // Renderer texture ID to texture
+	std::unordered_map<DWORD, std::pair<IDirect3DRMMesh*, const MeshGroup*>> m_meshIds;
+
+	// State set outside of a frame, written out again when recording starts
+	D3DRMMATRIX4D m_projection;
+	D3DVALUE m_front;
+	D3DVALUE m_back;
+	bool m_hasProjection = false;
+};
+
+// Calls of one kind made while replaying, in performance counter ticks
+struct ReplayCallStats {
+	Uint32 calls;
+	Uint64 ticks;
+};
+
+// Plays a capture file back into any renderer, timing each call
+class RenderCaptureReplay {
+public:
+	RenderCaptureReplay(IDirect3DRM* d3drm);
+	~RenderCaptureReplay();
+	bool Open(const char* path);
+	DWORD GetWidth() const { return m_header.width; }
+	DWORD GetHeight() const { return m_header.height; }
+	// Replays up to and including the next FinalizeFrame, returns false at the end of the capture
+	bool ReplayFrame(Direct3DRMRenderer* renderer);
+	// Starts over from the first frame; textures and meshes are kept and defined again
+	void Rewind() { m_offset = CAPTURE_HEADER_SIZE; }
+	const ReplayCallStats& GetCallStats(CaptureOp op) const { return m_stats[op]; }
+	static const char* GetOpName(CaptureOp op);
+
+private:
+	struct ReplayTexture {
+		IDirect3DRMTexture2* texture;
+		IDirectDrawSurface* surface;
+		Uint32 id; // Renderer texture ID, NO_TEXTURE_ID until the capture asks for it
+	};
+
+	struct ReplayMesh {
+		IDirect3DRMMesh* mesh;
+		Uint32 id;
+	};
+
+	const void* Read(size_t size);
+	bool ReadUint8(Uint8& value);
+	bool ReadUint32(Uint32& value);
+	bool ReadFloats(float* values, size_t count);
+	bool ReadFloat(float& value) { return ReadFloats(&value, 1); }
+	bool ReadColor(SDL_Color& color);
+	bool ReadVector(D3DVECTOR& vector);
+	bool ReadMatrix(D3DRMMATRIX4D& matrix) { return ReadFloats(&matrix[0][0], 16); }
+	bool ReadInstance(DrawInstance& instance);
+	bool ReadAppearance(Appearance& appearance);
+	// Rejects counts that cannot fit in the rest of the file before anything is allocated for them
+	bool HasRecords(Uint32 count) const { return count <= m_data.size() - m_offset; }
+	bool ReadTexture();
+	bool ReadMesh();
+	void ReleaseTexture(Uint32 captureId);
+	void ReleaseMesh(Uint32 captureId);
+
+	IDirect3DRM* m_d3drm;
+	CaptureHeader m_header = {};
+	std::vector<Uint8> m_data;
+	size_t m_offset = 0;
+	std::unordered_map<Uint32, ReplayTexture> m_textures;
+	std::unordered_map<Uint32, ReplayMesh> m_meshes;
+	std::vector<DrawInstance> m_instances;
+	std::vector<SceneLight> m_lights;
+	ReplayCallStats m_stats[CAPTURE_OP_COUNT] = {};
+};
+
+// Creates a renderer by name ("software", "opengles2", "opengl1", "sdl3gpu" or "directx9") for
+// replaying captures. GPU backends open their own test window and copy frames into DDBackBuffer,
+// which is created if needed.
+Direct3DRMRenderer* CreateReplayRenderer(const char* name, DWORD width, DWORD height);
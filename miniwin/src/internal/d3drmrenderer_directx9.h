@@ -4,6 +4,7 @@
 #include "d3drmrenderer.h"
 #include "d3drmtexture_impl.h"
 #include "ddraw_impl.h"
+#include "handleregistry.h"
 
 #include <vector>
 
@@ -43,6 +44,8 @@ class DirectX9Renderer : public Direct3DRMRenderer {
 	std::vector<SceneLight> m_lights;
 	std::vector<D3D9MeshCacheEntry> m_meshs;
 	std::vector<D3D9TextureCacheEntry> m_textures;
+	HandleRegistry<MeshGroup> m_meshIds;
+	HandleRegistry<IDirect3DRMTexture> m_textureIds;
 };
 
 inline static void DirectX9Renderer_EnumDevice(LPD3DENUMDEVICESCALLBACK cb, void* ctx)
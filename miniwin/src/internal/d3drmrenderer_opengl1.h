@@ -3,6 +3,7 @@
 #include "d3drmrenderer.h"
 #include "d3drmtexture_impl.h"
 #include "ddraw_impl.h"
+#include "handleregistry.h"
 
 #ifdef __APPLE__
 #include <OpenGL/gl.h>
@@ -70,6 +71,8 @@ class OpenGL1Renderer : public Direct3DRMRenderer {
 
 	std::vector<GLTextureCacheEntry> m_textures;
 	std::vector<GLMeshCacheEntry> m_meshs;
+	HandleRegistry<IDirect3DRMTexture> m_textureIds;
+	HandleRegistry<MeshGroup> m_meshIds;
 	D3DRMMATRIX4D m_projection;
 	SDL_Surface* m_renderedImage;
 	DWORD m_width, m_height;
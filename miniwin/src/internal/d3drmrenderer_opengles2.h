@@ -3,6 +3,7 @@
 #include "d3drmrenderer.h"
 #include "d3drmtexture_impl.h"
 #include "ddraw_impl.h"
+#include "handleregistry.h"
 
 #include <GLES2/gl2.h>
 #include <SDL2/SDL.h>
@@ -67,6 +68,8 @@ class OpenGLES2Renderer : public Direct3DRMRenderer {
 
 	std::vector<GLES2TextureCacheEntry> m_textures;
 	std::vector<GLES2MeshCacheEntry> m_meshs;
+	HandleRegistry<IDirect3DRMTexture> m_textureIds;
+	HandleRegistry<MeshGroup> m_meshIds;
 	D3DRMMATRIX4D m_projection;
 	SDL_Surface* m_renderedImage;
 	DWORD m_width, m_height;
@@ -4,6 +4,7 @@
 #include "d3drmtexture_impl.h"
 #include "ddraw_impl.h"
 #include "ddsurface_impl.h"
+#include "handleregistry.h"
 
 #include <SDL2/SDL.h>
 #include <vector>
@@ -94,6 +95,8 @@ class Direct3DRMSDL3GPURenderer : public Direct3DRMRenderer {
 	D3DDEVICEDESC m_desc;
 	std::vector<SDL2TextureCache> m_textures;
 	std::vector<SDL2MeshCache> m_meshs;
+	HandleRegistry<Direct3DRMTextureImpl> m_textureIds;
+	HandleRegistry<MeshGroup> m_meshIds;
 	SDL_GPUDevice* m_device;
 	SDL_GPUGraphicsPipeline* m_opaquePipeline;
 	SDL_GPUGraphicsPipeline* m_transparentPipeline;
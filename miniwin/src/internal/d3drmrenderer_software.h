@@ -3,30 +3,192 @@
 #include "d3drmrenderer.h"
 #include "d3drmtexture_impl.h"
 #include "ddraw_impl.h"
+#include "handleregistry.h"
 
 #include <SDL2/SDL.h>
 #include <cstddef>
+#include <unordered_map>
 #include <vector>
 
 DEFINE_GUID(SOFTWARE_GUID, 0x682656F3, 0x0000, 0x0000, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02);
 
+// Selects how the software rasterizer fills spans: "scanline" (default, one pixel at a time), "edge" (best
+// SIMD block kernel for this CPU) or one of "edge-scalar", "edge-sse2", "edge-avx2", "edge-neon", "edge-wasm128".
+// All of them render identical pixels
+#define MINIWIN_HINT_SOFTWARE_RASTERIZER "MINIWIN_SOFTWARE_RASTERIZER"
+
+// Selects software texture sampling: "nearest" (no mip maps), "mipmap" (default, nearest texel
+// from the level chosen per triangle) or "bilinear" (mip mapped and bilinearly filtered)
+#define MINIWIN_HINT_SOFTWARE_TEXTURE_FILTER "MINIWIN_SOFTWARE_TEXTURE_FILTER"
+
+// Internal resolution relative to the back buffer, e.g. "0.5" renders at half size and upscales
+// the result. With a frame budget this is the highest scale used. Defaults to "1"
+#define MINIWIN_HINT_SOFTWARE_RENDER_SCALE "MINIWIN_SOFTWARE_RENDER_SCALE"
+
+// Target time in milliseconds for rendering a frame. When set, the internal resolution drops while
+// frames run over budget and recovers once they are comfortably below it
+#define MINIWIN_HINT_SOFTWARE_FRAME_BUDGET "MINIWIN_SOFTWARE_FRAME_BUDGET"
+
+// Lowest render scale the frame budget may drop to, defaults to "0.5"
+#define MINIWIN_HINT_SOFTWARE_MIN_RENDER_SCALE "MINIWIN_SOFTWARE_MIN_RENDER_SCALE"
+
 struct TextureCache {
 	Direct3DRMTextureImpl* texture;
 	Uint8 version;
-	SDL_Surface* cached;
+	std::vector<SDL_Surface*> levels; // levels[0] is full size, each next level is half the size
+};
+
+struct VertexXY {
+	float x, y, z, w;
+	SDL_Color color;
+	float u_over_w, v_over_w;
+	float one_over_w;
+};
+
+// Back buffer format resolved once per frame so span writers can pack and unpack pixels
+// without going through SDL_MapRGBA/SDL_GetRGBA
+struct PixelFormatInfo {
+	const SDL_PixelFormat* format;
+	Uint32 mask[4];
+	Uint8 shift[4];
+	Uint8 loss[4];
+	Uint8 expand[4][256];
+};
+
+struct TextureSampler {
+	Uint8* texels;
+	int pitch;
+	int widthScale;
+	int heightScale;
+};
+
+struct RasterTriangle;
+
+typedef void (*SpanWriter)(
+	const PixelFormatInfo& format,
+	const RasterTriangle& tri,
+	const VertexXY& left,
+	const VertexXY& right,
+	int startX,
+	int endX,
+	float* zRow,
+	Uint8* pixelRow
+);
+
+#define EDGE_BLOCK_WIDTH 8
+
+// Up to EDGE_BLOCK_WIDTH horizontally adjacent fragments of a span that passed the depth test.
+// u and v are perspective corrected but not yet wrapped.
+struct EdgeBlock {
+	int x;
+	Uint32 mask;
+	float z[EDGE_BLOCK_WIDTH];
+	float r[EDGE_BLOCK_WIDTH];
+	float g[EDGE_BLOCK_WIDTH];
+	float b[EDGE_BLOCK_WIDTH];
+	float u[EDGE_BLOCK_WIDTH];
+	float v[EDGE_BLOCK_WIDTH];
+};
+
+typedef void (*BlockWriter)(
+	const PixelFormatInfo& format,
+	const RasterTriangle& tri,
+	const EdgeBlock& block,
+	float* zRow,
+	Uint8* pixelRow
+);
+
+// A lit, projected and y-sorted triangle waiting in the tile bins for FinalizeFrame
+struct RasterTriangle {
+	VertexXY verts[3];
+	SDL_Color flatColor;
+	Uint8 alpha;
+	bool flat;
+	SpanWriter span;
+	BlockWriter block;
+	TextureSampler texture;
+};
+
+// One span of RasterizeTriangle, for the row kernels that write it block by block
+struct EdgeRow {
+	const PixelFormatInfo* format;
+	const RasterTriangle* tri;
+	const VertexXY* left;
+	const VertexXY* right;
+	float* zRow;
+	Uint8* pixelRow;
+	bool gouraud;
+	bool textured;
 };
 
+// Rasterizes pixels [x0, x1] of the span, handing the blocks that pass the depth test to the triangle's
+// BlockWriter. Produces exactly the pixels of the triangle's SpanWriter
+typedef void (*EdgeRowRasterizer)(const EdgeRow& row, int x0, int x1);
+
+EdgeRowRasterizer SelectEdgeRowRasterizer(const char* name);
+
 struct MeshCache {
 	const MeshGroup* meshGroup;
 	int version;
 	bool flat;
 	std::vector<D3DRMVERTEX> vertices;
 	std::vector<uint16_t> indices;
+
+	// Vertex colors from the last draw, reused while the lighting inputs below are unchanged
+	std::vector<SDL_Color> litColors;
+	bool litValid = false;
+	Uint32 litLightsVersion;
+	D3DRMMATRIX4D litModelView;
+	Matrix3x3 litNormalMatrix;
+	SDL_Color litColor;
+	float litShininess;
+};
+
+enum PreparedLightType {
+	LIGHT_AMBIENT,
+	LIGHT_DIRECTIONAL,
+	LIGHT_POSITIONAL
+};
+
+// SceneLight with everything that does not depend on the vertex resolved once per frame
+struct PreparedLight {
+	FColor color;
+	PreparedLightType type;
+	D3DVECTOR position;
+	D3DVECTOR lightVec; // normalized, towards the light; only for directional lights
+};
+
+#define SPECULAR_TABLE_SIZE 1024
+
+// Time spent per stage in performance counter ticks, accumulated while EnableStats is on
+struct SoftwareRenderStats {
+	Uint64 transform; // Vertices into view space
+	Uint64 light;     // Vertex lighting
+	Uint64 clip;      // Clipping, projection, triangle setup and binning
+	Uint64 raster;    // Rasterizing opaque triangles
+	Uint64 blend;     // Rasterizing transparent triangles
+	Uint64 present;   // Scaling between the render target and the output surface
+	Uint32 frames;
+	Uint32 draws;
+	Uint32 triangles; // Triangles that reached the tile bins
+};
+
+// Pixels per side of one texel in the finest level of the occlusion pyramid
+#define HIZ_TILE_SIZE 8
+
+// One level of the occlusion pyramid, holding the farthest depth found under each texel
+struct HiZLevel {
+	int width;
+	int height;
+	std::vector<float> maxDepth;
 };
 
 class Direct3DRMSoftwareRenderer : public Direct3DRMRenderer {
 public:
 	Direct3DRMSoftwareRenderer(DWORD width, DWORD height);
+	~Direct3DRMSoftwareRenderer() override;
+	// Renders into a surface of its own instead of DDBackBuffer, so no window or DirectDraw is needed
+	static Direct3DRMSoftwareRenderer* CreateOffscreen(DWORD width, DWORD height);
 	void PushLights(const SceneLight* vertices, size_t count) override;
 	Uint32 GetTextureId(IDirect3DRMTexture* texture) override;
 	Uint32 GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGroup) override;
@@ -44,38 +206,137 @@ class Direct3DRMSoftwareRenderer : public Direct3DRMRenderer {
 		const Matrix3x3& normalMatrix,
 		const Appearance& appearance
 	) override;
+	void SubmitDrawInstanced(
+		DWORD meshId,
+		const DrawInstance* instances,
+		size_t count,
+		const Appearance& appearance
+	) override;
+	bool BuildOcclusionPyramid() override;
+	bool IsBoxOccluded(const D3DRMBOX& viewBox) override;
 	HRESULT FinalizeFrame() override;
+	SDL_Surface* GetOutputSurface() override;
+	void EnableStats(bool enable) { m_statsEnabled = enable; }
+	const SoftwareRenderStats& GetStats() const { return m_stats; }
+	void ResetStats() { m_stats = {}; }
 
 private:
+	static constexpr int TileSize = 64;
+	static constexpr int MaxWorkers = 15;
+	static constexpr int ResolutionInterval = 16; // Frames measured between render scale changes
+
+	void Resize(DWORD width, DWORD height);
+	void UpdateRenderSize();
+	void UpdateDynamicResolution(float frameTime);
+	void CompositeRenderTarget();
+	Uint64 StatStart() const { return m_statsEnabled ? SDL_GetPerformanceCounter() : 0; }
+	void StatLap(Uint64& stage, Uint64& start);
 	void ClearZBuffer();
+	void AllocateHiZ();
+	void StartWorkers();
+	void StopWorkers();
+	static int SDLCALL TileWorkerProc(void* data);
+	void RasterizeTiles();
+	void FlushTiles();
+	void RasterizeTriangle(const RasterTriangle& tri, int tileX0, int tileY0, int tileX1, int tileY1);
 	void DrawTriangleProjected(
 		const D3DRMVERTEX& v0,
 		const D3DRMVERTEX& v1,
 		const D3DRMVERTEX& v2,
+		SDL_Color c0,
+		SDL_Color c1,
+		SDL_Color c2,
 		const Appearance& appearance
 	);
-	void DrawTriangleClipped(const D3DRMVERTEX (&v)[3], const Appearance& appearance);
+	void DrawTriangleClipped(const D3DRMVERTEX (&v)[3], const SDL_Color (&c)[3], const Appearance& appearance);
+	void LightMesh(MeshCache& mesh, const D3DRMMATRIX4D& modelViewMatrix, const Appearance& appearance);
+	bool PrepareDraw(const Appearance& appearance);
+	void DrawMesh(
+		MeshCache& mesh,
+		const D3DRMMATRIX4D& modelViewMatrix,
+		const Matrix3x3& normalMatrix,
+		const Appearance& appearance
+	);
+	const float* GetSpecularTable(float shininess);
 	void ProjectVertex(const D3DVECTOR& v, D3DRMVECTOR4D& p) const;
-	Uint32 BlendPixel(Uint8* pixelAddr, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+	void UpdateFormatInfo(const SDL_PixelFormat* format);
 	SDL_Color ApplyLighting(const D3DVECTOR& position, const D3DVECTOR& normal, const Appearance& appearance);
+	std::vector<SDL_Surface*> UploadTexture(SDL_Surface* source);
+	TextureSampler SelectTextureLevel(
+		const D3DRMVECTOR4D& p0,
+		const D3DRMVECTOR4D& p1,
+		const D3DRMVECTOR4D& p2,
+		const TexCoord& t0,
+		const TexCoord& t1,
+		const TexCoord& t2
+	) const;
 	void AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture* texture);
 	void AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh);
 
-	DWORD m_width;
-	DWORD m_height;
-	SDL_Palette* m_palette;
-	const SDL_PixelFormat* m_format;
+	// Render resolution, m_renderScale times the size of the back buffer the frame is presented in
+	DWORD m_width = 0;
+	DWORD m_height = 0;
+	DWORD m_outputWidth;
+	DWORD m_outputHeight;
+	float m_renderScale;
+	float m_minRenderScale;
+	float m_maxRenderScale;
+	float m_frameBudget; // Seconds, 0 without dynamic resolution
+	float m_frameTime = 0.0f;
+	int m_framesSinceResize = 0;
+	Uint64 m_frameStart;
+	SDL_Surface* m_renderTarget = nullptr; // Scene pixels are upscaled into DDBackBuffer when rendering below its size
+	std::vector<DWORD> m_compositeColumns; // Render target column of each output column
+	SDL_Surface* m_frameTarget = nullptr;
+	SDL_Surface* m_offscreen = nullptr; // Output surface of an offscreen renderer
+	bool m_statsEnabled = false;
+	bool m_transparentPass = false;
+	SoftwareRenderStats m_stats = {};
+	const SDL_PixelFormat* m_format = nullptr;
+	Uint32 m_formatEnum = SDL_PIXELFORMAT_UNKNOWN;
+	PixelFormatInfo m_formatInfo;
 	int m_bytesPerPixel;
+	SpanWriter m_drawSpan;
+	BlockWriter m_drawBlock;
+	EdgeRowRasterizer m_edgeRow;
+	const TextureCache* m_drawTexture;
+	bool m_mipmaps;
+	bool m_bilinear;
 	std::vector<SceneLight> m_lights;
+	std::vector<PreparedLight> m_preparedLights;
+	Uint32 m_lightsVersion = 0;
+	bool m_viewDependentLights = false;
+	std::unordered_map<float, std::vector<float>> m_specularTables;
+	const float* m_drawSpecular = nullptr;
 	std::vector<TextureCache> m_textures;
 	std::vector<MeshCache> m_meshs;
+	HandleRegistry<Direct3DRMTextureImpl> m_textureIds;
+	HandleRegistry<MeshGroup> m_meshIds;
 	D3DVALUE m_front;
 	D3DVALUE m_back;
 	Matrix3x3 m_normalMatrix;
 	D3DRMMATRIX4D m_projection;
 	std::vector<float> m_zBuffer;
+	std::vector<HiZLevel> m_hiZ; // m_hiZ[0] is the finest level, the last one is a single texel
+	bool m_hiZValid = false;
 	std::vector<D3DRMVERTEX> m_transformedVerts;
 	Plane m_frustumPlanes[6];
+	Uint8* m_pixels;
+	int m_pitch;
+
+	// Triangles are binned into TileSize x TileSize screen tiles during SubmitDraw and rasterized
+	// tile by tile in FinalizeFrame. Each tile keeps its triangles in submission order, so the
+	// output is identical no matter which thread rasterizes which tile.
+	int m_tilesX;
+	int m_tilesY;
+	std::vector<RasterTriangle> m_triangles;
+	std::vector<std::vector<Uint32>> m_tileBins;
+	std::vector<SDL_Thread*> m_workers;
+	SDL_sem* m_workStart = nullptr;
+	SDL_sem* m_workDone = nullptr;
+	SDL_atomic_t m_nextTile;
+	bool m_workersStarted = false;
+	bool m_quit = false;
 };
 
 inline static void Direct3DRMSoftware_EnumDevice(LPD3DENUMDEVICESCALLBACK cb, void* ctx)
@@ -3,16 +3,25 @@
 #include "d3drmobject_impl.h"
 #include "d3drmrenderer.h"
 #include "miniwin/d3drm.h"
+#include "pickbvh.h"
 
 #include <SDL2/SDL.h>
 #include <vector>
 
+// Selects how Pick finds meshes under the cursor: "bvh" (default) or "linear" (tests every mesh)
+#define MINIWIN_HINT_PICKING "MINIWIN_PICKING"
+
+// Enables occlusion culling against a depth pyramid of the largest meshes on screen, on backends
+// that support it: "on" (default) or "off"
+#define MINIWIN_HINT_OCCLUSION_CULLING "MINIWIN_OCCLUSION_CULLING"
+
 struct DeferredDrawCommand {
 	DWORD meshId;
 	D3DRMMATRIX4D modelViewMatrix;
 	Matrix3x3 normalMatrix;
 	Appearance appearance;
 	float depth;
+	D3DRMBOX viewBox; // Mesh bounds in view space
 };
 
 class Direct3DRMDeviceImpl;
@@ -45,12 +54,22 @@ struct Direct3DRMViewportImpl : public Direct3DRMObjectBaseImpl<IDirect3DRMViewp
 
 private:
 	HRESULT RenderScene();
-	void CollectLightsFromFrame(IDirect3DRMFrame* frame, D3DRMMATRIX4D parentMatrix, std::vector<SceneLight>& lights);
-	void CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3DRMMATRIX4D parentMatrix);
+	void CollectLightsFromFrame(
+		IDirect3DRMFrame* frame,
+		Direct3DRMFrameImpl* parent,
+		std::vector<SceneLight>& lights
+	);
+	void CollectMeshesFromFrame(IDirect3DRMFrame* frame, Direct3DRMFrameImpl* parent);
 	void BuildViewFrustumPlanes();
+	void SubmitDrawCommands(const DeferredDrawCommand* commands, size_t count);
+	bool IsOccluder(const DeferredDrawCommand& command) const;
+	void CullOccludedDraws(std::vector<DeferredDrawCommand>& commands, size_t first);
+	void PickLinear(const Ray& pickRay, std::vector<PickRecord>& hits);
 	void UpdateProjectionMatrix();
 	Direct3DRMRenderer* m_renderer;
+	std::vector<DeferredDrawCommand> m_opaqueDraws;
 	std::vector<DeferredDrawCommand> m_deferredDraws;
+	std::vector<DrawInstance> m_drawInstances;
 	D3DCOLOR m_backgroundColor = 0xFF000000;
 	DWORD m_width;
 	DWORD m_height;
@@ -64,6 +83,9 @@ struct Direct3DRMViewportImpl : public Direct3DRMObjectBaseImpl<IDirect3DRMViewp
 	D3DVALUE m_back = 10.f;
 	D3DVALUE m_field = 0.5f;
 	Plane m_frustumPlanes[6];
+	ScenePickBVH m_pickBVH;
+	bool m_linearPick;
+	bool m_occlusionCulling;
 };
 
 struct Direct3DRMViewportArrayImpl
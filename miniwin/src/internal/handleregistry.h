@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL2/SDL_stdinc.h>
+#include <unordered_map>
+#include <vector>
+
+// Maps renderer resources (textures, mesh groups) to stable slot IDs in a backend's cache vector.
+// Lookups are a single hash probe; IDs released from destroy callbacks are handed out again first.
+template <typename Key>
+class HandleRegistry {
+public:
+	bool Find(const Key* key, Uint32& id) const
+	{
+		auto it = m_ids.find(key);
+		if (it == m_ids.end()) {
+			return false;
+		}
+		id = it->second;
+		return true;
+	}
+
+	Uint32 Acquire(const Key* key)
+	{
+		Uint32 id;
+		if (!m_freeIds.empty()) {
+			id = m_freeIds.back();
+			m_freeIds.pop_back();
+			m_keys[id] = key;
+		}
+		else {
+			id = static_cast<Uint32>(m_keys.size());
+			m_keys.push_back(key);
+		}
+		m_ids[key] = id;
+		return id;
+	}
+
+	void Release(Uint32 id)
+	{
+		if (id >= m_keys.size() || !m_keys[id]) {
+			return;
+		}
+		m_ids.erase(m_keys[id]);
+		m_keys[id] = nullptr;
+		m_freeIds.push_back(id);
+	}
+
+private:
+	std::unordered_map<const Key*, Uint32> m_ids;
+	std::vector<const Key*> m_keys;
+	std::vector<Uint32> m_freeIds;
+};
+
+// Returns the cache slot for an ID from HandleRegistry::Acquire, growing the cache if it is new
+template <typename T>
+T& HandleSlot(std::vector<T>& slots, Uint32 id)
+{
+	if (id >= slots.size()) {
+		slots.resize(id + 1);
+	}
+	return slots[id];
+}
@@ -3,6 +3,7 @@
 #include "miniwin/d3drm.h"
 
 #include <math.h>
+#include <string.h>
 
 typedef D3DVALUE Matrix3x3[3][3];
 
@@ -47,11 +48,38 @@ inline D3DVECTOR TransformPoint(const D3DVECTOR& p, const D3DRMMATRIX4D& m)
 inline void MultiplyMatrix(D3DRMMATRIX4D& out, const D3DRMMATRIX4D& a, const D3DRMMATRIX4D& b)
 {
 	for (int row = 0; row < 4; ++row) {
-		for (int col = 0; col < 4; ++col) {
-			out[row][col] = 0.0;
-			for (int k = 0; k < 4; ++k) {
-				out[row][col] += a[row][k] * b[k][col];
-			}
-		}
+		const float a0 = a[row][0], a1 = a[row][1], a2 = a[row][2], a3 = a[row][3];
+		out[row][0] = a0 * b[0][0] + a1 * b[1][0] + a2 * b[2][0] + a3 * b[3][0];
+		out[row][1] = a0 * b[0][1] + a1 * b[1][1] + a2 * b[2][1] + a3 * b[3][1];
+		out[row][2] = a0 * b[0][2] + a1 * b[1][2] + a2 * b[2][2] + a3 * b[3][2];
+		out[row][3] = a0 * b[0][3] + a1 * b[1][3] + a2 * b[2][3] + a3 * b[3][3];
 	}
 }
+
+inline void D3DRMMatrixInvertForNormal(Matrix3x3& out, const D3DRMMATRIX4D& m)
+{
+	float a = m[0][0], b = m[0][1], c = m[0][2];
+	float d = m[1][0], e = m[1][1], f = m[1][2];
+	float g = m[2][0], h = m[2][1], i = m[2][2];
+
+	float det = a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+
+	if (fabs(det) < 1e-6f) {
+		memset(out, 0, sizeof(Matrix3x3));
+		return;
+	}
+
+	float invDet = 1.0f / det;
+
+	out[0][0] = (e * i - f * h) * invDet;
+	out[1][0] = (c * h - b * i) * invDet;
+	out[2][0] = (b * f - c * e) * invDet;
+
+	out[0][1] = (f * g - d * i) * invDet;
+	out[1][1] = (a * i - c * g) * invDet;
+	out[2][1] = (c * d - a * f) * invDet;
+
+	out[0][2] = (d * h - e * g) * invDet;
+	out[1][2] = (b * g - a * h) * invDet;
+	out[2][2] = (a * e - b * d) * invDet;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "miniwin/d3drm.h"
+
+#include <SDL2/SDL_stdinc.h>
+#include <vector>
+
+class Direct3DRMFrameImpl;
+struct Direct3DRMMeshImpl;
+struct PickRecord;
+
+#define BVH_LEAF_SIZE 4
+
+struct Ray {
+	D3DVECTOR origin;
+	D3DVECTOR direction;
+};
+
+bool RayIntersectsBox(const Ray& ray, const D3DRMBOX& box, float& outT);
+bool RayIntersectsTriangle(
+	const Ray& ray,
+	const D3DVECTOR& v0,
+	const D3DVECTOR& v1,
+	const D3DVECTOR& v2,
+	float& outDist
+);
+D3DRMBOX ComputeTransformedAABB(const D3DRMBOX& box, const D3DRMMATRIX4D& mat);
+// World space test of every triangle, the MINIWIN_PICKING=linear path
+bool RayIntersectsMeshTriangles(
+	const Ray& ray,
+	Direct3DRMMeshImpl& mesh,
+	const D3DRMMATRIX4D& worldMatrix,
+	float& outDistance
+);
+
+struct BVHNode {
+	D3DRMBOX box;
+	Uint32 first; // Left child (the right one follows it) or, for leaves, the first entry in the primitive order
+	Uint32 count; // Primitive count of a leaf, 0 for inner nodes
+};
+
+// Binary BVH over primitive bounding boxes; children are always stored after their parent
+struct BVH {
+	std::vector<BVHNode> nodes;
+	std::vector<Uint32> order;
+
+	void Build(const std::vector<D3DRMBOX>& boxes);
+	void Refit(const std::vector<D3DRMBOX>& boxes);
+
+	// Calls visit(primitive) for every primitive whose leaf the ray reaches, until visit returns true
+	template <typename Visit>
+	void Traverse(const Ray& ray, Visit&& visit) const
+	{
+		if (nodes.empty()) {
+			return;
+		}
+
+		Uint32 stack[64];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0) {
+			const BVHNode& node = nodes[stack[--top]];
+			float t;
+			if (!RayIntersectsBox(ray, node.box, t)) {
+				continue;
+			}
+			if (node.count) {
+				for (Uint32 i = node.first; i < node.first + node.count; ++i) {
+					if (visit(order[i])) {
+						return;
+					}
+				}
+			}
+			else {
+				stack[top++] = node.first + 1;
+				stack[top++] = node.first;
+			}
+		}
+	}
+};
+
+// Triangle BVH of one mesh group in mesh space, rebuilt when the group's version changes
+struct MeshGroupBVH {
+	int version = -1;
+	BVH bvh;
+};
+
+// Frame-level BVH over every mesh reachable from a root frame, for Direct3DRMViewportImpl::Pick.
+// The hierarchy is re-collected when frames or visuals are added or removed,
+// moved frames only refit the boxes.
+class ScenePickBVH {
+public:
+	void Pick(IDirect3DRMFrame* root, const Ray& ray, std::vector<PickRecord>& hits);
+
+private:
+	struct Instance {
+		Direct3DRMFrameImpl* frame;
+		IDirect3DRMVisual* visual;
+		Direct3DRMMeshImpl* mesh;
+		Uint32 pathStart;
+		Uint32 pathCount;
+		Uint32 worldVersion;
+		D3DRMBOX localBox;
+	};
+
+	void Collect(Direct3DRMFrameImpl* frame, Direct3DRMFrameImpl* parent, std::vector<IDirect3DRMFrame*>& path);
+	void Refresh();
+
+	IDirect3DRMFrame* m_root = nullptr;
+	Uint32 m_hierarchyVersion = 0;
+	bool m_valid = false;
+	std::vector<Direct3DRMFrameImpl*> m_frames;
+	std::vector<Direct3DRMFrameImpl*> m_parents;
+	std::vector<IDirect3DRMFrame*> m_paths;
+	std::vector<Instance> m_instances;
+	std::vector<D3DRMBOX> m_boxes;
+	BVH m_bvh;
+};
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+
+"""Writes a .six index next to SI files.
+
+For every object in the offset table (MxOf) the index records where the object is stored,
+how many bytes it spans including its data chunks, how many chunks that is, which other
+objects stream chunks inside that span, and the object stored right after it in the file.
+MxDSFile loads <name>.six when it opens <name>.si and uses it to page in the data of
+actions as they start. An index whose recorded SI size does not match is ignored.
+
+Usage: siindex.py [-o OUTDIR] FILE.SI [FILE.SI ...]
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"SIX1"
+NO_OBJECT = 0xFFFFFFFF
+
+# Chunks whose payload is made of further chunks, and where those start
+CONTAINERS = {b"RIFF": 12, b"LIST": 12, b"MxSt": 8, b"MxDa": 8}
+
+
+def chunk_at(data, offset):
+    """Returns (id, total size including header and padding) of the chunk at offset."""
+    if offset + 8 > len(data):
+        return None, 0
+    chunk_id = data[offset : offset + 4]
+    (size,) = struct.unpack_from("<I", data, offset + 4)
+    return chunk_id, 8 + size + (size & 1)
+
+
+def find_chunk(data, start, end, wanted):
+    offset = start
+    while offset < end:
+        chunk_id, total = chunk_at(data, offset)
+        if chunk_id is None:
+            break
+        if chunk_id == wanted:
+            return offset
+        offset += total
+    return None
+
+
+def walk_data_chunks(data, start, end):
+    """Yields the object id of every MxCh chunk in [start, end), descending into containers."""
+    offset = start
+    while offset < end:
+        chunk_id, total = chunk_at(data, offset)
+        if chunk_id is None or total <= 8:
+            return
+        if chunk_id == b"MxCh":
+            (object_id,) = struct.unpack_from("<I", data, offset + 8 + 2)
+            yield object_id
+        elif chunk_id in CONTAINERS:
+            yield from walk_data_chunks(data, offset + CONTAINERS[chunk_id], min(offset + total, end))
+        offset += total
+
+
+def build_index(data):
+    if data[0:4] != b"RIFF" or data[8:12] != b"OMNI":
+        raise ValueError("not an SI file")
+
+    offsets_chunk = find_chunk(data, 12, len(data), b"MxOf")
+    if offsets_chunk is None:
+        raise ValueError("no offset table")
+
+    (count,) = struct.unpack_from("<I", data, offsets_chunk + 8)
+    offsets = struct.unpack_from(f"<{count}I", data, offsets_chunk + 12)
+
+    objects = []
+    for object_id, offset in enumerate(offsets):
+        if offset == 0 or offset >= len(data):
+            objects.append(None)
+            continue
+
+        _, size = chunk_at(data, offset)
+        size = min(size, len(data) - offset)
+        chunk_ids = list(walk_data_chunks(data, offset, offset + size))
+        dependents = sorted({chunk_id for chunk_id in chunk_ids if chunk_id != object_id})
+        objects.append({"offset": offset, "size": size, "chunks": len(chunk_ids), "dependents": dependents})
+
+    # The object stored right after each one, the most likely to be started next
+    by_offset = sorted((entry["offset"], object_id) for object_id, entry in enumerate(objects) if entry)
+    following = {}
+    for (_, object_id), (_, next_id) in zip(by_offset, by_offset[1:]):
+        following[object_id] = next_id
+
+    records = []
+    dependents = []
+    for object_id, entry in enumerate(objects):
+        if entry is None:
+            records.append(struct.pack("<6I", 0, 0, 0, NO_OBJECT, 0, 0))
+            continue
+        records.append(
+            struct.pack(
+                "<6I",
+                entry["offset"],
+                entry["size"],
+                entry["chunks"],
+                following.get(object_id, NO_OBJECT),
+                len(dependents),
+                len(entry["dependents"]),
+            )
+        )
+        dependents.extend(entry["dependents"])
+
+    header = MAGIC + struct.pack("<3I", len(data), len(records), len(dependents))
+    return header + b"".join(records) + struct.pack(f"<{len(dependents)}I", *dependents)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Write .six indices for SI files")
+    parser.add_argument("files", nargs="+", help="SI files to index")
+    parser.add_argument("-o", "--outdir", help="directory for the indices (default: next to each file)")
+    args = parser.parse_args()
+
+    status = 0
+    for path in args.files:
+        with open(path, "rb") as file:
+            data = file.read()
+
+        try:
+            index = build_index(data)
+        except (ValueError, struct.error) as error:
+            print(f"{path}: {error}", file=sys.stderr)
+            status = 1
+            continue
+
+        base = os.path.splitext(os.path.basename(path))[0] + ".six"
+        out = os.path.join(args.outdir or os.path.dirname(path), base)
+        with open(out, "wb") as file:
+            file.write(index)
+        (count,) = struct.unpack_from("<I", index, 8)
+        print(f"{path}: {count} objects -> {out}")
+
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())